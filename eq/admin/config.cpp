@@ -30,6 +30,8 @@
 #include "view.h"
 #include "window.h"
 
+#include <eq/fabric/commands.h>
+
 namespace eq
 {
 namespace admin
@@ -62,6 +64,11 @@ uint128_t Config::commit(const uint32_t /*incarnation*/)
 {
     return Super::commit(CO_COMMIT_NEXT);
 }
+
+void Config::calibrate()
+{
+    send(getServer(), fabric::CMD_CONFIG_CALIBRATE);
+}
 }
 }
 
@@ -51,6 +51,16 @@ public:
     EQADMIN_API virtual uint128_t commit(
         const uint32_t incarnation = CO_COMMIT_NEXT);
 
+    /**
+     * Recalibrate the resource weights of all running channels.
+     *
+     * The server measures the rendering, readback and transmission speed of
+     * each channel asynchronously, and updates the load balancing once all
+     * channels have replied.
+     * @version 2.2
+     */
+    EQADMIN_API void calibrate();
+
     /** @internal */
     const Channel* findChannel(const std::string& name) const
     {
@@ -29,6 +29,7 @@
 #include "client.h"
 #include "compositor.h"
 #include "config.h"
+#include "detail/eventCoalescer.h"
 #include "detail/fileFrameWriter.h"
 #include "error.h"
 #include "frame.h"
@@ -40,6 +41,7 @@
 #include "log.h"
 #include "node.h"
 #include "nodeFactory.h"
+#include "observer.h"
 #include "pipe.h"
 #include "pixelData.h"
 #include "server.h"
@@ -54,6 +56,7 @@
 #include <eq/fabric/sizeEvent.h>
 #include <eq/fabric/task.h>
 #include <eq/fabric/tile.h>
+#include <eq/fabric/wall.h>
 #include <eq/util/accum.h>
 #include <eq/util/objectManager.h>
 
@@ -62,6 +65,7 @@
 #include <co/objectICommand.h>
 #include <co/queueSlave.h>
 #include <co/sendToken.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/rng.h>
 #include <lunchbox/scopedMutex.h>
 #include <pression/plugins/compressor.h>
@@ -71,7 +75,9 @@
 #include <GLStats/GLStats.h>
 #endif
 
+#include <algorithm>
 #include <bitset>
+#include <memory>
 #include <set>
 
 #include "detail/channel.ipp"
@@ -147,6 +153,10 @@ void Channel::attach(const uint128_t& id, const uint32_t instanceID)
     registerCommand(fabric::CMD_CHANNEL_DELETE_TRANSFER_WINDOW,
                     CmdFunc(this, &Channel::_cmdDeleteTransferWindow),
                     transferQ);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE,
+                    CmdFunc(this, &Channel::_cmdCalibrate), queue);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE_PROBE,
+                    CmdFunc(this, &Channel::_cmdCalibrateProbe), commandQ);
 }
 
 co::CommandQueue* Channel::getPipeThreadQueue()
@@ -286,17 +296,11 @@ void Channel::notifyStopFrame(const uint32_t)
 
 void Channel::addStatistic(Statistic& event)
 {
-    {
-        const uint32_t frameNumber = event.frameNumber;
-        const size_t index = frameNumber % _impl->statistics->size();
-        LBASSERT(index < _impl->statistics->size());
-        LBASSERTINFO(_impl->statistics.data[index].used > 0, frameNumber);
-
-        lunchbox::ScopedFastWrite mutex(_impl->statistics);
-        Statistics& statistics = _impl->statistics.data[index].data;
-        statistics.push_back(event);
-    }
-    processEvent(event);
+    // sent to the server and the application when the frame is unused
+    detail::Channel::FrameStatistics& stats =
+        _impl->getStatistics(event.frameNumber);
+    LBASSERTINFO(stats.used > 0, event.frameNumber);
+    stats.events.add(event);
 }
 
 //---------------------------------------------------------------------------
@@ -448,6 +452,65 @@ void Channel::_overrideContext(RenderContext& context)
     window->_addRenderContext(context);
 }
 
+void Channel::_latchHeadMatrix(RenderContext& context)
+{
+    const View* view = getPipe()->getView(context.view);
+    const Observer* observer = view ? view->getObserver() : 0;
+    Matrix4f head;
+    if (!observer ||
+        !getNode()->getLatchedHeadMatrix(observer->getID(), getCurrentFrame(),
+                                         head))
+    {
+        return;
+    }
+
+    const Matrix4f& oldHead = observer->getHeadMatrix();
+    if (head == oldHead)
+        return;
+
+    if (context.frustumType != Wall::TYPE_FIXED)
+    {
+        // HMD: the frustum moves with the head, update the view transform only
+        const Matrix4f delta = oldHead * head.inverse();
+        context.headTransform = context.headTransform * delta;
+        context.orthoTransform = context.orthoTransform * delta;
+        return;
+    }
+
+    // Fixed wall: move the eye in frustum space and recompute the frustum
+    const Vector3f& eye = observer->getEyePosition(context.eye);
+    const float modelUnit = view->getModelUnit();
+    const Vector3f world = (head * eye - oldHead * eye) * modelUnit;
+    const Matrix4f& xfm = context.headTransform;
+    Vector3f delta;
+    for (size_t i = 0; i < 3; ++i)
+        delta[i] = xfm(i, 0) * world[0] + xfm(i, 1) * world[1] +
+                   xfm(i, 2) * world[2];
+
+    const Vector3f& oldEye = context.eyeWall;
+    const Vector3f newEye = oldEye + delta;
+    if (oldEye.z() <= 0.f || newEye.z() <= 0.f)
+        return;
+
+    // frustum corners are (wall extent - eye) * near / eye.z
+    Frustumf& frustum = context.frustum;
+    const float toWall = oldEye.z() / frustum.nearPlane();
+    const float toNear = frustum.nearPlane() / newEye.z();
+    frustum.left() = (frustum.left() * toWall - delta.x()) * toNear;
+    frustum.right() = (frustum.right() * toWall - delta.x()) * toNear;
+    frustum.bottom() = (frustum.bottom() * toWall - delta.y()) * toNear;
+    frustum.top() = (frustum.top() * toWall - delta.y()) * toNear;
+
+    // headTransform = -trans(eye) * frustum transform
+    for (int i = 0; i < 16; i += 4)
+    {
+        context.headTransform.array[i] -= delta[0] * xfm.array[i + 3];
+        context.headTransform.array[i + 1] -= delta[1] * xfm.array[i + 3];
+        context.headTransform.array[i + 2] -= delta[2] * xfm.array[i + 3];
+    }
+    context.eyeWall = newEye;
+}
+
 Frustumf Channel::getScreenFrustum() const
 {
     const Pixel& pixel = getPixel();
@@ -502,13 +565,15 @@ const View* Channel::getNativeView() const
 void Channel::changeLatency(const uint32_t latency)
 {
 #ifndef NDEBUG
-    for (detail::Channel::StatisticsRBCIter i = _impl->statistics->begin();
-         i != _impl->statistics->end(); ++i)
+    for (const detail::Channel::FrameStatisticsPtr& stats : _impl->statistics)
     {
-        LBASSERT((*i).used == 0);
+        LBASSERT(stats->used == 0);
     }
 #endif // NDEBUG
-    _impl->statistics->resize(latency + 1);
+    _impl->statistics.resize(latency + 1);
+    for (detail::Channel::FrameStatisticsPtr& stats : _impl->statistics)
+        if (!stats)
+            stats.reset(new detail::Channel::FrameStatistics);
 }
 
 void Channel::addResultImageListener(ResultImageListener* listener)
@@ -888,11 +953,12 @@ bool Channel::processEvent(const EventType type, SizeEvent& event)
 
         event.dw = event.w / float(_impl->initialSize.x());
         event.dh = event.h / float(_impl->initialSize.y());
-        config->sendEvent(EVENT_VIEW_RESIZE) << event;
+        detail::EventCoalescer::add(getWindow(), config, EVENT_VIEW_RESIZE,
+                                    event);
         return true;
     }
 
-    config->sendEvent(type) << event;
+    detail::EventCoalescer::send(getWindow(), config, type) << event;
     return true;
 }
 
@@ -900,7 +966,10 @@ bool Channel::processEvent(const EventType type, PointerEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(type) << event;
+    if (detail::EventCoalescer::isCoalesced(type))
+        detail::EventCoalescer::add(getWindow(), config, type, event);
+    else
+        detail::EventCoalescer::send(getWindow(), config, type) << event;
     return true;
 }
 
@@ -908,7 +977,7 @@ bool Channel::processEvent(const EventType type, KeyEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(type) << event;
+    detail::EventCoalescer::send(getWindow(), config, type) << event;
     return true;
 }
 
@@ -1098,6 +1167,7 @@ void Channel::_frameTiles(RenderContext& context, const bool isLocal,
                 frames[i]->getFrameData()->setPixelViewport(getPixelViewport());
             }
 
+            _waitReadbackDepth();
             frameReadback(context.frameID, frames);
             readbackTime += getConfig()->getTime() - time;
 
@@ -1149,24 +1219,30 @@ void Channel::_frameTiles(RenderContext& context, const bool isLocal,
 
 void Channel::_refFrame(const uint32_t frameNumber)
 {
-    const size_t index = frameNumber % _impl->statistics->size();
-    detail::Channel::FrameStatistics& stats = _impl->statistics.data[index];
+    detail::Channel::FrameStatistics& stats =
+        _impl->getStatistics(frameNumber);
     LBASSERTINFO(stats.used > 0, frameNumber);
     ++stats.used;
 }
 
 void Channel::_unrefFrame(const uint32_t frameNumber)
 {
-    const size_t index = frameNumber % _impl->statistics->size();
-    detail::Channel::FrameStatistics& stats = _impl->statistics.data[index];
+    detail::Channel::FrameStatistics& stats =
+        _impl->getStatistics(frameNumber);
     if (--stats.used != 0) // Frame still in use
         return;
 
+    // All threads are done with the frame, aggregate their events
+    Statistics events;
+    stats.events.gather(events);
+    const Viewport region = stats.region;
+    stats.region = Viewport::FULL;
+
     send(getServer(), fabric::CMD_CHANNEL_FRAME_FINISH_REPLY)
-        << stats.region << frameNumber << stats.data;
+        << region << frameNumber << events;
 
-    stats.data.clear();
-    stats.region = Viewport::FULL;
+    for (Statistic& event : events)
+        processEvent(event);
     _impl->finishedFrame = frameNumber;
 }
 
@@ -1204,12 +1280,20 @@ void Channel::_frameReadback(const uint128_t& frameID,
     for (size_t i = 0; i < frames.size(); ++i)
         nImages[i] = frames[i]->getImages().size();
 
+    _waitReadbackDepth();
     frameReadback(frameID, frames);
     LBASSERT(stat->event.statistic.frameNumber > 0);
     const bool async = _asyncFinishReadback(nImages, frames);
     _setReady(async, stat.get(), frames);
 }
 
+void Channel::_waitReadbackDepth()
+{
+    const int32_t depth = getIAttribute(IATTR_HINT_READBACK_DEPTH);
+    if (depth > 0)
+        _impl->pendingReadbacks.waitLE(uint32_t(depth) - 1);
+}
+
 bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
                                    const Frames& frames)
 {
@@ -1241,9 +1325,10 @@ bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
 
                 hasAsyncReadback = true;
                 _refFrame(frameNumber);
+                ++_impl->pendingReadbacks;
 
                 send(getLocalNode(), fabric::CMD_CHANNEL_FINISH_READBACK)
-                    << co::ObjectVersion(frameData) << j << frameNumber
+                    << frameData->getDataVersion() << j << frameNumber
                     << getTaskID() << nodes << netNodes;
             }
             else // transmit images asynchronously
@@ -1277,7 +1362,13 @@ void Channel::_finishReadback(const co::ObjectVersion& frameDataVersion,
     LBASSERT(image->hasAsyncReadback());
 
     const GLEWContext* glewContext = window->getTransferGlewContext();
-    image->finishReadback(glewContext);
+    {
+        ChannelStatistics waitEvent(Statistic::CHANNEL_READBACK_WAIT, this,
+                                    frameNumber);
+        waitEvent.statistic.task = taskID;
+        image->finishReadback(glewContext);
+    }
+    --_impl->pendingReadbacks;
     LBASSERT(!image->hasAsyncReadback());
 
     // schedule async image tranmission
@@ -1300,7 +1391,7 @@ void Channel::_asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
                                         << " receiver " << *i << " on " << *j
                                         << std::endl;
         send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE)
-            << co::ObjectVersion(frame) << *i << *j << image << frameNumber
+            << frame->getDataVersion() << *i << *j << image << frameNumber
             << taskID;
     }
 }
@@ -1514,14 +1605,14 @@ void Channel::_asyncSetReady(const FrameDataPtr frame, detail::RBStat* stat,
     stat->ref(0);
 
     send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_SET_READY)
-        << co::ObjectVersion(frame) << stat << nodes << netNodes;
+        << frame->getDataVersion() << stat << nodes << netNodes;
 }
 
 void Channel::_setReady(FrameDataPtr frame, detail::RBStat* stat,
                         const std::vector<uint128_t>& nodes,
                         const co::NodeIDs& netNodes)
 {
-    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Set ready " << co::ObjectVersion(frame)
+    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Set ready " << frame->getDataVersion()
                                     << std::endl;
     frame->setReady();
 
@@ -1529,7 +1620,7 @@ void Channel::_setReady(FrameDataPtr frame, detail::RBStat* stat,
     _refFrame(frameNumber);
 
     send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_SET_READY_NODE)
-        << co::ObjectVersion(frame) << nodes << netNodes << frameNumber;
+        << frame->getDataVersion() << nodes << netNodes << frameNumber;
 
     const DrawableConfig& dc = getDrawableConfig();
     const size_t colorBytes = (3 * dc.colorBits + dc.alphaBits) / 8;
@@ -1666,11 +1757,11 @@ bool Channel::_cmdFrameStart(co::ICommand& cmd)
     bindFrameBuffer();
     frameStart(context.frameID, frameNumber);
 
-    const size_t index = frameNumber % _impl->statistics->size();
-    detail::Channel::FrameStatistics& statistic = _impl->statistics.data[index];
+    detail::Channel::FrameStatistics& statistic =
+        _impl->getStatistics(frameNumber);
     LBASSERTINFO(statistic.used == 0, "Frame " << frameNumber << " used "
                                                << statistic.used);
-    LBASSERT(statistic.data.empty());
+    LBASSERT(statistic.events.isEmpty());
     statistic.used = 1;
 
     resetContext();
@@ -1725,6 +1816,7 @@ bool Channel::_cmdFrameDraw(co::ICommand& cmd)
                      << context << std::endl;
 
     bindDrawFrameBuffer();
+    _latchHeadMatrix(context);
     _overrideContext(context);
     const uint32_t frameNumber = getCurrentFrame();
     ChannelStatistics event(Statistic::CHANNEL_DRAW, this, frameNumber,
@@ -1734,8 +1826,8 @@ bool Channel::_cmdFrameDraw(co::ICommand& cmd)
     // Set to full region if application has declared nothing
     if (!getRegion().isValid())
         declareRegion(getPixelViewport());
-    const size_t index = frameNumber % _impl->statistics->size();
-    _impl->statistics.data[index].region = getRegion() / getPixelViewport();
+    _impl->getStatistics(frameNumber).region =
+        getRegion() / getPixelViewport();
 
     resetContext();
     bindFrameBuffer();
@@ -1962,6 +2054,79 @@ bool Channel::_cmdDeleteTransferWindow(co::ICommand& cmd)
     getLocalNode()->serveRequest(command.read<uint32_t>());
     return true;
 }
+
+bool Channel::_cmdCalibrate(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    LBLOG(LOG_TASKS) << "TASK calibrate " << getName() << " " << command
+                     << std::endl;
+
+    // Synthetic workload: blend full-channel quads, then read back the result
+    static const size_t nLayers = 32;
+    static const size_t maxProbeSize = 1024 * 1024;
+
+    const PixelViewport& pvp = getNativePixelViewport();
+    float drawTime = 0.f;
+    float readbackTime = 0.f;
+    uint64_t probeSize = 0;
+
+    if (_impl->state == STATE_RUNNING && pvp.hasArea())
+    {
+        getWindow()->makeCurrent();
+        EQ_GL_CALL(bindFrameBuffer());
+        EQ_GL_CALL(glViewport(pvp.x, pvp.y, pvp.w, pvp.h));
+        EQ_GL_CALL(glScissor(pvp.x, pvp.y, pvp.w, pvp.h));
+        EQ_GL_CALL(glMatrixMode(GL_PROJECTION));
+        EQ_GL_CALL(glLoadIdentity());
+        EQ_GL_CALL(glOrtho(0., 1., 0., 1., -1., 1.));
+        EQ_GL_CALL(glMatrixMode(GL_MODELVIEW));
+        EQ_GL_CALL(glLoadIdentity());
+        EQ_GL_CALL(glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT));
+        EQ_GL_CALL(glDisable(GL_DEPTH_TEST));
+        EQ_GL_CALL(glDisable(GL_LIGHTING));
+        EQ_GL_CALL(glEnable(GL_BLEND));
+        EQ_GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        EQ_GL_CALL(glFinish());
+
+        lunchbox::Clock clock;
+        for (size_t i = 0; i < nLayers; ++i)
+        {
+            const float value = float(i) / float(nLayers);
+            glColor4f(value, 1.f - value, .5f, .5f);
+            glBegin(GL_QUADS);
+            glVertex2f(0.f, 0.f);
+            glVertex2f(1.f, 0.f);
+            glVertex2f(1.f, 1.f);
+            glVertex2f(0.f, 1.f);
+            glEnd();
+        }
+        EQ_GL_CALL(glFinish());
+        drawTime = clock.resetTimef();
+
+        std::vector<uint8_t> pixels(size_t(pvp.getArea()) * 4);
+        EQ_GL_CALL(glReadPixels(pvp.x, pvp.y, pvp.w, pvp.h, GL_RGBA,
+                                GL_UNSIGNED_BYTE, pixels.data()));
+        EQ_GL_CALL(glFinish());
+        readbackTime = clock.getTimef();
+
+        EQ_GL_CALL(glPopAttrib());
+        probeSize = std::min(pixels.size(), maxProbeSize);
+    }
+
+    send(command.getRemoteNode(), fabric::CMD_CHANNEL_CALIBRATE_REPLY)
+        << drawTime << readbackTime << uint32_t(pvp.getArea()) << probeSize;
+    return true;
+}
+
+bool Channel::_cmdCalibrateProbe(co::ICommand& cmd)
+{
+    // answered by the command thread, outside of the queued frame tasks
+    co::ObjectICommand command(cmd);
+    const std::vector<uint8_t> probe(command.read<uint64_t>());
+    send(command.getRemoteNode(), fabric::CMD_CHANNEL_CALIBRATE_PROBE_REPLY)
+        << probe;
+    return true;
+}
 }
 
 #include <eq/fabric/channel.ipp>
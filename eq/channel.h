@@ -626,6 +626,9 @@ private:
     /** Setup the current rendering context. */
     void _overrideContext(RenderContext& context);
 
+    /** Apply the newest latched head matrix of the observer to the context */
+    void _latchHeadMatrix(RenderContext& context);
+
     /** Initialize the channel's drawable config. */
     void _initDrawableConfig();
 
@@ -648,6 +651,8 @@ private:
 
     void _frameReadback(const uint128_t& frameID,
                         const co::ObjectVersions& frames);
+    /** Wait until a readback may start within IATTR_HINT_READBACK_DEPTH. */
+    void _waitReadbackDepth();
     void _finishReadback(const co::ObjectVersion& frameDataVersion,
                          const uint64_t imageIndex, const uint32_t frameNumber,
                          const uint32_t taskID,
@@ -699,6 +704,8 @@ private:
     bool _cmdStopFrame(co::ICommand& command);
     bool _cmdFrameTiles(co::ICommand& command);
     bool _cmdDeleteTransferWindow(co::ICommand& command);
+    bool _cmdCalibrate(co::ICommand& command);
+    bool _cmdCalibrateProbe(co::ICommand& command);
 
     LB_TS_VAR(_pipeThread);
 };
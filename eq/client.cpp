@@ -39,6 +39,7 @@
 #include <co/connectionDescription.h>
 #include <co/global.h>
 #include <co/iCommand.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/dso.h>
 #include <lunchbox/file.h>
 #include <lunchbox/term.h>
@@ -48,6 +49,8 @@
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include <thread>
+
 #ifdef _MSC_VER
 #include <direct.h>
 #define chdir _chdir
@@ -90,6 +93,14 @@ public:
     float modelUnit;
     QApplication* qtApp;
     bool running;
+    std::vector<std::thread> launches; //!< Tree launches in progress
+
+    void joinLaunches()
+    {
+        for (std::thread& launch : launches)
+            launch.join();
+        launches.clear();
+    }
 
     void initQt(int argc LB_UNUSED, char** argv LB_UNUSED)
     {
@@ -122,6 +133,8 @@ Client::Client()
                     ClientFunc(this, &Client::_cmdExit), &_impl->queue);
     registerCommand(fabric::CMD_CLIENT_INTERRUPT,
                     ClientFunc(this, &Client::_cmdInterrupt), &_impl->queue);
+    registerCommand(fabric::CMD_CLIENT_LAUNCH,
+                    ClientFunc(this, &Client::_cmdLaunch), &_impl->queue);
 
     LBVERB << "New client at " << (void*)this << std::endl;
 }
@@ -131,6 +144,7 @@ Client::~Client()
     LBVERB << "Delete client at " << (void*)this << std::endl;
     LBASSERT(isClosed());
     close();
+    _impl->joinLaunches();
     delete _impl;
 }
 
@@ -337,6 +351,7 @@ bool Client::exitLocal()
     delete _impl->qtApp;
     _impl->qtApp = 0;
 #endif
+    _impl->joinLaunches();
     _impl->activeLayouts.clear();
     _impl->modelUnit = EQ_UNDEFINED_UNIT;
     return fabric::Client::exitLocal();
@@ -433,6 +448,94 @@ bool Client::_cmdInterrupt(co::ICommand&)
     return true;
 }
 
+namespace
+{
+/** A render node launched by this render client during a tree launch. */
+class LaunchNode : public co::Node
+{
+public:
+    LaunchNode(const std::string& workDir, const std::string& quote)
+        : _workDir(workDir)
+        , _quote(quote)
+    {
+    }
+
+private:
+    const std::string _workDir;
+    const std::string _quote;
+
+    std::string getWorkDir() const override { return _workDir; }
+    std::string getLaunchQuote() const override { return _quote; }
+};
+
+typedef std::vector<std::pair<co::NodePtr, uint32_t>> LaunchRequests;
+
+/** Wait for the launched processes, reply to the server per node. */
+void _syncLaunches(co::LocalNode* client, co::NodePtr server,
+                   const LaunchRequests& requests, const int64_t timeout)
+{
+    lunchbox::Clock clock;
+    for (const auto& request : requests)
+    {
+        co::NodePtr node = request.first;
+        const int64_t time = std::max(int64_t(0), timeout - clock.getTime64());
+        const bool launched = client->syncLaunch(node->getNodeID(), time);
+        if (launched)
+            LBINFO << "Launched node on " << node->getHostname() << " in "
+                   << clock.getTime64() << " ms" << std::endl;
+        else
+            LBWARN << "Node on " << node->getHostname()
+                   << " did not connect within " << timeout << " ms"
+                   << std::endl;
+
+        server->send(fabric::CMD_CLIENT_LAUNCH_REPLY) << request.second
+                                                      << launched;
+    }
+}
+}
+
+bool Client::_cmdLaunch(co::ICommand& command)
+{
+    const int64_t timeout = command.read<int64_t>();
+    const std::string& workDir = command.read<std::string>();
+    const uint32_t nNodes = command.read<uint32_t>();
+
+    co::NodePtr server = command.getRemoteNode();
+    LaunchRequests requests;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        const uint32_t requestID = command.read<uint32_t>();
+        std::string data = command.read<std::string>();
+        const std::string& host = command.read<std::string>();
+        const std::string& quote = command.read<std::string>();
+        const std::string& launchCommand = command.read<std::string>();
+
+        co::NodePtr node = new LaunchNode(workDir, quote);
+        if (!node->deserialize(data))
+        {
+            LBWARN << "Can't parse node data for " << host << std::endl;
+            server->send(fabric::CMD_CLIENT_LAUNCH_REPLY) << requestID << false;
+            continue;
+        }
+        node->setHostname(host);
+
+        if (launch(node, launchCommand))
+            requests.push_back(std::make_pair(node, requestID));
+        else
+        {
+            LBWARN << "Launch of node on " << host << " failed" << std::endl;
+            server->send(fabric::CMD_CLIENT_LAUNCH_REPLY) << requestID << false;
+        }
+    }
+
+    // wait for the processes off the command queue, the server falls back to
+    // a direct launch for each node reported as failed
+    if (!requests.empty())
+        _impl->launches.push_back(
+            std::thread(_syncLaunches, this, server, requests, timeout));
+    return true;
+}
+
 namespace
 {
 class StopNodesVisitor : public ServerVisitor
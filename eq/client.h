@@ -160,6 +160,7 @@ private:
     /** The command functions. */
     bool _cmdExit(co::ICommand& command);
     bool _cmdInterrupt(co::ICommand& command);
+    bool _cmdLaunch(co::ICommand& command);
 };
 }
 
@@ -20,6 +20,8 @@
 
 #include "messagePump.h"
 
+#include "detail/eventCoalescer.h"
+
 #include <co/iCommand.h>
 #include <lunchbox/clock.h>
 
@@ -65,7 +67,10 @@ co::ICommand CommandQueue::pop(const uint32_t timeout)
     while (true)
     {
         if (_messagePump)
-            _messagePump->dispatchAll(); // non-blocking
+        {
+            _messagePump->dispatchAll();     // non-blocking
+            detail::EventCoalescer::flush(); // send the events of this batch
+        }
 
         // Poll for a command
         if (!isEmpty())
@@ -102,7 +107,10 @@ co::ICommands CommandQueue::popAll(const uint32_t timeout)
     while (true)
     {
         if (_messagePump)
-            _messagePump->dispatchAll(); // non-blocking
+        {
+            _messagePump->dispatchAll();     // non-blocking
+            detail::EventCoalescer::flush(); // send the events of this batch
+        }
 
         // Poll for commands
         if (!isEmpty())
@@ -136,6 +144,7 @@ co::ICommand CommandQueue::tryPop()
 {
     if (_messagePump)
         _messagePump->dispatchAll(); // non-blocking
+    detail::EventCoalescer::flush();
 
     return co::CommandQueue::tryPop();
 }
@@ -144,5 +153,6 @@ void CommandQueue::pump()
 {
     if (_messagePump)
         _messagePump->dispatchAll(); // non-blocking
+    detail::EventCoalescer::flush();
 }
 }
@@ -62,6 +62,10 @@ static const char* depthDBKey = shaderDBKey + 2;
 
 // Image used for CPU-based assembly
 static lunchbox::PerThread<Image> _resultImage;
+// Image used for merging one subpixel set during CPU-based assembly
+static lunchbox::PerThread<Image> _subPixelImage;
+// Color sums of all subpixel sets during CPU-based assembly
+static lunchbox::PerThread<std::vector<uint16_t>> _subPixelSum;
 
 struct CPUAssemblyFormat
 {
@@ -71,6 +75,8 @@ struct CPUAssemblyFormat
         , depthInt(0)
         , depthExt(0)
         , blend(blend_)
+        , pixel(false)
+        , subPixel(false)
     {
     }
 
@@ -79,6 +85,8 @@ struct CPUAssemblyFormat
     uint32_t depthInt;
     uint32_t depthExt;
     const bool blend;
+    bool pixel;    //!< pixel-decomposed inputs, interleaved on merge
+    bool subPixel; //!< subpixel-decomposed inputs, averaged on merge
 };
 
 bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
@@ -86,10 +94,15 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     const bool hasColor = image->hasPixelData(Frame::Buffer::color);
     const bool hasDepth = image->hasPixelData(Frame::Buffer::depth);
 
+    if (!hasColor)
+        return false;
+
     if ( // Not an alpha-blending compositing
-        (!format.blend || !hasColor || !image->hasAlpha()) &&
+        (!format.blend || !image->hasAlpha()) &&
         // and not a depth-sorting compositing
-        (!hasColor || !hasDepth))
+        !hasDepth &&
+        // and not a pixel or subpixel compositing
+        !format.pixel && !format.subPixel)
     {
         return false;
     }
@@ -109,8 +122,8 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     {
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
     case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-        if (!hasDepth)
-            // blending of RGB10A2 not implemented
+        if (!hasDepth || format.subPixel)
+            // blending and averaging of RGB10A2 not implemented
             return false;
         break;
 
@@ -147,19 +160,25 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
         return false;
 
     // Test that the input frames have color and depth buffers or that
-    // alpha-blended assembly is used with multiple RGBA buffers. We assume then
-    // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly. Also test early
-    // for unsupported decomposition modes
+    // alpha-blended assembly is used with multiple RGBA buffers, or that pixel
+    // or subpixel-decomposed color buffers are interleaved or averaged. We
+    // assume then that we will have at least one image per frame so most
+    // likely it's worth to wait for the images and to do a CPU-based
+    // assembly. Also test early for unsupported zoomed frames.
+    CPUAssemblyFormat format(blend);
+    format.subPixel = Compositor::isSubPixelDecomposition(frames);
+    for (const Frame* frame : frames)
+        if (frame->getFrameData()->getContext().pixel != Pixel::ALL)
+            format.pixel = true;
+
     const Frame::Buffer desiredBuffers =
         blend ? Frame::Buffer::color
               : Frame::Buffer::color | Frame::Buffer::depth;
+    const bool interleave = format.pixel || format.subPixel;
     for (const Frame* frame : frames)
     {
-        const RenderContext& context = frame->getFrameData()->getContext();
-
-        if (frame->getBuffers() != desiredBuffers ||
-            context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
+        if ((frame->getBuffers() != desiredBuffers &&
+             (!interleave || frame->getBuffers() != Frame::Buffer::color)) ||
             frame->getFrameData()->getZoom() != Zoom::NONE ||
             frame->getZoom() != Zoom::NONE) // Not supported by CPU compositor
         {
@@ -172,7 +191,6 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
     // all other preconditions for our CPU-based assembly code are true.
     size_t nImages = 0;
     const uint32_t timeout = channel->getConfig()->getTimeout();
-    CPUAssemblyFormat format(blend);
 
     for (const Frame* frame : frames)
     {
@@ -196,11 +214,15 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
 bool _useCPUAssembly(const ImageOps& ops, const bool blend)
 {
     CPUAssemblyFormat format(blend);
-    size_t nImages = 0;
+    format.subPixel = Compositor::isSubPixelDecomposition(ops);
+    for (const ImageOp& op : ops)
+        if (op.image->getContext().pixel != Pixel::ALL)
+            format.pixel = true;
 
+    size_t nImages = 0;
     for (const ImageOp& op : ops)
     {
-        if (!_useCPUAssembly(op.image, format))
+        if (op.zoom != Zoom::NONE || !_useCPUAssembly(op.image, format))
             return false;
         ++nImages;
     }
@@ -241,6 +263,22 @@ void _collectOutputData(const PixelData& pixelData, uint32_t& internalFormat,
     externalFormat = pixelData.externalFormat;
 }
 
+/** @return the destination area covered by a, maybe pixel-decomposed, image */
+PixelViewport _getDestinationPVP(const ImageOp& op)
+{
+    const PixelViewport& pvp = op.image->getPixelViewport();
+    const Pixel& pixel = op.image->getContext().pixel;
+    if (pixel == Pixel::ALL || !pvp.hasArea())
+        return pvp + op.offset;
+
+    return PixelViewport(op.offset.x() + pvp.x * int32_t(pixel.w) +
+                             int32_t(pixel.x),
+                         op.offset.y() + pvp.y * int32_t(pixel.h) +
+                             int32_t(pixel.y),
+                         (pvp.w - 1) * int32_t(pixel.w) + 1,
+                         (pvp.h - 1) * int32_t(pixel.h) + 1);
+}
+
 bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
                         uint32_t& colorInt, uint32_t& colorPixelSize,
                         uint32_t& colorExt, uint32_t& depthInt,
@@ -248,9 +286,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
 {
     for (const ImageOp& op : ops)
     {
-        const RenderContext& context = op.image->getContext();
-        if (context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            op.zoom != Zoom::NONE ||
+        if (op.zoom != Zoom::NONE ||
             op.image->getStorageType() != Frame::TYPE_MEMORY)
         {
             return false;
@@ -259,7 +295,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        destPVP.merge(op.image->getPixelViewport() + op.offset);
+        destPVP.merge(_getDestinationPVP(op));
 
         _collectOutputData(op.image->getPixelData(Frame::Buffer::color),
                            colorInt, colorPixelSize, colorExt);
@@ -288,9 +324,14 @@ void _mergeDBImage(void* destColor, void* destDepth,
     uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
 
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     const uint32_t* color = reinterpret_cast<const uint32_t*>(
         image->getPixelPointer(Frame::Buffer::color));
@@ -300,7 +341,7 @@ void _mergeDBImage(void* destColor, void* destDepth,
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
-        const uint32_t skip = (destY + y) * destPVP.w + destX;
+        const uint32_t skip = (destY + y * stepY) * destPVP.w + destX;
         uint32_t* destColorIt = destC + skip;
         uint32_t* destDepthIt = destD + skip;
         const uint32_t* colorIt = color + y * pvp.w;
@@ -314,8 +355,8 @@ void _mergeDBImage(void* destColor, void* destDepth,
                 *destDepthIt = *depthIt;
             }
 
-            ++destColorIt;
-            ++destDepthIt;
+            destColorIt += stepX;
+            destDepthIt += stepX;
             ++colorIt;
             ++depthIt;
         }
@@ -333,23 +374,44 @@ void _merge2DImage(void* destColor, void* destDepth,
     uint8_t* destD = reinterpret_cast<uint8_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     LBASSERT(image->hasPixelData(Frame::Buffer::color));
 
     const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
     const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
     const size_t rowLength = pvp.w * pixelSize;
+    const size_t destStep = stepX * pixelSize;
 
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
-        const size_t skip = ((destY + y) * destPVP.w + destX) * pixelSize;
-        memcpy(destC + skip, color + y * pvp.w * pixelSize, rowLength);
-        // clear depth, for depth-assembly into existing FB
-        if (destD)
-            lunchbox::setZero(destD + skip, rowLength);
+        const size_t skip =
+            ((destY + y * stepY) * destPVP.w + destX) * pixelSize;
+        const uint8_t* src = color + y * pvp.w * pixelSize;
+        if (stepX == 1)
+        {
+            memcpy(destC + skip, src, rowLength);
+            // clear depth, for depth-assembly into existing FB
+            if (destD)
+                lunchbox::setZero(destD + skip, rowLength);
+            continue;
+        }
+
+        // scatter pixel-decomposed row
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            memcpy(destC + skip + x * destStep, src + x * pixelSize,
+                   pixelSize);
+            if (destD)
+                lunchbox::setZero(destD + skip + x * destStep, pixelSize);
+        }
     }
 }
 
@@ -361,8 +423,13 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
     int32_t* destColor = reinterpret_cast<int32_t*>(dest);
 
     const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     LBASSERT(image->getPixelSize(Frame::Buffer::color) == 4);
     LBASSERT(image->hasPixelData(Frame::Buffer::color));
@@ -382,14 +449,15 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
 
     int32_t* destColorStart = destColor + destY * destPVP.w + destX;
     const uint32_t step = sizeof(int32_t);
+    const uint32_t destStep = step * stepX;
 
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
         const unsigned char* src =
             reinterpret_cast<const uint8_t*>(color + pvp.w * y);
-        unsigned char* dst =
-            reinterpret_cast<uint8_t*>(destColorStart + destPVP.w * y);
+        unsigned char* dst = reinterpret_cast<uint8_t*>(
+            destColorStart + destPVP.w * y * stepY);
 
         for (int32_t x = 0; x < pvp.w; ++x)
         {
@@ -399,7 +467,7 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
             dst[3] = src[3] * dst[3] >> 8;
 
             src += step;
-            dst += step;
+            dst += destStep;
         }
     }
 }
@@ -423,6 +491,63 @@ void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
     }
 }
 
+/**
+ * Merge each subpixel set separately and average the color of all sets into
+ * the result. Only used for 8 bit per channel color.
+ */
+void _mergeSubPixelImages(ImageOps ops, const bool blend,
+                          const PixelData& colorPixels,
+                          const PixelData* depthPixels, Image* result)
+{
+    LBVERB << "CPU-subpixel assembly" << std::endl;
+    LBASSERT(colorPixels.externalFormat == EQ_COMPRESSOR_DATATYPE_RGBA ||
+             colorPixels.externalFormat == EQ_COMPRESSOR_DATATYPE_BGRA);
+
+    if (!_subPixelImage)
+        _subPixelImage = new Image;
+    Image* image = _subPixelImage.get();
+    if (!_subPixelSum)
+        _subPixelSum = new std::vector<uint16_t>;
+
+    const PixelViewport& destPVP = colorPixels.pvp;
+    const ssize_t size = ssize_t(destPVP.getArea()) * 4;
+    std::vector<uint16_t>& sum = *_subPixelSum;
+    sum.assign(size, 0); // keeps the capacity of previous frames
+    uint16_t* sumPtr = sum.data();
+    uint32_t nSubPixels = 0;
+
+    image->setPixelViewport(destPVP);
+    while (!ops.empty())
+    {
+        const ImageOps current = Compositor::extractOneSubPixel(ops);
+
+        image->setPixelData(Frame::Buffer::color, colorPixels);
+        void* destDepth = 0;
+        if (depthPixels)
+        {
+            image->setPixelData(Frame::Buffer::depth, *depthPixels);
+            destDepth = image->getPixelPointer(Frame::Buffer::depth);
+        }
+        _mergeImages(current, blend,
+                     image->getPixelPointer(Frame::Buffer::color), destDepth,
+                     destPVP);
+
+        const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+#pragma omp parallel for
+        for (ssize_t i = 0; i < size; ++i)
+            sumPtr[i] += color[i];
+        ++nSubPixels;
+    }
+
+    // divide by multiplying with the 16.16 fixed point reciprocal
+    LBASSERT(nSubPixels > 0 && nSubPixels < 256);
+    const uint32_t scale = (65536u + nSubPixels / 2) / nSubPixels;
+    uint8_t* dest = result->getPixelPointer(Frame::Buffer::color);
+#pragma omp parallel for
+    for (ssize_t i = 0; i < size; ++i)
+        dest[i] = uint8_t(LB_MIN((sumPtr[i] * scale + 32768u) >> 16, 255u));
+}
+
 Vector4f _getCoords(const ImageOp& op, const PixelViewport& pvp)
 {
     const Pixel& pixel = op.image->getContext().pixel;
@@ -690,8 +815,12 @@ uint32_t Compositor::assembleFrames(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    if (_useCPUAssembly(frames, channel))
+    // An external accumulation buffer needs each subpixel step separately
+    if ((!accum || !isSubPixelDecomposition(frames)) &&
+        _useCPUAssembly(frames, channel))
+    {
         return assembleFramesCPU(frames, channel);
+    }
 
     // else
     return assembleFramesUnsorted(frames, channel, accum);
@@ -703,6 +832,12 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
     if (ops.empty())
         return 0;
 
+    if ((!accum || !isSubPixelDecomposition(ops)) &&
+        _useCPUAssembly(ops, true))
+    {
+        return assembleImagesCPU(ops, channel, true);
+    }
+
     if (isSubPixelDecomposition(ops))
     {
         const bool coreProfile =
@@ -742,13 +877,9 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
         return count;
     }
 
-    uint32_t count = 1;
-    if (_useCPUAssembly(ops, true))
-        count = assembleImagesCPU(ops, channel, true);
-    else
-        for (const ImageOp& op : ops)
-            assembleImage(op, channel);
-    return count;
+    for (const ImageOp& op : ops)
+        assembleImage(op, channel);
+    return 1;
 }
 
 uint32_t Compositor::blendFrames(const Frames& frames, Channel* channel,
@@ -1010,7 +1141,7 @@ uint32_t Compositor::assembleFramesCPU(const Frames& frames, Channel* channel,
         return 0;
 
     // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result =
@@ -1025,7 +1156,7 @@ uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
         return 0;
 
     // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result = mergeImagesCPU(images, blend);
@@ -1085,15 +1216,31 @@ const Image* Compositor::mergeImagesCPU(const ImageOps& ops, const bool blend)
     colorPixels.pvp = destPVP;
     result->setPixelData(Frame::Buffer::color, colorPixels);
 
+    PixelData depthPixels;
+    depthPixels.internalFormat = depthInt;
+    depthPixels.externalFormat = depthExt;
+    depthPixels.pixelSize = depthPixelSize;
+    depthPixels.pvp = destPVP;
+
+    if (isSubPixelDecomposition(ops))
+    {
+        if (colorExt != EQ_COMPRESSOR_DATATYPE_RGBA &&
+            colorExt != EQ_COMPRESSOR_DATATYPE_BGRA)
+        {
+            LBWARN << "CPU subpixel assembly needs 8 bit color, not 0x"
+                   << std::hex << colorExt << std::dec << std::endl;
+            return 0;
+        }
+        // the averaged result has no meaningful depth
+        _mergeSubPixelImages(ops, blend, colorPixels,
+                             depthInt ? &depthPixels : 0, result);
+        return result;
+    }
+
     void* destDepth = 0;
     if (depthInt != 0) // at least one depth assembly
     {
         LBASSERT(depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
-        PixelData depthPixels;
-        depthPixels.internalFormat = depthInt;
-        depthPixels.externalFormat = depthExt;
-        depthPixels.pixelSize = depthPixelSize;
-        depthPixels.pvp = destPVP;
         result->setPixelData(Frame::Buffer::depth, depthPixels);
         destDepth = result->getPixelPointer(Frame::Buffer::depth);
     }
@@ -99,6 +99,10 @@ public:
      * composited into the current framebuffer, using preset OpenGL blending
      * state.
      *
+     * Pixel-decomposed images are interleaved into the intermediate image.
+     * Subpixel-decomposed images are merged per subpixel step, and the color
+     * of all steps is averaged. The averaged image has no depth.
+     *
      * @param frames the frames to assemble.
      * @param channel the destination channel.
      * @param blend blend color-only images if they have an alpha
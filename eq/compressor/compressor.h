@@ -75,6 +75,19 @@ public:
         LBDONTCALL;
     }
 
+    /**
+     * Compress two-dimensional data.
+     *
+     * The default implementation calls compress() with the number of pixels.
+     *
+     * @param inData data to compress.
+     * @param inDims the dimensions of the input data (x, w, y, h).
+     * @param flags capability flags for the compression.
+     */
+    virtual void compress2D(const void* const inData,
+                            const eq_uint64_t inDims[4],
+                            const eq_uint64_t flags);
+
     typedef lunchbox::Bufferb Result;
     typedef std::vector<Result*> Results;
 
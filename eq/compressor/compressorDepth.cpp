@@ -0,0 +1,508 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorDepth.h"
+
+#include <lunchbox/buffer.h>
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <cstring>
+
+// Stream format, one result per band of up to _bandHeight rows:
+//   header: version u8, shift u8, reserved u16, width u32, y u32, height u32
+//   8x8 blocks in raster order, each:
+//     mode u8, with _mixed set if the block has background pixels
+//     [foreground mask u64, bit y*8+x, if _mixed]
+//     _modeEmpty: nothing, all pixels are background
+//     _modePlane: base u32, anchor u8 (x | y << 4), dx i32, dy i32 (both in
+//                 1/16th), nBits u8, zigzag residuals of the foreground pixels
+//                 bit-packed with nBits each, padded to a full byte
+//     _modeRaw:   the foreground pixels as u32
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+const uint8_t _version = 1;
+const uint32_t _background = 0xffffffffu;
+const uint32_t _maxDepth = 0xfffffffeu;
+const unsigned _blockSize = 8;
+const unsigned _bandHeight = 64;
+const size_t _headerSize = 16;
+// mode, mask, base, anchor, dx, dy, nBits, 64 * 32 bit data
+const size_t _maxBlockSize = 1 + 8 + 4 + 1 + 4 + 4 + 1 + 64 * 4;
+
+enum Mode
+{
+    _modeEmpty = 0,
+    _modePlane = 1,
+    _modeRaw = 2,
+    _mixed = 0x80
+};
+
+template <unsigned name>
+void _getInfo(EqCompressorInfo* const info);
+
+void _fillInfo(EqCompressorInfo* const info)
+{
+    info->version = EQ_COMPRESSOR_VERSION;
+    info->capabilities = EQ_COMPRESSOR_DATA_2D;
+    info->tokenType = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->outputTokenType = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->outputTokenSize = 4;
+    info->speed = .5f;
+}
+
+template <>
+void _getInfo<EQ_COMPRESSOR_DEPTH_PREDICT>(EqCompressorInfo* const info)
+{
+    _fillInfo(info);
+    info->name = EQ_COMPRESSOR_DEPTH_PREDICT;
+    info->quality = 1.f;
+    info->ratio = .2f;
+}
+
+template <>
+void _getInfo<EQ_COMPRESSOR_DEPTH_PREDICT_8>(EqCompressorInfo* const info)
+{
+    _fillInfo(info);
+    info->name = EQ_COMPRESSOR_DEPTH_PREDICT_8;
+    info->quality = .9999f;
+    info->ratio = .15f;
+}
+
+template <>
+void _getInfo<EQ_COMPRESSOR_DEPTH_PREDICT_16>(EqCompressorInfo* const info)
+{
+    _fillInfo(info);
+    info->name = EQ_COMPRESSOR_DEPTH_PREDICT_16;
+    info->quality = .999f;
+    info->ratio = .1f;
+}
+
+template <unsigned name>
+bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions(name, _getInfo<name>,
+                              CompressorDepth::getNewCompressor,
+                              CompressorDepth::getNewDecompressor,
+                              CompressorDepth::decompress,
+                              CompressorDepth::isCompatible));
+    return true;
+}
+
+static bool _initialized LB_UNUSED =
+    _register<EQ_COMPRESSOR_DEPTH_PREDICT>() &&
+    _register<EQ_COMPRESSOR_DEPTH_PREDICT_8>() &&
+    _register<EQ_COMPRESSOR_DEPTH_PREDICT_16>();
+
+template <class T>
+inline void _write(uint8_t*& out, const T value)
+{
+    ::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+template <class T>
+inline T _read(const uint8_t*& in)
+{
+    T value;
+    ::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(uint8_t*& out)
+        : _out(out)
+        , _bits(0)
+        , _nBits(0)
+    {
+    }
+
+    void put(const uint32_t value, const unsigned nBits)
+    {
+        _bits |= uint64_t(value) << _nBits;
+        _nBits += nBits;
+        while (_nBits >= 8)
+        {
+            *_out++ = uint8_t(_bits);
+            _bits >>= 8;
+            _nBits -= 8;
+        }
+    }
+
+    void flush()
+    {
+        if (_nBits > 0)
+            *_out++ = uint8_t(_bits);
+        _bits = 0;
+        _nBits = 0;
+    }
+
+private:
+    uint8_t*& _out;
+    uint64_t _bits;
+    unsigned _nBits;
+};
+
+class BitReader
+{
+public:
+    explicit BitReader(const uint8_t*& in)
+        : _in(in)
+        , _bits(0)
+        , _nBits(0)
+    {
+    }
+
+    uint32_t get(const unsigned nBits)
+    {
+        while (_nBits < nBits)
+        {
+            _bits |= uint64_t(*_in++) << _nBits;
+            _nBits += 8;
+        }
+        const uint32_t value = uint32_t(_bits & ((uint64_t(1) << nBits) - 1));
+        _bits >>= nBits;
+        _nBits -= nBits;
+        return value;
+    }
+
+private:
+    const uint8_t*& _in;
+    uint64_t _bits;
+    unsigned _nBits;
+};
+
+inline int64_t _predict(const uint32_t base, const int32_t dx,
+                        const int32_t dy, const int x, const int y)
+{
+    const int64_t value =
+        (int64_t(base) * 16 + int64_t(dx) * x + int64_t(dy) * y + 8) >> 4;
+    return std::min(std::max(value, int64_t(0)), int64_t(_maxDepth));
+}
+
+inline uint64_t _zigzag(const int64_t value)
+{
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+inline int64_t _unzigzag(const uint64_t value)
+{
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+inline unsigned _getNBits(uint64_t value)
+{
+    unsigned nBits = 0;
+    while (value)
+    {
+        ++nBits;
+        value >>= 1;
+    }
+    return nBits;
+}
+
+int32_t _getSlope(const int64_t sum, const int64_t n)
+{
+    if (n == 0)
+        return 0;
+    const int64_t slope = (sum * 16 + (sum >= 0 ? n / 2 : -n / 2)) / n;
+    return int32_t(std::min(std::max(slope, int64_t(-0x7fffffff)),
+                            int64_t(0x7fffffff)));
+}
+
+void _compressBlock(const uint32_t* const in, const size_t pitch,
+                    const unsigned width, const unsigned height,
+                    const unsigned shift, uint8_t*& out)
+{
+    uint64_t mask = 0;
+    unsigned nForeground = 0;
+    for (unsigned y = 0; y < height; ++y)
+        for (unsigned x = 0; x < width; ++x)
+            if (in[y * pitch + x] != _background)
+            {
+                mask |= uint64_t(1) << (y * _blockSize + x);
+                ++nForeground;
+            }
+
+    if (nForeground == 0)
+    {
+        *out++ = _modeEmpty;
+        return;
+    }
+
+    // Fit a plane through the first foreground pixel, using the mean
+    // difference between neighbouring foreground pixels as slopes
+    unsigned ax = 0;
+    unsigned ay = 0;
+    int64_t sumX = 0, nX = 0, sumY = 0, nY = 0;
+    bool anchored = false;
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const uint32_t value = in[y * pitch + x];
+            if (value == _background)
+                continue;
+            if (!anchored)
+            {
+                ax = x;
+                ay = y;
+                anchored = true;
+            }
+            if (x + 1 < width && in[y * pitch + x + 1] != _background)
+            {
+                sumX += int64_t(in[y * pitch + x + 1]) - value;
+                ++nX;
+            }
+            if (y + 1 < height && in[(y + 1) * pitch + x] != _background)
+            {
+                sumY += int64_t(in[(y + 1) * pitch + x]) - value;
+                ++nY;
+            }
+        }
+    }
+    const uint32_t base = in[ay * pitch + ax];
+    const int32_t dx = _getSlope(sumX, nX);
+    const int32_t dy = _getSlope(sumY, nY);
+
+    uint64_t residuals[_blockSize * _blockSize];
+    uint64_t maxResidual = 0;
+    const int64_t step = int64_t(1) << shift;
+    const int64_t half = step >> 1;
+    unsigned i = 0;
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const uint32_t value = in[y * pitch + x];
+            if (value == _background)
+                continue;
+            const int64_t residual =
+                int64_t(value) - _predict(base, dx, dy, int(x) - int(ax),
+                                          int(y) - int(ay));
+            const int64_t quantized =
+                (residual + (residual >= 0 ? half : -half)) / step;
+            residuals[i] = _zigzag(quantized);
+            maxResidual = std::max(maxResidual, residuals[i]);
+            ++i;
+        }
+    }
+
+    const unsigned nBits = _getNBits(maxResidual);
+    const bool mixed = nForeground < width * height;
+    const uint8_t mode = nBits > 32 ? _modeRaw : _modePlane;
+    *out++ = mode | (mixed ? _mixed : 0);
+    if (mixed)
+        _write(out, mask);
+
+    if (mode == _modeRaw)
+    {
+        for (unsigned y = 0; y < height; ++y)
+            for (unsigned x = 0; x < width; ++x)
+                if (in[y * pitch + x] != _background)
+                    _write(out, in[y * pitch + x]);
+        return;
+    }
+
+    _write(out, base);
+    *out++ = uint8_t(ax | (ay << 4));
+    _write(out, dx);
+    _write(out, dy);
+    *out++ = uint8_t(nBits);
+    if (nBits == 0)
+        return;
+
+    BitWriter writer(out);
+    for (unsigned j = 0; j < nForeground; ++j)
+        writer.put(uint32_t(residuals[j]), nBits);
+    writer.flush();
+}
+
+void _decompressBlock(const uint8_t*& in, uint32_t* const out,
+                      const size_t pitch, const unsigned width,
+                      const unsigned height, const unsigned shift)
+{
+    const uint8_t mode = *in++;
+    if (mode == _modeEmpty)
+    {
+        for (unsigned y = 0; y < height; ++y)
+            std::fill_n(out + y * pitch, width, _background);
+        return;
+    }
+
+    uint64_t mask = ~uint64_t(0);
+    if (mode & _mixed)
+        mask = _read<uint64_t>(in);
+
+    if ((mode & ~_mixed) == _modeRaw)
+    {
+        for (unsigned y = 0; y < height; ++y)
+            for (unsigned x = 0; x < width; ++x)
+                out[y * pitch + x] = (mask >> (y * _blockSize + x)) & 1
+                                         ? _read<uint32_t>(in)
+                                         : _background;
+        return;
+    }
+
+    LBASSERT((mode & ~_mixed) == _modePlane);
+    const uint32_t base = _read<uint32_t>(in);
+    const uint8_t anchor = *in++;
+    const int ax = anchor & 0xf;
+    const int ay = anchor >> 4;
+    const int32_t dx = _read<int32_t>(in);
+    const int32_t dy = _read<int32_t>(in);
+    const unsigned nBits = *in++;
+
+    BitReader reader(in);
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            if (!((mask >> (y * _blockSize + x)) & 1))
+            {
+                out[y * pitch + x] = _background;
+                continue;
+            }
+
+            const int64_t residual =
+                nBits ? _unzigzag(reader.get(nBits)) << shift : 0;
+            const int64_t value =
+                _predict(base, dx, dy, int(x) - ax, int(y) - ay) + residual;
+            out[y * pitch + x] = uint32_t(
+                std::min(std::max(value, int64_t(0)), int64_t(_maxDepth)));
+        }
+    }
+}
+}
+
+CompressorDepth::CompressorDepth(const unsigned shift)
+    : Compressor()
+    , _shift(shift)
+{
+}
+
+void* CompressorDepth::getNewCompressor(const unsigned name)
+{
+    switch (name)
+    {
+    case EQ_COMPRESSOR_DEPTH_PREDICT_8:
+        return new CompressorDepth(8);
+    case EQ_COMPRESSOR_DEPTH_PREDICT_16:
+        return new CompressorDepth(16);
+    default:
+        LBASSERT(name == EQ_COMPRESSOR_DEPTH_PREDICT);
+        return new CompressorDepth(0);
+    }
+}
+
+void CompressorDepth::compress2D(const void* const inData,
+                                 const eq_uint64_t inDims[4],
+                                 const eq_uint64_t flags LB_UNUSED)
+{
+    LBASSERT(flags & EQ_COMPRESSOR_DATA_2D);
+    const uint32_t width = uint32_t(inDims[1]);
+    const uint32_t height = uint32_t(inDims[3]);
+    const int nBands = int((height + _bandHeight - 1) / _bandHeight);
+    const size_t nBlocksX = (width + _blockSize - 1) / _blockSize;
+
+    _nResults = unsigned(nBands);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+
+    const uint32_t* const in = reinterpret_cast<const uint32_t*>(inData);
+#pragma omp parallel for
+    for (int band = 0; band < nBands; ++band)
+    {
+        const uint32_t yStart = uint32_t(band) * _bandHeight;
+        const uint32_t bandHeight = std::min(_bandHeight, height - yStart);
+        const size_t nBlocksY = (bandHeight + _blockSize - 1) / _blockSize;
+
+        Result& result = *_results[band];
+        result.reserve(_headerSize + nBlocksX * nBlocksY * _maxBlockSize);
+        uint8_t* const start = result.getData();
+        uint8_t* out = start;
+
+        *out++ = _version;
+        *out++ = uint8_t(_shift);
+        _write(out, uint16_t(0));
+        _write(out, width);
+        _write(out, yStart);
+        _write(out, bandHeight);
+
+        for (uint32_t y = 0; y < bandHeight; y += _blockSize)
+        {
+            const uint32_t* const row = in + size_t(yStart + y) * width;
+            const unsigned blockHeight = std::min(_blockSize, bandHeight - y);
+            for (uint32_t x = 0; x < width; x += _blockSize)
+                _compressBlock(row + x, width,
+                               std::min(_blockSize, width - x), blockHeight,
+                               _shift, out);
+        }
+        result.setSize(out - start);
+    }
+}
+
+void CompressorDepth::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes,
+                                 const unsigned nInputs, void* const outData,
+                                 const eq_uint64_t nPixels LB_UNUSED,
+                                 const bool /*useAlpha*/)
+{
+    uint32_t* const out = reinterpret_cast<uint32_t*>(outData);
+#pragma omp parallel for
+    for (int i = 0; i < int(nInputs); ++i)
+    {
+        const uint8_t* const start =
+            reinterpret_cast<const uint8_t*>(inData[i]);
+        const uint8_t* in = start;
+        if (*in != _version)
+        {
+            LBERROR << "Unsupported depth compression version " << int(*in)
+                    << std::endl;
+            continue;
+        }
+        ++in;
+        const unsigned shift = *in++;
+        in += sizeof(uint16_t);
+        const uint32_t width = _read<uint32_t>(in);
+        const uint32_t yStart = _read<uint32_t>(in);
+        const uint32_t bandHeight = _read<uint32_t>(in);
+        LBASSERT(size_t(yStart + bandHeight) * width <= nPixels);
+
+        for (uint32_t y = 0; y < bandHeight; y += _blockSize)
+        {
+            uint32_t* const row = out + size_t(yStart + y) * width;
+            const unsigned blockHeight = std::min(_blockSize, bandHeight - y);
+            for (uint32_t x = 0; x < width; x += _blockSize)
+                _decompressBlock(in, row + x, width,
+                                 std::min(_blockSize, width - x), blockHeight,
+                                 shift);
+        }
+        LBASSERTINFO(eq_uint64_t(in - start) == inSizes[i],
+                     (in - start) << " != " << inSizes[i]);
+    }
+}
+}
+}
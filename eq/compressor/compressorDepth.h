@@ -0,0 +1,72 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORDEPTH
+#define EQ_PLUGIN_COMPRESSORDEPTH
+
+#include "compressor.h"
+
+/** Lossless plane-predicting compressor for 32 bit depth. */
+#define EQ_COMPRESSOR_DEPTH_PREDICT (EQ_COMPRESSOR_PRIVATE + 0x101u)
+/** Plane-predicting depth compressor with an error of at most 2^7. */
+#define EQ_COMPRESSOR_DEPTH_PREDICT_8 (EQ_COMPRESSOR_PRIVATE + 0x102u)
+/** Plane-predicting depth compressor with an error of at most 2^15. */
+#define EQ_COMPRESSOR_DEPTH_PREDICT_16 (EQ_COMPRESSOR_PRIVATE + 0x103u)
+
+namespace eq
+{
+namespace plugin
+{
+/**
+ * CPU compressor for EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT images.
+ *
+ * The image is compressed in 8x8 pixel blocks. Background pixels, which have
+ * the far depth value, are stored as a mask. The foreground of each block is
+ * predicted by a plane, and the residuals to the plane are bit-packed with the
+ * number of bits needed by the largest residual in the block. The lossy
+ * variants quantize the residuals, which bounds the error per pixel. The
+ * background is always lossless.
+ */
+class CompressorDepth : public Compressor
+{
+public:
+    /** Construct a new compressor dropping the given number of bits. */
+    explicit CompressorDepth(unsigned shift);
+    virtual ~CompressorDepth() {}
+
+    static void* getNewCompressor(const unsigned name);
+    static void* getNewDecompressor(const unsigned) { return 0; }
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned numInputs, void* const outData,
+                           const eq_uint64_t nPixels, const bool useAlpha);
+    static bool isCompatible(const GLEWContext*) { return true; }
+
+    void compress(const void* const, const eq_uint64_t, const bool) override
+    {
+        LBDONTCALL;
+    }
+
+    void compress2D(const void* const inData, const eq_uint64_t inDims[4],
+                    const eq_uint64_t flags) override;
+
+private:
+    const unsigned _shift;
+};
+}
+}
+
+#endif // EQ_PLUGIN_COMPRESSORDEPTH
@@ -108,6 +108,8 @@ CompressorReadDrawPixels::CompressorReadDrawPixels(const unsigned name)
     : Compressor()
     , _texture(0)
     , _pbo(0)
+    , _fence(0)
+    , _glewContext(0)
     , _internalFormat(0)
     , _format(0)
     , _type(0)
@@ -273,6 +275,11 @@ CompressorReadDrawPixels::~CompressorReadDrawPixels()
     delete _texture;
     _texture = 0;
 
+    const GLEWContext* glewContext = _glewContext;
+    if (_fence && glewContext)
+        glDeleteSync(_fence);
+    _fence = 0;
+
     if (_pbo)
     {
         _pbo->destroy();
@@ -457,6 +464,40 @@ bool CompressorReadDrawPixels::_initPBO(const GLEWContext* glewContext,
     return false;
 }
 
+void CompressorReadDrawPixels::_waitPBO(const GLEWContext* glewContext)
+{
+    if (!_fence)
+        return;
+
+    // Wait for the readback without holding the mapping lock; mapping an
+    // unfinished PBO would stall in the driver instead.
+    const GLuint64 timeout = 1000000000ull; // 1s
+    const unsigned maxWaits = 10;
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    for (unsigned i = 0; i < maxWaits && status == GL_TIMEOUT_EXPIRED; ++i)
+        status = glClientWaitSync(_fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+
+    switch (status)
+    {
+    case GL_WAIT_FAILED:
+        // the fence is unusable, wait for all commands instead
+        EQ_GL_ERROR("glClientWaitSync");
+        glFinish();
+        break;
+
+    case GL_TIMEOUT_EXPIRED:
+        LBERROR << "PBO readback not finished after " << maxWaits
+                << " s, GPU not responding" << std::endl;
+        break;
+
+    default:
+        break;
+    }
+
+    glDeleteSync(_fence);
+    _fence = 0;
+}
+
 void CompressorReadDrawPixels::startDownload(const GLEWContext* glewContext,
                                              const eq_uint64_t dims[4],
                                              const unsigned source,
@@ -483,6 +524,9 @@ void CompressorReadDrawPixels::startDownload(const GLEWContext* glewContext,
             EQ_GL_CALL(glReadPixels(dims[0], dims[2], dims[1], dims[3], _format,
                                     _type, 0));
             _pbo->unbind();
+            if (GLEW_ARB_sync)
+                _fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            _glewContext = glewContext;
             glFlush(); // Fixes https://github.com/Eyescale/Equalizer/issues/118
             return;
         }
@@ -539,6 +583,8 @@ void CompressorReadDrawPixels::finishDownload(const GLEWContext* glewContext,
 
     if (_pbo && _pbo->isInitialized())
     {
+        _waitPBO(glewContext);
+
         const eq_uint64_t size = inDims[1] * inDims[3] * _depth;
         _resizeBuffer(size);
 
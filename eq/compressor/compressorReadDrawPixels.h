@@ -72,16 +72,19 @@ protected:
     lunchbox::Bufferb _buffer;
     util::Texture* _texture;
     util::PixelBufferObject* _pbo;
-    unsigned _internalFormat; //!< the GL format
-    unsigned _format;         //!< the GL format
-    unsigned _type;           //!< the GL type
-    const unsigned _depth;    //!< the size of one output token
+    GLsync _fence;                   //!< of the pending PBO download
+    const GLEWContext* _glewContext; //!< of the last download, for cleanup
+    unsigned _internalFormat;        //!< the GL format
+    unsigned _format;                //!< the GL format
+    unsigned _type;                  //!< the GL type
+    const unsigned _depth;           //!< the size of one output token
 
     void _resizeBuffer(const eq_uint64_t);
     void _initTexture(const GLEWContext*, const eq_uint64_t);
     void _initAsyncTexture(const GLEWContext*, const eq_uint64_t,
                            const eq_uint64_t);
     bool _initPBO(const GLEWContext*, const eq_uint64_t);
+    void _waitPBO(const GLEWContext*);
     void _initDownload(const GLEWContext*, const eq_uint64_t*, eq_uint64_t*);
     void* _downloadTexture(const GLEWContext* glewContext,
                            const FlushMode mode);
@@ -0,0 +1,313 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorYUV420.h"
+
+#include <lunchbox/buffer.h>
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <cstring>
+
+// Stream format, one result per band of up to _bandHeight rows:
+//   header: version u8, flags u8, reserved u16, width u32, y u32, height u32
+//   Y plane, width * height bytes
+//   U and V planes, (width + 1) / 2 * (height + 1) / 2 bytes each
+//   A plane, width * height bytes, if _flagAlpha is set
+//
+// The color conversion is the full range BT.601 transform used by JPEG, in
+// 8.8 fixed point. Chroma is the plain average of each 2x2 block. The per-row
+// loops have a fixed trip count and no data-dependent branches or divisions.
+// The compiler vectorizes the encoder loops, the interleaved stores of the
+// decoder stay scalar.
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+const uint8_t _version = 1;
+const unsigned _bandHeight = 64;
+const size_t _headerSize = 16;
+
+enum Flags
+{
+    _flagAlpha = 0x1,
+    _flagBGRA = 0x2
+};
+
+template <unsigned name>
+void _getInfo(EqCompressorInfo* const info);
+
+void _fillInfo(EqCompressorInfo* const info)
+{
+    info->version = EQ_COMPRESSOR_VERSION;
+    info->capabilities = EQ_COMPRESSOR_DATA_2D | EQ_COMPRESSOR_IGNORE_ALPHA;
+    info->outputTokenSize = 4;
+    info->quality = .9f;
+    info->ratio = .5f;
+    info->speed = .8f;
+}
+
+template <>
+void _getInfo<EQ_COMPRESSOR_YUV420_RGBA>(EqCompressorInfo* const info)
+{
+    _fillInfo(info);
+    info->name = EQ_COMPRESSOR_YUV420_RGBA;
+    info->tokenType = EQ_COMPRESSOR_DATATYPE_RGBA;
+    info->outputTokenType = EQ_COMPRESSOR_DATATYPE_RGBA;
+}
+
+template <>
+void _getInfo<EQ_COMPRESSOR_YUV420_BGRA>(EqCompressorInfo* const info)
+{
+    _fillInfo(info);
+    info->name = EQ_COMPRESSOR_YUV420_BGRA;
+    info->tokenType = EQ_COMPRESSOR_DATATYPE_BGRA;
+    info->outputTokenType = EQ_COMPRESSOR_DATATYPE_BGRA;
+}
+
+template <unsigned name>
+bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions(name, _getInfo<name>,
+                              CompressorYUV420::getNewCompressor,
+                              CompressorYUV420::getNewDecompressor,
+                              CompressorYUV420::decompress,
+                              CompressorYUV420::isCompatible));
+    return true;
+}
+
+static bool _initialized LB_UNUSED = _register<EQ_COMPRESSOR_YUV420_RGBA>() &&
+                                     _register<EQ_COMPRESSOR_YUV420_BGRA>();
+
+template <class T>
+inline void _write(uint8_t*& out, const T value)
+{
+    ::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+template <class T>
+inline T _read(const uint8_t*& in)
+{
+    T value;
+    ::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+}
+
+inline uint8_t _clamp(const int value)
+{
+    return uint8_t(std::min(std::max(value, 0), 255));
+}
+
+/** Convert one row of pixels to luma and, optionally, alpha. */
+void _encodeLuma(const uint8_t* const in, const unsigned width,
+                 const unsigned r, uint8_t* const y, uint8_t* const alpha)
+{
+    const unsigned b = 2 - r;
+    for (unsigned x = 0; x < width; ++x)
+    {
+        const uint8_t* pixel = in + x * 4;
+        y[x] = uint8_t((77 * pixel[r] + 150 * pixel[1] + 29 * pixel[b] + 128) >>
+                       8);
+    }
+    if (alpha)
+        for (unsigned x = 0; x < width; ++x)
+            alpha[x] = in[x * 4 + 3];
+}
+
+/** Convert the chroma of a 2x2 block, given by the sums of its samples. */
+inline void _encodeBlock(const int sumR, const int sumG, const int sumB,
+                         uint8_t& u, uint8_t& v)
+{
+    // the sums are four times the average, which the shift by 10 removes
+    u = _clamp(((-43 * sumR - 85 * sumG + 128 * sumB + 512) >> 10) + 128);
+    v = _clamp(((128 * sumR - 107 * sumG - 21 * sumB + 512) >> 10) + 128);
+}
+
+/** Average the chroma of the 2x2 blocks of two rows. */
+void _encodeChroma(const uint8_t* const row0, const uint8_t* const row1,
+                   const unsigned width, const unsigned r, uint8_t* const u,
+                   uint8_t* const v)
+{
+    const unsigned b = 2 - r;
+    const unsigned nBlocks = width / 2;
+    for (unsigned cx = 0; cx < nBlocks; ++cx)
+    {
+        const uint8_t* const p0 = row0 + cx * 8;
+        const uint8_t* const p1 = row1 + cx * 8;
+        _encodeBlock(p0[r] + p0[r + 4] + p1[r] + p1[r + 4],
+                     p0[1] + p0[5] + p1[1] + p1[5],
+                     p0[b] + p0[b + 4] + p1[b] + p1[b + 4], u[cx], v[cx]);
+    }
+
+    // the last column of an odd width is a block of its own
+    if (width % 2)
+    {
+        const uint8_t* const p0 = row0 + nBlocks * 8;
+        const uint8_t* const p1 = row1 + nBlocks * 8;
+        _encodeBlock(2 * (p0[r] + p1[r]), 2 * (p0[1] + p1[1]),
+                     2 * (p0[b] + p1[b]), u[nBlocks], v[nBlocks]);
+    }
+}
+
+/** Convert one row of luma, chroma and alpha back to pixels. */
+void _decodeRow(const uint8_t* const y, const uint8_t* const u,
+                const uint8_t* const v, const uint8_t* const alpha,
+                const unsigned width, const unsigned r, uint8_t* const out)
+{
+    const unsigned b = 2 - r;
+    for (unsigned x = 0; x < width; ++x)
+    {
+        const int luma = y[x];
+        const int cb = int(u[x / 2]) - 128;
+        const int cr = int(v[x / 2]) - 128;
+        uint8_t* const pixel = out + x * 4;
+        pixel[r] = _clamp(luma + ((359 * cr + 128) >> 8));
+        pixel[1] = _clamp(luma + ((-88 * cb - 183 * cr + 128) >> 8));
+        pixel[b] = _clamp(luma + ((454 * cb + 128) >> 8));
+    }
+    if (alpha)
+        for (unsigned x = 0; x < width; ++x)
+            out[x * 4 + 3] = alpha[x];
+    else
+        for (unsigned x = 0; x < width; ++x)
+            out[x * 4 + 3] = 255;
+}
+}
+
+CompressorYUV420::CompressorYUV420(const bool bgra)
+    : Compressor()
+    , _bgra(bgra)
+{
+}
+
+void* CompressorYUV420::getNewCompressor(const unsigned name)
+{
+    LBASSERT(name == EQ_COMPRESSOR_YUV420_RGBA ||
+             name == EQ_COMPRESSOR_YUV420_BGRA);
+    return new CompressorYUV420(name == EQ_COMPRESSOR_YUV420_BGRA);
+}
+
+void CompressorYUV420::compress2D(const void* const inData,
+                                  const eq_uint64_t inDims[4],
+                                  const eq_uint64_t flags)
+{
+    LBASSERT(flags & EQ_COMPRESSOR_DATA_2D);
+    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    const uint32_t width = uint32_t(inDims[1]);
+    const uint32_t height = uint32_t(inDims[3]);
+    const uint32_t cWidth = (width + 1) / 2;
+    const int nBands = int((height + _bandHeight - 1) / _bandHeight);
+    const unsigned r = _bgra ? 2 : 0;
+
+    _nResults = unsigned(nBands);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+
+    const uint8_t* const in = reinterpret_cast<const uint8_t*>(inData);
+#pragma omp parallel for
+    for (int band = 0; band < nBands; ++band)
+    {
+        const uint32_t yStart = uint32_t(band) * _bandHeight;
+        const uint32_t bandHeight = std::min(_bandHeight, height - yStart);
+        const size_t nPixels = size_t(width) * bandHeight;
+        const size_t nChroma = size_t(cWidth) * ((bandHeight + 1) / 2);
+
+        Result& result = *_results[band];
+        const size_t size =
+            _headerSize + nPixels + 2 * nChroma + (useAlpha ? nPixels : 0);
+        result.reserve(size);
+        result.setSize(size);
+
+        uint8_t* out = result.getData();
+        *out++ = _version;
+        *out++ = uint8_t((useAlpha ? _flagAlpha : 0) | (_bgra ? _flagBGRA : 0));
+        _write(out, uint16_t(0));
+        _write(out, width);
+        _write(out, yStart);
+        _write(out, bandHeight);
+
+        uint8_t* const luma = out;
+        uint8_t* const u = luma + nPixels;
+        uint8_t* const v = u + nChroma;
+        uint8_t* const alpha = useAlpha ? v + nChroma : 0;
+        const size_t pitch = size_t(width) * 4;
+
+        for (uint32_t y = 0; y < bandHeight; ++y)
+        {
+            const uint8_t* const row = in + (yStart + y) * pitch;
+            _encodeLuma(row, width, r, luma + y * width,
+                        alpha ? alpha + y * width : 0);
+            if (y % 2 == 0)
+            {
+                const uint32_t y1 = std::min(y + 1, bandHeight - 1);
+                _encodeChroma(row, in + (yStart + y1) * pitch, width, r,
+                              u + y / 2 * cWidth, v + y / 2 * cWidth);
+            }
+        }
+    }
+}
+
+void CompressorYUV420::decompress(const void* const* inData,
+                                  const eq_uint64_t* const inSizes LB_UNUSED,
+                                  const unsigned nInputs, void* const outData,
+                                  const eq_uint64_t nPixels LB_UNUSED,
+                                  const bool /*useAlpha*/)
+{
+    uint8_t* const out = reinterpret_cast<uint8_t*>(outData);
+#pragma omp parallel for
+    for (int i = 0; i < int(nInputs); ++i)
+    {
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(inData[i]);
+        if (*in != _version)
+        {
+            LBERROR << "Unsupported YUV 4:2:0 compression version "
+                    << int(*in) << std::endl;
+            continue;
+        }
+        ++in;
+        const uint8_t flags = *in++;
+        in += sizeof(uint16_t);
+        const uint32_t width = _read<uint32_t>(in);
+        const uint32_t yStart = _read<uint32_t>(in);
+        const uint32_t bandHeight = _read<uint32_t>(in);
+        LBASSERT(size_t(yStart + bandHeight) * width <= nPixels);
+
+        const uint32_t cWidth = (width + 1) / 2;
+        const size_t nBandPixels = size_t(width) * bandHeight;
+        const size_t nChroma = size_t(cWidth) * ((bandHeight + 1) / 2);
+        LBASSERT(inSizes[i] == _headerSize + nBandPixels + 2 * nChroma +
+                                   (flags & _flagAlpha ? nBandPixels : 0));
+
+        const uint8_t* const luma = in;
+        const uint8_t* const u = luma + nBandPixels;
+        const uint8_t* const v = u + nChroma;
+        const uint8_t* const alpha = (flags & _flagAlpha) ? v + nChroma : 0;
+        const unsigned r = (flags & _flagBGRA) ? 2 : 0;
+
+        for (uint32_t y = 0; y < bandHeight; ++y)
+            _decodeRow(luma + y * width, u + y / 2 * cWidth,
+                       v + y / 2 * cWidth, alpha ? alpha + y * width : 0,
+                       width, r, out + size_t(yStart + y) * width * 4);
+    }
+}
+}
+}
@@ -0,0 +1,68 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORYUV420
+#define EQ_PLUGIN_COMPRESSORYUV420
+
+#include "compressor.h"
+
+/** CPU YUV 4:2:0 compressor for RGBA images. */
+#define EQ_COMPRESSOR_YUV420_RGBA (EQ_COMPRESSOR_PRIVATE + 0x104u)
+/** CPU YUV 4:2:0 compressor for BGRA images. */
+#define EQ_COMPRESSOR_YUV420_BGRA (EQ_COMPRESSOR_PRIVATE + 0x105u)
+
+namespace eq
+{
+namespace plugin
+{
+/**
+ * CPU compressor subsampling the chroma of 8 bit color images.
+ *
+ * This is the main memory counterpart of CompressorYUV, for images which are
+ * not downloaded from the GPU, e.g., when they are recomposited and sent
+ * again. Luma is kept for each pixel, chroma is averaged over each 2x2
+ * block, and alpha, if used, is kept for each pixel.
+ */
+class CompressorYUV420 : public Compressor
+{
+public:
+    /** Construct a new compressor for RGBA or BGRA tokens. */
+    explicit CompressorYUV420(bool bgra);
+    virtual ~CompressorYUV420() {}
+
+    static void* getNewCompressor(const unsigned name);
+    static void* getNewDecompressor(const unsigned) { return 0; }
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned numInputs, void* const outData,
+                           const eq_uint64_t nPixels, const bool useAlpha);
+    static bool isCompatible(const GLEWContext*) { return true; }
+
+    void compress(const void* const, const eq_uint64_t, const bool) override
+    {
+        LBDONTCALL;
+    }
+
+    void compress2D(const void* const inData, const eq_uint64_t inDims[4],
+                    const eq_uint64_t flags) override;
+
+private:
+    const bool _bgra;
+};
+}
+}
+
+#endif // EQ_PLUGIN_COMPRESSORYUV420
@@ -23,6 +23,8 @@
 #include "channel.h"
 #include "client.h"
 #include "configStatistics.h"
+#include "detail/eventCoalescer.h"
+#include "detail/framePacer.h"
 #include "eventICommand.h"
 #include "global.h"
 #include "layout.h"
@@ -51,6 +53,7 @@
 #include <lunchbox/clock.h>
 #include <lunchbox/monitor.h>
 #include <lunchbox/scopedMutex.h>
+#include <lunchbox/sleep.h>
 #include <lunchbox/spinLock.h>
 #include <pression/data/CompressorInfo.h>
 #include <pression/plugins/compressor.h>
@@ -101,6 +104,27 @@ private:
     const ChangeType _changeType;
     const co::CompressorInfo _compressor;
 };
+
+typedef std::pair<uint32_t, uint128_t> ResizeKey;
+
+/** @return the type and originator of a resize event, EVENT_UNKNOWN if not. */
+ResizeKey _getResizeKey(const co::ICommand& command)
+{
+    if (!command.isValid())
+        return ResizeKey(EVENT_UNKNOWN, 0);
+
+    EventICommand event(command);
+    const uint32_t type = event.getEventType();
+    switch (type)
+    {
+    case EVENT_WINDOW_RESIZE:
+    case EVENT_CHANNEL_RESIZE:
+    case EVENT_VIEW_RESIZE:
+        return ResizeKey(type, event.read<SizeEvent>().originator);
+    default:
+        return ResizeKey(EVENT_UNKNOWN, 0);
+    }
+}
 #ifdef EQUALIZER_USE_GLSTATS
 namespace
 {
@@ -124,6 +148,7 @@ public:
         , currentFrame(0)
         , unlockedFrame(0)
         , finishedFrame(0)
+        , framePacing(false)
         , running(false)
     {
         lunchbox::Log::setClock(&clock);
@@ -144,6 +169,9 @@ public:
     /** The last received event to be released. */
     co::ICommand lastEvent;
 
+    /** The event popped from eventQueue after a coalesced resize event. */
+    co::ICommand nextEvent;
+
     /** The connections configured by the server for this config. */
     co::Connections connections;
 
@@ -164,6 +192,10 @@ public:
 
     std::deque<int64_t> frameTimes; //!< Start time of last frames
 
+    /** Just-in-time frame start, see setFramePacing() */
+    bool framePacing;
+    FramePacer framePacer;
+
     /** list of the current latency object */
     typedef std::vector<LatencyObject*> LatencyObjects;
 
@@ -358,7 +390,9 @@ bool Config::exit()
         ret = false;
     }
     _impl->lastEvent.clear();
+    _impl->nextEvent.clear();
     _impl->eventQueue.flush();
+    detail::EventCoalescer::clear(); // events of non-threaded pipes
     _impl->running = false;
     return ret;
 }
@@ -410,6 +444,14 @@ bool Config::update()
 
 uint32_t Config::startFrame(const uint128_t& frameID)
 {
+    if (_impl->framePacing)
+    {
+        const uint32_t delay = _impl->framePacer.getDelay();
+        if (delay > 0)
+            lunchbox::sleep(delay);
+        _impl->framePacer.startFrame(_impl->currentFrame + 1, getTime());
+    }
+
     // Update
     ConfigStatistics stat(Statistic::CONFIG_START_FRAME, this);
     detail::FrameVisitor visitor(_impl->currentFrame + 1);
@@ -490,6 +532,8 @@ uint32_t Config::finishFrame()
     }
 
     handleEvents();
+    if (_impl->framePacing)
+        _impl->framePacer.finishFrame(frameToFinish, getTime());
     _updateStatistics();
     _releaseObjects();
 
@@ -527,6 +571,17 @@ void Config::stopFrames()
     send(getServer(), fabric::CMD_CONFIG_STOP_FRAMES);
 }
 
+void Config::setFramePacing(const bool enable)
+{
+    _impl->framePacing = enable;
+    _impl->framePacer = detail::FramePacer();
+}
+
+bool Config::isFramePacing() const
+{
+    return _impl->framePacing;
+}
+
 namespace
 {
 class ChangeLatencyVisitor : public ConfigVisitor
@@ -601,9 +656,32 @@ Errors Config::getErrors()
 
 EventICommand Config::getNextEvent(const uint32_t timeout) const
 {
-    if (timeout == 0)
-        return _impl->eventQueue.tryPop();
-    return _impl->eventQueue.pop(timeout);
+    co::ICommand event = _impl->nextEvent;
+    if (event.isValid())
+        _impl->nextEvent.clear();
+    else if (timeout == 0)
+        event = _impl->eventQueue.tryPop();
+    else
+        event = _impl->eventQueue.pop(timeout);
+
+    // Skip resize events superseded by a queued resize of the same entity.
+    // Other coalesced events are already merged by the sender.
+    const ResizeKey& key = _getResizeKey(event);
+    if (key.first == EVENT_UNKNOWN)
+        return event;
+
+    for (;;)
+    {
+        const co::ICommand& next = _impl->eventQueue.tryPop();
+        if (!next.isValid())
+            return event;
+        if (_getResizeKey(next) != key)
+        {
+            _impl->nextEvent = next;
+            return event;
+        }
+        event = next;
+    }
 }
 
 bool Config::handleEvent(EventICommand command)
@@ -780,7 +858,7 @@ bool Config::handleEvent(const ButtonEvent&)
 
 bool Config::checkEvent() const
 {
-    return !_impl->eventQueue.isEmpty();
+    return !_impl->eventQueue.isEmpty() || _impl->nextEvent.isValid();
 }
 
 void Config::handleEvents()
@@ -799,8 +877,11 @@ void Config::handleEvents()
 #endif
 }
 
-void Config::addStatistic(const Statistic& stat LB_UNUSED)
+void Config::addStatistic(const Statistic& stat)
 {
+    if (_impl->framePacing)
+        _impl->framePacer.addStatistic(stat);
+
 #ifdef EQUALIZER_USE_GLSTATS
     const uint32_t frame = stat.frameNumber;
     LBASSERT(stat.type != Statistic::NONE);
@@ -809,7 +890,7 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     if (frame == 0 || stat.type == Statistic::NONE)
         return;
 
-    lunchbox::ScopedFastWrite mutex(_impl->statistics);
+    // build the item first, and lock only to insert it
     GLStats::Item item;
     item.entity = stat.serial;
     item.type = stat.type;
@@ -847,6 +928,9 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     case Statistic::CHANNEL_VIEW_FINISH:
         type.group = "channel";
         break;
+    case Statistic::CHANNEL_READBACK_WAIT:
+        item.layer = 1;
+    // falls through
     case Statistic::CHANNEL_ASYNC_READBACK:
         type.group = "channel";
         type.subgroup = "transfer";
@@ -878,7 +962,8 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
 
     case Statistic::PIPE_IDLE:
     {
-        const std::string& string = _impl->statistics->getText();
+        lunchbox::ScopedFastWrite mutex(_impl->statistics);
+        const std::string string = _impl->statistics->getText();
         const float idle = stat.idleTime * 100ll / stat.totalTime;
         std::stringstream text;
         if (string.empty())
@@ -903,6 +988,7 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     // falls through
 
     case Statistic::WINDOW_FPS:
+    case Statistic::VIEW_FPS:
     case Statistic::NONE:
     case Statistic::ALL:
         return;
@@ -930,6 +1016,7 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
         break;
     }
 
+    lunchbox::ScopedFastWrite mutex(_impl->statistics);
     _impl->statistics->setType(stat.type, type);
     _impl->statistics->setEntity(item.entity, entity);
     _impl->statistics->addItem(item);
@@ -334,6 +334,25 @@ public:
      */
     EQ_API void stopFrames();
 
+    /**
+     * Enable or disable just-in-time frame pacing.
+     *
+     * When enabled, startFrame() delays the start of a new frame by the idle
+     * time of the recent frames, so that per-frame data such as the observer
+     * head matrix is sampled as late as possible. The idle time is estimated
+     * from the interval between finished frames and the channel and window
+     * statistics received by the application. Without statistics, frames are
+     * not delayed.
+     *
+     * @param enable true to enable frame pacing, false to disable it.
+     * @sa Observer::latchHeadMatrix()
+     * @version 2.2
+     */
+    EQ_API void setFramePacing(bool enable);
+
+    /** @return true if frame pacing is enabled. @version 2.2 */
+    EQ_API bool isFramePacing() const;
+
     //@}
 
     /** @name Event handling */
@@ -373,6 +392,9 @@ public:
      * The returned event command is valid until it gets out of scope. This
      * method does not block if the given timeout is 0. Not thread safe.
      *
+     * Resize events superseded by an already received resize of the same
+     * entity are skipped.
+     *
      * @param timeout time in ms to wait for incoming events
      * @return the event command, or an invalid command on timeout
      * @version 1.5.1
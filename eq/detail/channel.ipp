@@ -21,6 +21,7 @@
 #include "../image.h"
 #include "../resultImageListener.h"
 #include "fileFrameWriter.h"
+#include "statisticsCollector.h"
 
 #ifdef EQUALIZER_USE_DEFLECT
 #include "../deflect/proxy.h"
@@ -54,7 +55,6 @@ public:
         color.b() = rng.get<uint8_t>();
     }
 
-    ~Channel() { statistics->clear(); }
     void addResultImageListener(ResultImageListener* listener)
     {
         LBASSERT(std::find(resultImageListeners.begin(),
@@ -154,20 +154,25 @@ public:
     /** A random, unique color for this channel. */
     Vector3ub color;
 
-    typedef std::vector<Statistic> Statistics;
     struct FrameStatistics
     {
-        Statistics data;     //!< all events for one frame
-        eq::Viewport region; //!< from draw for equalizers
+        StatisticsCollector events; //!< all events for one frame
+        eq::Viewport region;        //!< from draw for equalizers
         /** reference count by pipe and transmit thread */
         lunchbox::a_int32_t used;
     };
 
-    typedef std::vector<FrameStatistics> StatisticsRB;
-    typedef StatisticsRB::const_iterator StatisticsRBCIter;
+    typedef std::unique_ptr<FrameStatistics> FrameStatisticsPtr;
+    typedef std::vector<FrameStatisticsPtr> StatisticsRB;
 
     /** Global statistics events, index per frame and channel. */
-    lunchbox::Lockable<StatisticsRB, lunchbox::SpinLock> statistics;
+    StatisticsRB statistics;
+
+    FrameStatistics& getStatistics(const uint32_t frameNumber)
+    {
+        LBASSERT(!statistics.empty());
+        return *statistics[frameNumber % statistics.size()];
+    }
 
     /** The initial channel size, used for view resize events. */
     Vector2i initialSize;
@@ -179,6 +184,9 @@ public:
     /** The number of the last finished frame. */
     lunchbox::Monitor<uint32_t> finishedFrame;
 
+    /** The number of readbacks pending on the transfer thread. */
+    lunchbox::Monitor<uint32_t> pendingReadbacks;
+
     /** Listeners that get notified on each new rendered image */
     typedef std::vector<ResultImageListener*> ResultImageListeners;
     ResultImageListeners resultImageListeners;
@@ -0,0 +1,225 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "eventCoalescer.h"
+
+#include "../config.h"
+
+#include <eq/fabric/axisEvent.h>
+#include <eq/fabric/eventOCommand.h>
+#include <eq/fabric/pointerEvent.h>
+#include <eq/fabric/sizeEvent.h>
+
+#include <co/objectOCommand.h>
+#include <lunchbox/perThread.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+struct Pending
+{
+    Pending(const Window* window_, Config* config_, const EventType type_,
+            const uint128_t& originator_)
+        : window(window_)
+        , config(config_)
+        , type(type_)
+        , originator(originator_)
+    {
+    }
+
+    const Window* window;
+    Config* config;
+    EventType type;
+    uint128_t originator;
+    PointerEvent pointer;
+    SizeEvent size;
+    AxisEvent axis;
+};
+
+typedef std::vector<Pending> Pendings;
+static lunchbox::PerThread<Pendings> _pendings;
+
+/** @return the pending event to merge the given event into, or 0. */
+Pending* _find(const Window* window, Config* config, const EventType type,
+               const uint128_t& originator)
+{
+    if (!_pendings)
+        _pendings = new Pendings;
+
+    for (Pending& pending : *_pendings)
+        if (pending.window == window && pending.type == type &&
+            pending.originator == originator && pending.config == config)
+        {
+            return &pending;
+        }
+    return 0;
+}
+
+Pending& _add(const Window* window, Config* config, const EventType type,
+              const uint128_t& originator)
+{
+    _pendings->push_back(Pending(window, config, type, originator));
+    return _pendings->back();
+}
+
+void _send(const Pendings& pendings)
+{
+    for (const Pending& pending : pendings)
+    {
+        switch (pending.type)
+        {
+        case EVENT_WINDOW_RESIZE:
+        case EVENT_CHANNEL_RESIZE:
+        case EVENT_VIEW_RESIZE:
+            pending.config->sendEvent(pending.type) << pending.size;
+            break;
+        case EVENT_MAGELLAN_AXIS:
+            pending.config->sendEvent(pending.type) << pending.axis;
+            break;
+        default:
+            pending.config->sendEvent(pending.type) << pending.pointer;
+            break;
+        }
+    }
+}
+
+/** Move the events held for the given window out of the thread's list. */
+Pendings _take(const Window* window)
+{
+    Pendings taken;
+    if (!_pendings)
+        return taken;
+
+    Pendings& pendings = *_pendings;
+    Pendings::iterator end = std::stable_partition(
+        pendings.begin(), pendings.end(),
+        [window](const Pending& pending) { return pending.window != window; });
+    taken.assign(end, pendings.end());
+    pendings.erase(end, pendings.end());
+    return taken;
+}
+}
+
+bool EventCoalescer::isCoalesced(const uint32_t type)
+{
+    switch (type)
+    {
+    case EVENT_WINDOW_RESIZE:
+    case EVENT_CHANNEL_RESIZE:
+    case EVENT_VIEW_RESIZE:
+    case EVENT_CHANNEL_POINTER_MOTION:
+    case EVENT_CHANNEL_POINTER_WHEEL:
+    case EVENT_WINDOW_POINTER_MOTION:
+    case EVENT_WINDOW_POINTER_WHEEL:
+    case EVENT_MAGELLAN_AXIS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void EventCoalescer::add(const Window* window, Config* config,
+                         const EventType type, const PointerEvent& event)
+{
+    LBASSERT(isCoalesced(type));
+    Pending* pending = _find(window, config, type, event.originator);
+    if (!pending)
+    {
+        _add(window, config, type, event.originator).pointer = event;
+        return;
+    }
+
+    PointerEvent merged = event;
+    merged.dx += pending->pointer.dx;
+    merged.dy += pending->pointer.dy;
+    merged.xAxis += pending->pointer.xAxis;
+    merged.yAxis += pending->pointer.yAxis;
+    pending->pointer = merged;
+}
+
+void EventCoalescer::add(const Window* window, Config* config,
+                         const EventType type, const SizeEvent& event)
+{
+    LBASSERT(isCoalesced(type));
+    Pending* pending = _find(window, config, type, event.originator);
+    if (pending)
+        pending->size = event;
+    else
+        _add(window, config, type, event.originator).size = event;
+}
+
+void EventCoalescer::add(const Window* window, Config* config,
+                         const AxisEvent& event)
+{
+    Pending* pending =
+        _find(window, config, EVENT_MAGELLAN_AXIS, event.originator);
+    if (!pending)
+    {
+        _add(window, config, EVENT_MAGELLAN_AXIS, event.originator).axis =
+            event;
+        return;
+    }
+
+    AxisEvent merged = event;
+    merged.xAxis += pending->axis.xAxis;
+    merged.yAxis += pending->axis.yAxis;
+    merged.zAxis += pending->axis.zAxis;
+    merged.xRotation += pending->axis.xRotation;
+    merged.yRotation += pending->axis.yRotation;
+    merged.zRotation += pending->axis.zRotation;
+    pending->axis = merged;
+}
+
+EventOCommand EventCoalescer::send(const Window* window, Config* config,
+                                   const uint32_t type)
+{
+    flush(window);
+    return config->sendEvent(type);
+}
+
+void EventCoalescer::flush(const Window* window)
+{
+    _send(_take(window));
+}
+
+void EventCoalescer::flush()
+{
+    if (!_pendings || _pendings->empty())
+        return;
+
+    Pendings pendings;
+    pendings.swap(*_pendings);
+    _send(pendings);
+}
+
+void EventCoalescer::clear(const Window* window)
+{
+    _take(window);
+}
+
+void EventCoalescer::clear()
+{
+    if (_pendings)
+        _pendings->clear();
+}
+}
+}
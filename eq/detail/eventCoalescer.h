@@ -0,0 +1,75 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_EVENTCOALESCER_H
+#define EQ_DETAIL_EVENTCOALESCER_H
+
+#include <eq/types.h>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Coalesces high-frequency events before they are sent to the application.
+ *
+ * Pointer motion, pointer wheel, resize and axis events are held back per
+ * window, node-level axis events under a null window. A held event is merged
+ * with later events of the same type and originator: motion deltas and wheel
+ * and axis values are summed, all other fields are taken from the latest
+ * event. The events held for a window are sent before any other input event of
+ * that window, which keeps button and key events ordered, after each batch of
+ * window system events dispatched by the command queue, and at the end of each
+ * frame. Held events live in the thread processing the window's events.
+ */
+class EventCoalescer
+{
+public:
+    /** @return true if events of the given type are coalesced. */
+    static bool isCoalesced(uint32_t type);
+
+    /** Hold back or merge a pointer motion or wheel event. */
+    static void add(const Window* window, Config* config, EventType type,
+                    const PointerEvent& event);
+
+    /** Hold back or merge a resize event. */
+    static void add(const Window* window, Config* config, EventType type,
+                    const SizeEvent& event);
+
+    /** Hold back or merge an axis event. */
+    static void add(const Window* window, Config* config,
+                    const AxisEvent& event);
+
+    /** Send the events held back for the window, then start a new event. */
+    static EventOCommand send(const Window* window, Config* config,
+                              uint32_t type);
+
+    /** Send all events held back for the given window. */
+    static void flush(const Window* window);
+
+    /** Send all events held back by the calling thread. */
+    static void flush();
+
+    /** Drop all events held back for the given window. */
+    static void clear(const Window* window);
+
+    /** Drop all events held back by the calling thread. */
+    static void clear();
+};
+}
+}
+
+#endif // EQ_DETAIL_EVENTCOALESCER_H
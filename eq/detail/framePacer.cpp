@@ -0,0 +1,102 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "framePacer.h"
+
+#include <eq/fabric/statistic.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+const size_t _nSamples = 32; // frames of history
+const int64_t _minMargin = 1; // ms
+}
+
+FramePacer::FramePacer()
+    : _lastFinish(0)
+{
+}
+
+void FramePacer::startFrame(const uint32_t frame, const int64_t time)
+{
+    _frames[frame] = std::make_pair(time, time);
+}
+
+void FramePacer::addStatistic(const Statistic& stat)
+{
+    switch (stat.type)
+    {
+    case Statistic::CHANNEL_CLEAR:
+    case Statistic::CHANNEL_DRAW:
+    case Statistic::CHANNEL_DRAW_FINISH:
+    case Statistic::CHANNEL_ASSEMBLE:
+    case Statistic::CHANNEL_READBACK:
+    case Statistic::CHANNEL_VIEW_FINISH:
+    case Statistic::WINDOW_FINISH:
+        break;
+    default: // waiting and asynchronous operations
+        return;
+    }
+
+    auto i = _frames.find(stat.frameNumber);
+    if (i != _frames.end())
+        i->second.second = std::max(i->second.second, stat.endTime);
+}
+
+void FramePacer::finishFrame(const uint32_t frame, const int64_t time)
+{
+    if (_lastFinish > 0)
+    {
+        _intervals.push_back(time - _lastFinish);
+        if (_intervals.size() > _nSamples)
+            _intervals.pop_front();
+    }
+    _lastFinish = time;
+
+    // statistics arrive after the frame finished, evaluate older frames
+    while (!_frames.empty() && _frames.begin()->first < frame)
+    {
+        const std::pair<int64_t, int64_t>& times = _frames.begin()->second;
+        if (times.second > times.first)
+        {
+            _renderTimes.push_back(times.second - times.first);
+            if (_renderTimes.size() > _nSamples)
+                _renderTimes.pop_front();
+        }
+        _frames.erase(_frames.begin());
+    }
+}
+
+uint32_t FramePacer::getDelay() const
+{
+    if (_intervals.empty() || _renderTimes.empty())
+        return 0;
+
+    const int64_t period =
+        *std::min_element(_intervals.begin(), _intervals.end());
+    const int64_t renderTime =
+        *std::max_element(_renderTimes.begin(), _renderTimes.end());
+    const int64_t margin = std::max(_minMargin, period / 10);
+    const int64_t idle = period - renderTime - margin;
+    return idle > 0 ? uint32_t(idle) : 0;
+}
+}
+}
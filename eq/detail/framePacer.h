@@ -0,0 +1,65 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_FRAMEPACER_H
+#define EQ_DETAIL_FRAMEPACER_H
+
+#include <eq/types.h>
+
+#include <deque>
+#include <map>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Computes the just-in-time start delay for Config::startFrame.
+ *
+ * The frame period is the shortest recent interval between finished frames,
+ * which is robust against single missed frames. The render time is the longest
+ * recent time from the start of a frame to the end of its last channel or
+ * window operation, as reported by the statistics. The delay is the remaining
+ * idle time of a frame minus a safety margin.
+ */
+class FramePacer
+{
+public:
+    FramePacer();
+
+    /** Record the start of a frame. */
+    void startFrame(uint32_t frame, int64_t time);
+
+    /** Record a channel or window statistic of a frame. */
+    void addStatistic(const Statistic& statistic);
+
+    /** Record the completion of a frame. */
+    void finishFrame(uint32_t frame, int64_t time);
+
+    /** @return the time to wait before starting the next frame, in ms. */
+    uint32_t getDelay() const;
+
+private:
+    /** Start and latest render end time per frame */
+    std::map<uint32_t, std::pair<int64_t, int64_t>> _frames;
+    std::deque<int64_t> _intervals;   //!< last intervals between finishes
+    std::deque<int64_t> _renderTimes; //!< last render times
+    int64_t _lastFinish;
+};
+}
+}
+
+#endif // EQ_DETAIL_FRAMEPACER_H
@@ -0,0 +1,80 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_FRAMEPLAN_H
+#define EQ_DETAIL_FRAMEPLAN_H
+
+#include <eq/fabric/frame.h>     // member
+#include <eq/fabric/frameData.h> // member
+
+#include <co/dataIStream.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * The parameters of one frame for one config frame, as sent by the server with
+ * the node frame start.
+ *
+ * Input frames only carry the frame parameters, output frames also carry the
+ * frame data parameters of each used eye pass.
+ */
+struct PlannedFrame
+{
+    PlannedFrame()
+        : isOutput(false)
+    {
+        for (unsigned i = 0; i < fabric::NUM_EYES; ++i)
+            hasData[i] = false;
+    }
+
+    void deserialize(co::DataIStream& is)
+    {
+        frame.deserialize(is);
+        is >> isOutput;
+        if (!isOutput)
+            return;
+
+        for (unsigned i = 0; i < fabric::NUM_EYES; ++i)
+        {
+            is >> hasData[i];
+            if (hasData[i])
+                datas[i].deserialize(is);
+        }
+    }
+
+    fabric::Frame frame;
+    bool isOutput;
+    fabric::FrameData datas[fabric::NUM_EYES];
+    bool hasData[fabric::NUM_EYES];
+};
+
+typedef std::shared_ptr<const PlannedFrame> PlannedFramePtr;
+
+/** The planned frames of one config frame, by frame identifier. */
+typedef std::unordered_map<uint128_t, PlannedFramePtr> FramePlan;
+
+/** The frame plans of all unfinished config frames, by frame number. */
+typedef std::map<uint32_t, FramePlan> FramePlans;
+}
+}
+
+#endif // EQ_DETAIL_FRAMEPLAN_H
@@ -0,0 +1,303 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "memoryPool.h"
+
+#include <eq/log.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+const size_t _minShift = 16;                  // 64 KiB smallest block
+const size_t _nSteps = 4;                     // size classes per power of two
+const size_t _nClasses = 15 * _nSteps;        // 1.75 GiB largest pooled block
+const size_t _hugePageSize = 2 * 1024 * 1024; // use huge pages above
+const uint64_t _slack = 16 * 1024 * 1024;     // cache above high-water mark
+const uint32_t _trimInterval = 64;            // frames per high-water mark
+const size_t _pageSize = 4096;
+
+/** @return the block size of a class, 1, 1.25, 1.5, 1.75 times 2^n */
+size_t _getCapacity(const size_t index)
+{
+    const size_t base = size_t(1) << (_minShift + index / _nSteps);
+    return base + base / _nSteps * (index % _nSteps);
+}
+
+const size_t _maxPooled = _getCapacity(_nClasses - 1);
+
+size_t _getClass(const size_t size)
+{
+    size_t index = 0;
+    while (_getCapacity(index) < size)
+        ++index;
+    return index;
+}
+
+size_t _getNUMANode()
+{
+#ifdef __linux__
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+void* _allocBlock(const size_t size)
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, 64);
+#else
+    if (size >= _hugePageSize)
+    {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            return nullptr;
+#ifdef MADV_HUGEPAGE
+        ::madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+        return ptr;
+    }
+
+    void* ptr = nullptr;
+    if (::posix_memalign(&ptr, 64, size) != 0)
+        return nullptr;
+    return ptr;
+#endif
+}
+
+void _freeBlock(void* ptr, const size_t size)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    if (size >= _hugePageSize)
+        ::munmap(ptr, size);
+    else
+        ::free(ptr);
+#endif
+}
+}
+
+std::shared_ptr<MemoryPool> MemoryPool::getInstance()
+{
+    static std::shared_ptr<MemoryPool> pool(new MemoryPool,
+                                            [](MemoryPool* p) { delete p; });
+    return pool;
+}
+
+MemoryPool::MemoryPool()
+    : _frames(0)
+{
+}
+
+MemoryPool::~MemoryPool()
+{
+    _trim(0);
+}
+
+void* MemoryPool::alloc(const size_t size, size_t& capacity, size_t& node)
+{
+    node = _getNUMANode();
+    if (size > _maxPooled)
+    {
+        capacity = size;
+        void* ptr = _allocBlock(size);
+        if (ptr)
+        {
+            std::lock_guard<std::mutex> mutex(_lock);
+            ++_stats.allocations;
+            _stats.used += size;
+            _stats.highWaterMark = std::max(_stats.highWaterMark, _stats.used);
+        }
+        return ptr;
+    }
+
+    const size_t index = _getClass(size);
+    capacity = _getCapacity(index);
+    {
+        std::lock_guard<std::mutex> mutex(_lock);
+        if (_free.size() <= node)
+            _free.resize(node + 1, std::vector<Blocks>(_nClasses));
+
+        Blocks& blocks = _free[node][index];
+        if (!blocks.empty())
+        {
+            void* ptr = blocks.back();
+            blocks.pop_back();
+            ++_stats.reuses;
+            _stats.cached -= capacity;
+            _stats.used += capacity;
+            _stats.highWaterMark = std::max(_stats.highWaterMark, _stats.used);
+            return ptr;
+        }
+    }
+
+    // Allocate and first-touch from the calling thread for NUMA locality
+    void* ptr = _allocBlock(capacity);
+    if (!ptr)
+        return nullptr;
+    uint8_t* page = static_cast<uint8_t*>(ptr);
+    for (size_t i = 0; i < capacity; i += _pageSize)
+        page[i] = 0;
+
+    std::lock_guard<std::mutex> mutex(_lock);
+    ++_stats.allocations;
+    _stats.used += capacity;
+    _stats.highWaterMark = std::max(_stats.highWaterMark, _stats.used);
+    return ptr;
+}
+
+void MemoryPool::release(void* ptr, const size_t capacity, const size_t node)
+{
+    if (!ptr)
+        return;
+
+    if (capacity > _maxPooled)
+    {
+        _freeBlock(ptr, capacity);
+        std::lock_guard<std::mutex> mutex(_lock);
+        ++_stats.frees;
+        _stats.used -= capacity;
+        return;
+    }
+
+    const size_t index = _getClass(capacity);
+    LBASSERT(capacity == _getCapacity(index));
+
+    std::lock_guard<std::mutex> mutex(_lock);
+    if (_free.size() <= node)
+        _free.resize(node + 1, std::vector<Blocks>(_nClasses));
+
+    _free[node][index].push_back(ptr);
+    _stats.used -= capacity;
+    _stats.cached += capacity;
+
+    if (_stats.used + _stats.cached > _stats.highWaterMark + _slack)
+        _trim(_stats.highWaterMark + _slack);
+}
+
+void MemoryPool::finishFrame()
+{
+    std::lock_guard<std::mutex> mutex(_lock);
+    if (++_frames < _trimInterval)
+        return;
+
+    _trim(_stats.highWaterMark);
+    // decay high-water mark to the current usage for the next period
+    _stats.highWaterMark = _stats.used;
+    _frames = 0;
+}
+
+void MemoryPool::trim()
+{
+    std::lock_guard<std::mutex> mutex(_lock);
+    _trim(_stats.used);
+}
+
+void MemoryPool::_trim(const uint64_t limit)
+{
+    // free largest blocks first, they have the least chance of reuse
+    for (size_t i = _nClasses; i > 0; --i)
+    {
+        const size_t index = i - 1;
+        const size_t capacity = _getCapacity(index);
+
+        for (std::vector<Blocks>& classes : _free)
+        {
+            Blocks& blocks = classes[index];
+            while (!blocks.empty() && _stats.used + _stats.cached > limit)
+            {
+                _freeBlock(blocks.back(), capacity);
+                blocks.pop_back();
+                ++_stats.frees;
+                _stats.cached -= capacity;
+            }
+        }
+    }
+}
+
+MemoryPool::Statistics MemoryPool::getStatistics() const
+{
+    std::lock_guard<std::mutex> mutex(_lock);
+    return _stats;
+}
+
+PoolBuffer::PoolBuffer(const PoolBuffer& from)
+    : _data(nullptr)
+    , _size(0)
+    , _capacity(0)
+    , _node(0)
+{
+    resize(from._size);
+    if (_size > 0)
+        ::memcpy(_data, from._data, _size);
+}
+
+void PoolBuffer::resize(const size_t size)
+{
+    if (size <= _capacity)
+    {
+        _size = size;
+        return;
+    }
+
+    clear();
+    _pool = MemoryPool::getInstance();
+    _data = static_cast<uint8_t*>(_pool->alloc(size, _capacity, _node));
+    if (!_data)
+    {
+        LBERROR << "Allocation of " << size << " bytes of pixel memory failed"
+                << std::endl;
+        _pool.reset();
+        _capacity = 0;
+        return;
+    }
+    _size = size;
+}
+
+void PoolBuffer::clear()
+{
+    if (!_pool)
+        return;
+
+    _pool->release(_data, _capacity, _node);
+    _pool.reset();
+    _data = nullptr;
+    _size = 0;
+    _capacity = 0;
+}
+}
+}
@@ -0,0 +1,157 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_MEMORYPOOL_H
+#define EQ_DETAIL_MEMORYPOOL_H
+
+#include <eq/types.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * A process-wide pool of pixel memory blocks, sorted in size classes.
+ *
+ * Blocks are kept in four size classes per power of two, wasting at most 25%,
+ * and in one free list per NUMA node. Memory is first touched by the
+ * allocating thread, which places it on the NUMA node of the pipe or transmit
+ * thread using it. A block remembers this node and is returned to its free
+ * list, whichever thread releases it. Large blocks are backed by transparent
+ * huge pages where available. Released blocks are cached up to the high-water
+ * mark of the memory in use, so that steady-state frames do not allocate heap
+ * memory even when the pixel viewports change. The mark is renewed every 64
+ * frames, when the cache above it is freed.
+ *
+ * The pool is shared by all buffers holding its memory, and is destroyed after
+ * the last of them, even if they outlive static destruction.
+ */
+class MemoryPool
+{
+public:
+    /** Usage counters of the pool. */
+    struct Statistics
+    {
+        Statistics()
+            : allocations(0)
+            , reuses(0)
+            , frees(0)
+            , used(0)
+            , cached(0)
+            , highWaterMark(0)
+        {
+        }
+
+        uint64_t allocations;   //!< blocks allocated from the heap
+        uint64_t reuses;        //!< blocks served from the free lists
+        uint64_t frees;         //!< blocks returned to the heap
+        uint64_t used;          //!< bytes currently handed out
+        uint64_t cached;        //!< bytes currently in the free lists
+        uint64_t highWaterMark; //!< maximum of used bytes
+    };
+
+    /** @return the pool instance of this process. */
+    static std::shared_ptr<MemoryPool> getInstance();
+
+    /**
+     * Obtain a block of at least the given size.
+     *
+     * @param size the minimum size in bytes.
+     * @param capacity returns the usable size of the block.
+     * @param node returns the NUMA node of the block.
+     * @return the memory block, or nullptr if the allocation failed.
+     */
+    void* alloc(size_t size, size_t& capacity, size_t& node);
+
+    /** Return a block obtained by alloc() to the pool. */
+    void release(void* ptr, size_t capacity, size_t node);
+
+    /**
+     * Count a finished frame.
+     *
+     * Periodically frees the cached blocks above the high-water mark of used
+     * memory since the last period.
+     */
+    void finishFrame();
+
+    /** Free all cached blocks. */
+    void trim();
+
+    /** @return a snapshot of the usage counters. */
+    Statistics getStatistics() const;
+
+private:
+    MemoryPool();
+    ~MemoryPool();
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    typedef std::vector<void*> Blocks;
+    /** Free blocks per NUMA node and size class */
+    std::vector<std::vector<Blocks>> _free;
+    mutable std::mutex _lock;
+    Statistics _stats;
+    uint32_t _frames; //!< finished frames in the current trim period
+
+    void _trim(uint64_t limit);
+};
+
+/**
+ * A resizable buffer using memory from the MemoryPool.
+ *
+ * Resizing keeps the current block if it is large enough, and does not
+ * preserve the content otherwise.
+ */
+class PoolBuffer
+{
+public:
+    PoolBuffer()
+        : _data(nullptr)
+        , _size(0)
+        , _capacity(0)
+        , _node(0)
+    {
+    }
+
+    PoolBuffer(const PoolBuffer& from);
+    ~PoolBuffer() { clear(); }
+    /** Ensure the buffer holds size bytes, retaining the block if possible. */
+    void resize(size_t size);
+
+    /** Return the memory block to the pool. */
+    void clear();
+
+    uint8_t* getData() { return _data; }
+    const uint8_t* getData() const { return _data; }
+    size_t getSize() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+private:
+    PoolBuffer& operator=(const PoolBuffer&) = delete;
+
+    std::shared_ptr<MemoryPool> _pool; //!< set while holding a block
+    uint8_t* _data;
+    size_t _size;
+    size_t _capacity;
+    size_t _node; //!< NUMA node of the block
+};
+}
+}
+
+#endif // EQ_DETAIL_MEMORYPOOL_H
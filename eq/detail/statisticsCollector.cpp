@@ -0,0 +1,87 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "statisticsCollector.h"
+
+#include <eq/fabric/statistic.h>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+/** @return a unique, non-zero token of the calling thread. */
+size_t _getThreadToken()
+{
+    static std::atomic<size_t> next(1);
+    static thread_local const size_t token = next++;
+    return token;
+}
+}
+
+StatisticsCollector::StatisticsCollector()
+{
+    for (Lane& lane : _lanes)
+        lane.owner = 0;
+}
+
+void StatisticsCollector::add(const Statistic& event)
+{
+    const size_t token = _getThreadToken();
+    for (Lane& lane : _lanes)
+    {
+        size_t owner = lane.owner.load(std::memory_order_relaxed);
+        if (owner == 0 && lane.owner.compare_exchange_strong(owner, token))
+            owner = token;
+
+        if (owner == token)
+        {
+            lane.events.push_back(event);
+            return;
+        }
+    }
+
+    lunchbox::ScopedFastWrite mutex(_overflow);
+    _overflow->push_back(event);
+}
+
+void StatisticsCollector::gather(Statistics& events)
+{
+    for (Lane& lane : _lanes)
+    {
+        events.insert(events.end(), lane.events.begin(), lane.events.end());
+        lane.events.clear();
+        lane.owner = 0;
+    }
+
+    lunchbox::ScopedFastWrite mutex(_overflow);
+    events.insert(events.end(), _overflow->begin(), _overflow->end());
+    _overflow->clear();
+}
+
+bool StatisticsCollector::isEmpty() const
+{
+    for (const Lane& lane : _lanes)
+        if (!lane.events.empty())
+            return false;
+
+    lunchbox::ScopedFastRead mutex(_overflow);
+    return _overflow->empty();
+}
+}
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQ_DETAIL_STATISTICSCOLLECTOR_H
+#define EQ_DETAIL_STATISTICSCOLLECTOR_H
+
+#include <eq/types.h>
+
+#include <lunchbox/lockable.h>
+#include <lunchbox/spinLock.h>
+
+#include <array>
+#include <atomic>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Collects the statistics events of one channel frame without locking.
+ *
+ * Each thread adding events claims a lane with a single atomic
+ * compare-and-swap, and then appends to it without synchronization. The events
+ * of all lanes are gathered once no thread uses the frame anymore, which the
+ * frame's reference count orders after all additions. The lanes keep their
+ * memory, so adding events does not allocate after the first frames. Threads
+ * beyond the number of lanes share a spin-locked overflow lane.
+ */
+class StatisticsCollector
+{
+public:
+    StatisticsCollector();
+
+    /** Add an event of the calling thread. */
+    void add(const Statistic& event);
+
+    /**
+     * Move all events to the given vector and release the lanes.
+     *
+     * Must not be called concurrently with add().
+     */
+    void gather(Statistics& events);
+
+    /** @return true if no events were added since the last gather. */
+    bool isEmpty() const;
+
+private:
+    struct Lane
+    {
+        std::atomic<size_t> owner; //!< thread token, 0 if free
+        Statistics events;
+    };
+
+    std::array<Lane, 4> _lanes; // pipe, transfer, transmit and one spare
+    lunchbox::Lockable<Statistics, lunchbox::SpinLock> _overflow;
+
+    StatisticsCollector(const StatisticsCollector&) = delete;
+    StatisticsCollector& operator=(const StatisticsCollector&) = delete;
+};
+}
+}
+
+#endif // EQ_DETAIL_STATISTICSCOLLECTOR_H
@@ -0,0 +1,273 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "topology.h"
+
+#include <eq/fabric/iAttribute.h>
+#include <lunchbox/log.h>
+#include <lunchbox/thread.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fs = boost::filesystem;
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+bool _read(const fs::path& path, std::string& value)
+{
+    std::ifstream file(path.string());
+    return file && std::getline(file, value);
+}
+
+int32_t _readNode(const fs::path& device)
+{
+    std::string value;
+    if (!_read(device / "numa_node", value))
+        return -1;
+    return std::max(-1, atoi(value.c_str()));
+}
+
+/** Parse a sysfs CPU list, e.g., "0-7,16-23" */
+std::vector<uint32_t> _parseCPUs(const std::string& list)
+{
+    std::vector<uint32_t> cpus;
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        const size_t dash = range.find('-');
+        const uint32_t first = atoi(range.c_str());
+        const uint32_t last = dash == std::string::npos
+                                  ? first
+                                  : atoi(range.c_str() + dash + 1);
+        for (uint32_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/** @return the sorted entries of dir which start with prefix and a digit */
+std::vector<std::string> _list(const fs::path& dir, const std::string& prefix)
+{
+    std::vector<std::string> names;
+    boost::system::error_code error;
+    for (fs::directory_iterator i(dir, error), end; !error && i != end; ++i)
+    {
+        const std::string name = i->path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) == 0 &&
+            name.size() > prefix.size() &&
+            name.find_first_not_of("0123456789", prefix.size()) ==
+                std::string::npos)
+        {
+            names.push_back(name);
+        }
+    }
+    std::sort(names.begin(), names.end(),
+              [&prefix](const std::string& a, const std::string& b) {
+                  return atoi(a.c_str() + prefix.size()) <
+                         atoi(b.c_str() + prefix.size());
+              });
+    return names;
+}
+
+#ifdef __linux__
+/** @return the interface with an address of the given host */
+std::string _findInterface(const std::string& hostname)
+{
+    if (hostname.empty())
+        return std::string();
+
+    addrinfo* hostInfos = nullptr;
+    if (getaddrinfo(hostname.c_str(), nullptr, nullptr, &hostInfos) != 0)
+        return std::string();
+
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0)
+    {
+        freeaddrinfo(hostInfos);
+        return std::string();
+    }
+
+    std::string name;
+    for (ifaddrs* i = interfaces; i && name.empty(); i = i->ifa_next)
+    {
+        if (!i->ifa_addr)
+            continue;
+        for (addrinfo* j = hostInfos; j && name.empty(); j = j->ai_next)
+        {
+            if (i->ifa_addr->sa_family != j->ai_family)
+                continue;
+
+            if (j->ai_family == AF_INET &&
+                reinterpret_cast<sockaddr_in*>(i->ifa_addr)->sin_addr.s_addr ==
+                    reinterpret_cast<sockaddr_in*>(j->ai_addr)->sin_addr.s_addr)
+            {
+                name = i->ifa_name;
+            }
+            else if (j->ai_family == AF_INET6 &&
+                     memcmp(&reinterpret_cast<sockaddr_in6*>(i->ifa_addr)
+                                 ->sin6_addr,
+                            &reinterpret_cast<sockaddr_in6*>(j->ai_addr)
+                                 ->sin6_addr,
+                            sizeof(in6_addr)) == 0)
+            {
+                name = i->ifa_name;
+            }
+        }
+    }
+    freeifaddrs(interfaces);
+    freeaddrinfo(hostInfos);
+    return name;
+}
+#endif
+}
+
+const Topology& Topology::getInstance()
+{
+    static const Topology topology;
+    return topology;
+}
+
+Topology::Topology()
+{
+    const fs::path nodes("/sys/devices/system/node");
+    for (const std::string& name : _list(nodes, "node"))
+    {
+        std::string list;
+        if (!_read(nodes / name / "cpulist", list))
+            continue;
+        const size_t index = atoi(name.c_str() + 4);
+        if (_cpus.size() <= index)
+            _cpus.resize(index + 1);
+        _cpus[index] = _parseCPUs(list);
+    }
+
+    if (_cpus.empty()) // no NUMA information: one node with all CPUs
+    {
+        _cpus.resize(1);
+        const uint32_t nCPUs = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t i = 0; i < nCPUs; ++i)
+            _cpus[0].push_back(i);
+    }
+
+    const fs::path drm("/sys/class/drm");
+    for (const std::string& name : _list(drm, "card"))
+    {
+        const Device gpu = {name, _readNode(drm / name / "device")};
+        _gpus.push_back(gpu);
+    }
+
+    const fs::path net("/sys/class/net");
+    boost::system::error_code error;
+    for (fs::directory_iterator i(net, error), end; !error && i != end; ++i)
+    {
+        if (!fs::exists(i->path() / "device")) // virtual interface
+            continue;
+        const Device nic = {i->path().filename().string(),
+                            _readNode(i->path() / "device")};
+        _nics.push_back(nic);
+    }
+}
+
+int32_t Topology::getGPUNode(const uint32_t device) const
+{
+    return device < _gpus.size() ? _gpus[device].node : -1;
+}
+
+int32_t Topology::getNICNode(const std::string& interface,
+                             const std::string& hostname) const
+{
+#ifdef __linux__
+    const std::string name =
+        interface.empty() ? _findInterface(hostname) : interface;
+    for (const Device& nic : _nics)
+        if (nic.name == name)
+            return nic.node;
+#endif
+    return -1;
+}
+
+int32_t Topology::getPipeNode(const int32_t hint, const uint32_t device,
+                              const size_t index) const
+{
+    const int32_t nNodes = int32_t(_cpus.size());
+    if (hint >= 0)
+    {
+        if (hint < nNodes)
+            return hint;
+        LBWARN << "Ignoring NUMA node " << hint << ", only " << nNodes
+               << " nodes present" << std::endl;
+        return -1;
+    }
+    if (hint != fabric::AUTO || nNodes < 2)
+        return -1;
+
+    const int32_t gpuNode =
+        getGPUNode(device == LB_UNDEFINED_UINT32 ? 0 : device);
+    return gpuNode >= 0 ? gpuNode : int32_t(index % nNodes);
+}
+
+int32_t Topology::getAffinity(const size_t node) const
+{
+    if (node >= _cpus.size() || _cpus[node].empty())
+        return lunchbox::Thread::NONE;
+
+    std::ostringstream path;
+    path << "/sys/devices/system/cpu/cpu" << _cpus[node].front()
+         << "/topology/physical_package_id";
+    std::string value;
+    if (!_read(path.str(), value))
+        return lunchbox::Thread::NONE;
+    return lunchbox::Thread::SOCKET + atoi(value.c_str());
+}
+
+bool Topology::bind(const size_t node) const
+{
+#ifdef __linux__
+    if (node >= _cpus.size() || _cpus[node].empty())
+        return false;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const uint32_t cpu : _cpus[node])
+        CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) ==
+           0;
+#else
+    return false;
+#endif
+}
+}
+}
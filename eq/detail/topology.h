@@ -0,0 +1,106 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_TOPOLOGY_H
+#define EQ_DETAIL_TOPOLOGY_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * The NUMA topology of the local machine, used for thread placement.
+ *
+ * Pipe threads are bound to the NUMA node given by their hint. With an AUTO
+ * hint and no hwloc GL locality for their GPU, they are bound to the node of
+ * the DRM card with their device index, or else round-robin to all nodes.
+ * Without a hint only hwloc places them. Node threads are placed on the socket
+ * of their hinted NUMA node, or of the network interface used by the node for
+ * an AUTO hint.
+ *
+ * The topology is read from sysfs and does not need hwloc. GPUs are the DRM
+ * cards in PCI order, which is assumed to be the order of the pipe devices.
+ * NICs are the network interfaces backed by a device. Without NUMA information
+ * the machine has one node with all CPUs, and devices are not associated with
+ * a node.
+ */
+class Topology
+{
+public:
+    /** A GPU or NIC with the NUMA node it is attached to. */
+    struct Device
+    {
+        std::string name;
+        int32_t node; //!< -1 if unknown
+    };
+    typedef std::vector<Device> Devices;
+
+    /** @return the topology of this machine, discovered on first use. */
+    EQ_API static const Topology& getInstance();
+
+    /** Discover the topology of this machine. */
+    EQ_API Topology();
+
+    /** @return the number of NUMA nodes, at least one. */
+    size_t getNumNodes() const { return _cpus.size(); }
+    /** @return the CPUs of the given NUMA node. */
+    const std::vector<uint32_t>& getCPUs(const size_t node) const
+    {
+        return _cpus[node];
+    }
+
+    /** @return the GPUs in device order. */
+    const Devices& getGPUs() const { return _gpus; }
+    /** @return the network interfaces. */
+    const Devices& getNICs() const { return _nics; }
+    /** @return the NUMA node of the given GPU device, or -1. */
+    EQ_API int32_t getGPUNode(uint32_t device) const;
+
+    /** @return the NUMA node of the NIC serving the given host, or -1. */
+    EQ_API int32_t getNICNode(const std::string& interface,
+                              const std::string& hostname) const;
+
+    /**
+     * @return the NUMA node of a pipe thread, or -1 to not bind it.
+     * @param hint the pipe's IATTR_HINT_NUMA_NODE: a node index, AUTO or
+     *             UNDEFINED.
+     * @param device the pipe's GPU, or LB_UNDEFINED_UINT32 for the default.
+     * @param index the position of the pipe in its node.
+     */
+    EQ_API int32_t getPipeNode(int32_t hint, uint32_t device,
+                               size_t index) const;
+
+    /**
+     * @return the lunchbox::Thread affinity of the socket holding the given
+     *         NUMA node, or lunchbox::Thread::NONE.
+     */
+    EQ_API int32_t getAffinity(size_t node) const;
+
+    /** Bind the calling thread to the CPUs of the given NUMA node. */
+    EQ_API bool bind(size_t node) const;
+
+private:
+    std::vector<std::vector<uint32_t>> _cpus;
+    Devices _gpus;
+    Devices _nics;
+};
+}
+}
+
+#endif // EQ_DETAIL_TOPOLOGY_H
@@ -204,6 +204,8 @@ private:
 
     /** @internal */
     EQFABRIC_INL virtual uint128_t commit(const uint32_t incarnation);
+    /** @internal @return true if the canvas or its segments have data to commit. */
+    EQFABRIC_INL bool isSubtreeDirty() const override;
     bool _mapViewObjects();
 
     typedef co::CommandFunc<Canvas<CFG, C, S, L>> CmdFunc;
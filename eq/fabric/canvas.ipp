@@ -98,11 +98,26 @@ void Canvas<CFG, C, S, L>::attach(const uint128_t& id,
 template <class CFG, class C, class S, class L>
 uint128_t Canvas<CFG, C, S, L>::commit(const uint32_t incarnation)
 {
-    if (Serializable::isDirty(DIRTY_SEGMENTS))
-        commitChildren<S>(_segments, CMD_CANVAS_NEW_SEGMENT, incarnation);
+    // Always traverse segments: segment user data may be dirty. Only dirty
+    // segments are committed.
+    commitChildren<S>(_segments, CMD_CANVAS_NEW_SEGMENT, incarnation);
     return Object::commit(incarnation);
 }
 
+template <class CFG, class C, class S, class L>
+bool Canvas<CFG, C, S, L>::isSubtreeDirty() const
+{
+    if (isDirty())
+        return true;
+    for (typename Segments::const_iterator i = _segments.begin();
+         i != _segments.end(); ++i)
+    {
+        if ((*i)->isSubtreeDirty())
+            return true;
+    }
+    return false;
+}
+
 template <class CFG, class C, class S, class L>
 void Canvas<CFG, C, S, L>::serialize(co::DataOStream& os,
                                      const uint64_t dirtyBits)
@@ -282,6 +282,8 @@ public:
         IATTR_HINT_STATISTICS,
         /** Use a send token for output frames (OFF, ON) */
         IATTR_HINT_SENDTOKEN,
+        /** Maximum number of pending async readbacks (AUTO, OFF, n) */
+        IATTR_HINT_READBACK_DEPTH,
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
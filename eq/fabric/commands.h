@@ -52,6 +52,8 @@ enum ClientCommand
 {
     CMD_CLIENT_EXIT = CMD_SERVER_CUSTOM,
     CMD_CLIENT_INTERRUPT,
+    CMD_CLIENT_LAUNCH,
+    CMD_CLIENT_LAUNCH_REPLY,
     CMD_CLIENT_CUSTOM
 };
 
@@ -88,6 +90,8 @@ enum ConfigCommand
     CMD_CONFIG_SYNC_CLOCK,
     CMD_CONFIG_SWAP_OBJECT,
     CMD_CONFIG_CHECK_FRAME,
+    CMD_CONFIG_LATCH_HEAD,
+    CMD_CONFIG_CALIBRATE,
     CMD_CONFIG_CUSTOM
 };
 
@@ -107,6 +111,7 @@ enum NodeCommand
     CMD_NODE_FRAME_TASKS_FINISH,
     CMD_NODE_FRAMEDATA_TRANSMIT,
     CMD_NODE_FRAMEDATA_READY,
+    CMD_NODE_LATCH_HEAD,
     CMD_NODE_CUSTOM
 };
 
@@ -178,6 +183,10 @@ enum ChannelCommand
     CMD_CHANNEL_FRAME_TILES,
     CMD_CHANNEL_FINISH_READBACK,
     CMD_CHANNEL_DELETE_TRANSFER_WINDOW,
+    CMD_CHANNEL_CALIBRATE,
+    CMD_CHANNEL_CALIBRATE_REPLY,
+    CMD_CHANNEL_CALIBRATE_PROBE,
+    CMD_CHANNEL_CALIBRATE_PROBE_REPLY,
     CMD_CHANNEL_CUSTOM
 };
 
@@ -137,6 +137,9 @@ public:
     enum IAttribute
     {
         IATTR_ROBUSTNESS, //!< Tolerate resource failures
+        IATTR_FRAME_PLAN, //!< Send frame parameters with the frame start
+        IATTR_LAUNCH_THREADS, //!< Nodes connected and launched in parallel
+        IATTR_LAUNCH_FANOUT,  //!< Nodes launched by each render node, or OFF
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
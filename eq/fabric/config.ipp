@@ -40,7 +40,9 @@ std::string _fAttributeStrings[] = {
     MAKE_ATTR_STRING(FATTR_EYE_BASE), MAKE_ATTR_STRING(FATTR_VERSION),
 };
 std::string _iAttributeStrings[] = {
-    MAKE_ATTR_STRING(IATTR_ROBUSTNESS),
+    MAKE_ATTR_STRING(IATTR_ROBUSTNESS), MAKE_ATTR_STRING(IATTR_FRAME_PLAN),
+    MAKE_ATTR_STRING(IATTR_LAUNCH_THREADS),
+    MAKE_ATTR_STRING(IATTR_LAUNCH_FANOUT),
 };
 }
 
@@ -651,15 +653,12 @@ uint128_t Config<S, C, O, L, CV, N, V>::commit(const uint32_t incarnation)
         commitChildren<O, C>(_observers, static_cast<C*>(this),
                              CMD_CONFIG_NEW_OBSERVER, incarnation);
 
-    // Always traverse layouts and canvases: view/segment objects may be dirty
+    // Always traverse layouts and canvases: view/segment user data may be
+    // dirty. Only dirty subtrees are committed, see isSubtreeDirty().
     commitChildren<L, C>(_layouts, static_cast<C*>(this), CMD_CONFIG_NEW_LAYOUT,
                          incarnation);
     commitChildren<CV, C>(_canvases, static_cast<C*>(this),
                           CMD_CONFIG_NEW_CANVAS, incarnation);
-
-    if (Serializable::isDirty(DIRTY_CANVASES))
-        commitChildren<CV, C>(_canvases, static_cast<C*>(this),
-                              CMD_CONFIG_NEW_CANVAS, incarnation);
     return Object::commit(incarnation);
 }
 
@@ -913,6 +912,13 @@ std::ostream& operator<<(std::ostream& os,
        << "{" << std::endl
        << lunchbox::indent << "robustness "
        << IAttribute(config.getIAttribute(C::IATTR_ROBUSTNESS)) << std::endl
+       << "frame_plan "
+       << IAttribute(config.getIAttribute(C::IATTR_FRAME_PLAN)) << std::endl
+       << "launch_threads "
+       << IAttribute(config.getIAttribute(C::IATTR_LAUNCH_THREADS))
+       << std::endl
+       << "launch_fanout "
+       << IAttribute(config.getIAttribute(C::IATTR_LAUNCH_FANOUT)) << std::endl
        << "eye_base   " << config.getFAttribute(C::FATTR_EYE_BASE) << std::endl
        << lunchbox::exdent << "}" << std::endl;
 
@@ -43,6 +43,8 @@ public:
         , resistance2i(0, 0)
         , tileSize(64, 64)
         , chunkSize(1)
+        , targetFrameRate(0.f)
+        , weight(1.f)
         , mode(fabric::Equalizer::MODE_2D)
         , frozen(false)
     {
@@ -75,6 +77,9 @@ public:
         , resistance2i(rhs.resistance2i)
         , tileSize(rhs.tileSize)
         , chunkSize(rhs.chunkSize)
+        , targetFrameRate(rhs.targetFrameRate)
+        , weight(rhs.weight)
+        , modelName(rhs.modelName)
         , mode(rhs.mode)
         , frozen(rhs.frozen)
     {
@@ -89,6 +94,9 @@ public:
     Vector2i resistance2i;
     Vector2i tileSize;
     float chunkSize;
+    float targetFrameRate;
+    float weight;
+    std::string modelName;
     fabric::Equalizer::Mode mode;
     bool frozen;
 };
@@ -233,11 +241,44 @@ float Equalizer::getChunkSize() const
     return _data->chunkSize;
 }
 
+void Equalizer::setTargetFrameRate(const float frameRate)
+{
+    LBASSERT(frameRate >= 0.f);
+    _data->targetFrameRate = frameRate;
+}
+
+float Equalizer::getTargetFrameRate() const
+{
+    return _data->targetFrameRate;
+}
+
+void Equalizer::setWeight(const float weight)
+{
+    LBASSERT(weight > 0.f);
+    _data->weight = weight;
+}
+
+float Equalizer::getWeight() const
+{
+    return _data->weight;
+}
+
+void Equalizer::setModelName(const std::string& name)
+{
+    _data->modelName = name;
+}
+
+const std::string& Equalizer::getModelName() const
+{
+    return _data->modelName;
+}
+
 void Equalizer::serialize(co::DataOStream& os) const
 {
     os << _data->damping << _data->boundaryf << _data->resistancef
        << _data->assembleOnlyLimit << _data->frameRate << _data->boundary2i
        << _data->resistance2i << _data->tileSize << _data->chunkSize
+       << _data->targetFrameRate << _data->weight << _data->modelName
        << _data->mode << _data->frozen;
 }
 
@@ -246,6 +287,7 @@ void Equalizer::deserialize(co::DataIStream& is)
     is >> _data->damping >> _data->boundaryf >> _data->resistancef >>
         _data->assembleOnlyLimit >> _data->frameRate >> _data->boundary2i >>
         _data->resistance2i >> _data->tileSize >> _data->chunkSize >>
+        _data->targetFrameRate >> _data->weight >> _data->modelName >>
         _data->mode >> _data->frozen;
 }
 
@@ -282,7 +324,10 @@ std::ostream& operator<<(std::ostream& os, const Equalizer::Mode mode)
                      ? "VERTICAL"
                      : mode == Equalizer::MODE_HORIZONTAL
                            ? "HORIZONTAL"
-                           : mode == Equalizer::MODE_DB ? "DB" : "ERROR");
+                           : mode == Equalizer::MODE_DB
+                                 ? "DB"
+                                 : mode == Equalizer::MODE_HYBRID ? "HYBRID"
+                                                                  : "ERROR");
     return os;
 }
 } // namespace fabric
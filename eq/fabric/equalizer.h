@@ -53,7 +53,8 @@ public:
         MODE_DB = 0,     //!< Adapt for a sort-last decomposition
         MODE_HORIZONTAL, //!< Adapt for sort-first using horizontal stripes
         MODE_VERTICAL,   //!< Adapt for sort-first using vertical stripes
-        MODE_2D          //!< Adapt for a sort-first decomposition
+        MODE_2D,         //!< Adapt for a sort-first decomposition
+        MODE_HYBRID      //!< Select 2D or DB per subtree @version 2.2
     };
 
     /** @name Data Access. */
@@ -123,6 +124,33 @@ public:
 
     /** @return the database range for the TileEqualizer. */
     EQFABRIC_API float getChunkSize() const;
+
+    /**
+     * Set the frame rate the ViewEqualizer schedules resources for, or 0.
+     * @version 2.2
+     */
+    EQFABRIC_API void setTargetFrameRate(float frameRate);
+
+    /** @return the target frame rate for the ViewEqualizer. @version 2.2 */
+    EQFABRIC_API float getTargetFrameRate() const;
+
+    /** Set the priority of a view in the ViewEqualizer. @version 2.2 */
+    EQFABRIC_API void setWeight(float weight);
+
+    /** @return the priority of a view in the ViewEqualizer. @version 2.2 */
+    EQFABRIC_API float getWeight() const;
+
+    /**
+     * Set the name of the rendered model.
+     *
+     * The server keeps the balancing state of the equalizers per model, and
+     * restores it when the model is used again.
+     * @version 2.2
+     */
+    EQFABRIC_API void setModelName(const std::string& name);
+
+    /** @return the name of the rendered model. @version 2.2 */
+    EQFABRIC_API const std::string& getModelName() const;
     //@}
 
     EQFABRIC_API void serialize(co::DataOStream& os) const; //!< @internal
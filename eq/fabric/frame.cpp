@@ -82,6 +82,21 @@ void Frame::applyInstanceData(co::DataIStream& is)
     _impl->deserialize(is);
 }
 
+void Frame::setData(const Frame& from)
+{
+    *_impl = *from._impl;
+}
+
+void Frame::serialize(co::DataOStream& os) const
+{
+    _impl->serialize(os);
+}
+
+void Frame::deserialize(co::DataIStream& is)
+{
+    _impl->deserialize(is);
+}
+
 void Frame::setName(const std::string& name)
 {
     _impl->name = name;
@@ -106,6 +106,15 @@ public:
     /** @internal @return the receiving co::Node IDs of an output frame */
     EQFABRIC_API const co::NodeIDs& getInputNetNodes(const Eye eye) const;
 
+    /** @internal Copy the shared data, used for frame plans. */
+    EQFABRIC_API void setData(const Frame& from);
+
+    /** @internal Serialize the shared data into a frame plan. */
+    EQFABRIC_API void serialize(co::DataOStream& os) const;
+
+    /** @internal Deserialize the shared data from a frame plan. */
+    EQFABRIC_API void deserialize(co::DataIStream& is);
+
 protected:
     virtual ChangeType getChangeType() const { return INSTANCE; }
     EQFABRIC_API virtual void getInstanceData(co::DataOStream& os);
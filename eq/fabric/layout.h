@@ -152,6 +152,8 @@ private:
 
     /** @internal */
     EQFABRIC_INL virtual uint128_t commit(const uint32_t incarnation);
+    /** @internal @return true if the layout or its views have data to commit. */
+    EQFABRIC_INL bool isSubtreeDirty() const override;
 
     template <class O>
     void _removeObserver(const O* observer);
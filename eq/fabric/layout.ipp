@@ -74,11 +74,26 @@ void Layout<C, L, V>::attach(const uint128_t& id, const uint32_t instanceID)
 template <class C, class L, class V>
 uint128_t Layout<C, L, V>::commit(const uint32_t incarnation)
 {
-    // Always traverse views: view proxy objects may be dirty
+    // Always traverse views: view user data may be dirty. Only dirty views are
+    // committed.
     commitChildren<V>(_views, CMD_LAYOUT_NEW_VIEW, incarnation);
     return Object::commit(incarnation);
 }
 
+template <class C, class L, class V>
+bool Layout<C, L, V>::isSubtreeDirty() const
+{
+    if (isDirty())
+        return true;
+    for (typename Views::const_iterator i = _views.begin(); i != _views.end();
+         ++i)
+    {
+        if ((*i)->isSubtreeDirty())
+            return true;
+    }
+    return false;
+}
+
 template <class C, class L, class V>
 void Layout<C, L, V>::serialize(co::DataOStream& os, const uint64_t dirtyBits)
 {
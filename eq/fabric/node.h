@@ -81,6 +81,7 @@ public:
         IATTR_THREAD_MODEL,
         IATTR_LAUNCH_TIMEOUT, //!< Timeout when auto-launching the node
         IATTR_HINT_AFFINITY,
+        IATTR_HINT_NUMA_NODE, //!< NUMA node of the node threads, or AUTO
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -89,6 +89,16 @@ public:
     /** @return true if the object has data to commit. @version 1.0 */
     EQFABRIC_API bool isDirty() const override;
 
+    /**
+     * @internal
+     * @return true if this object or one of its children has data to commit.
+     *
+     * Children propagate their dirty state to the parent using the parent's
+     * dirty bits. Objects whose children may become dirty without notifying
+     * the parent, e.g., through their user data, extend this test.
+     */
+    virtual bool isSubtreeDirty() const { return isDirty(); }
+
     /** @internal */
     EQFABRIC_API uint128_t
         commit(const uint32_t incarnation = CO_COMMIT_NEXT) override;
@@ -232,26 +242,51 @@ template <class C, class S>
 inline void Object::commitChildren(const std::vector<C*>& children, S* sender,
                                    uint32_t cmd, const uint32_t incarnation)
 {
-    // TODO Opt: async register and commit
+    // Register all new children with the server before waiting for the first
+    // reply, and map them all before syncing the first mapping, so that a batch
+    // of new children costs one round-trip instead of one per child.
+    std::vector<C*> newChildren;
+    std::vector<lunchbox::Request<uint128_t> > requests;
+    co::LocalNodePtr localNode;
     for (typename std::vector<C*>::const_iterator i = children.begin();
          i != children.end(); ++i)
     {
         C* child = *i;
-        commitChild<C, S>(child, sender, cmd, incarnation);
+        if (child->isAttached())
+            continue;
+
+        LBASSERT(!isMaster());
+        if (!localNode)
+            localNode = child->getConfig()->getLocalNode();
+        requests.push_back(localNode->registerRequest<uint128_t>());
+        co::NodePtr node = child->getServer().get();
+        sender->send(node, cmd) << requests.back();
+        newChildren.push_back(child);
     }
+
+    std::vector<uint32_t> mapRequests;
+    mapRequests.reserve(newChildren.size());
+    for (size_t i = 0; i < newChildren.size(); ++i)
+        mapRequests.push_back(localNode->mapObjectNB(newChildren[i],
+                                                     requests[i].wait(),
+                                                     co::VERSION_NONE));
+    for (size_t i = 0; i < mapRequests.size(); ++i)
+        LBCHECK(localNode->mapObjectSync(mapRequests[i]));
+
+    commitChildren(children, incarnation);
 }
 
 template <class C>
 inline void Object::commitChildren(const std::vector<C*>& children,
                                    const uint32_t incarnation)
 {
-    // TODO Opt: async commit
     for (typename std::vector<C*>::const_iterator i = children.begin();
          i != children.end(); ++i)
     {
         C* child = *i;
         LBASSERT(child->isAttached());
-        child->commit(incarnation);
+        if (child->isSubtreeDirty())
+            child->commit(incarnation);
     }
 }
 
@@ -110,6 +110,7 @@ public:
         // Note: also update string array initialization in pipe.cpp
         IATTR_HINT_THREAD,   //!< Execute tasks in separate thread (default)
         IATTR_HINT_AFFINITY, //!< Bind render thread to subset of cores
+        IATTR_HINT_NUMA_NODE, //!< NUMA node of the render thread, or AUTO
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -39,6 +39,7 @@ namespace
 std::string _iPipeAttributeStrings[] = {
     MAKE_PIPE_ATTR_STRING(IATTR_HINT_THREAD),
     MAKE_PIPE_ATTR_STRING(IATTR_HINT_AFFINITY),
+    MAKE_PIPE_ATTR_STRING(IATTR_HINT_NUMA_NODE),
 };
 }
 
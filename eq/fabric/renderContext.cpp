@@ -30,6 +30,7 @@ RenderContext::RenderContext()
     , period(1)
     , phase(0)
     , eye(EYE_CYCLOP)
+    , frustumType(0)
 {
 }
 
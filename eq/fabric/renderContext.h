@@ -66,7 +66,9 @@ public:
     uint32_t alignToEight; //!< @internal padding
 
     ColorMask bufferMask; //!< color mask for anaglyph stereo
-    bool alignDummy[28];  //!< @internal padding
+    Vector3f eyeWall;     //!< @internal eye position wrt frustum
+    uint32_t frustumType; //!< @internal Wall::Type of the frustum
+    bool alignDummy[12];  //!< @internal padding
 };
 
 EQFABRIC_API std::ostream& operator<<(std::ostream&, const RenderContext&);
@@ -48,7 +48,8 @@ static StatisticData _statisticData[] = {
     {Statistic::CHANNEL_FRAME_WAIT_READY, "wait frame",
      Vector3f(1.0f, 0.f, 0.f)},
     {Statistic::CHANNEL_READBACK, "readback", Vector3f(1.0f, .5f, .5f)},
-    {Statistic::CHANNEL_ASYNC_READBACK, "readback", Vector3f(1.0f, .5f, .5f)},
+    {Statistic::CHANNEL_ASYNC_READBACK, "async readback",
+     Vector3f(1.0f, .5f, .5f)},
     {Statistic::CHANNEL_VIEW_FINISH, "view finish", Vector3f(1.f, 0.f, 1.0f)},
     {Statistic::CHANNEL_FRAME_TRANSMIT, "transmit", Vector3f(0.f, 0.f, 1.0f)},
     {Statistic::CHANNEL_FRAME_COMPRESS, "compress", Vector3f(0.f, .7f, 1.f)},
@@ -66,6 +67,9 @@ static StatisticData _statisticData[] = {
     {Statistic::CONFIG_FINISH_FRAME, "finish frame", Vector3f(.5f, .5f, .5f)},
     {Statistic::CONFIG_WAIT_FINISH_FRAME, "wait finish",
      Vector3f(1.0f, 0.f, 0.f)},
+    {Statistic::VIEW_FPS, "view FPS", Vector3f(1.f, 1.f, 1.f)},
+    {Statistic::CHANNEL_READBACK_WAIT, "wait readback",
+     Vector3f(1.0f, 0.f, 0.f)},
     {Statistic::ALL, "ALL EVENTS", Vector3f(0.0f, 0.f, 0.f)}};
 }
 
@@ -67,6 +67,9 @@ struct Statistic : public Event
         CONFIG_FINISH_FRAME,   //!< Sampling of Config::finishFrame
         /** Sampling of synchronization time during Config::finishFrame */
         CONFIG_WAIT_FINISH_FRAME,
+        VIEW_FPS, //!< Achieved and target framerate of a view_equalizer view
+        /** Sampling of finishing an async readback on the transfer thread */
+        CHANNEL_READBACK_WAIT,
         ALL // must be last
     };
 
@@ -77,13 +80,16 @@ struct Statistic : public Event
 
     int64_t startTime; //!< Absolute start time of the operation
     int64_t endTime;   //!< Absolute end time of the operation
-    int64_t idleTime;  //!< Absolute idle time of PIPE_IDLE
-    int64_t totalTime; //!< Total time of a pipe frame (PIPE_IDLE)
+    /** Absolute idle time of PIPE_IDLE, ROI frames without readback */
+    int64_t idleTime;
+    /** Total time of a pipe frame (PIPE_IDLE), ROI frames analysed */
+    int64_t totalTime;
 
-    float ratio;      //!< compression ratio (transfer, compression)
-    float currentFPS; //!< FPS of last frame (WINDOW_FPS)
+    /** compression ratio, resource share (VIEW_FPS), ROI hit rate */
+    float ratio;
+    float currentFPS; //!< FPS of last frame (WINDOW_FPS, VIEW_FPS)
     float averageFPS; //!< Weighted sum averaging of FPS (WINDOW_FPS)
-    float pad;        //!< @internal
+    float targetFPS;  //!< Target FPS, 0 for none (VIEW_FPS) @version 2.2
 
     char resourceName[32]; //!< A non-unique name of the originator
 
@@ -21,6 +21,7 @@
 #include "frameData.h"
 
 #include "channelStatistics.h"
+#include "detail/memoryPool.h"
 #include "exception.h"
 #include "image.h"
 #include "log.h"
@@ -55,6 +56,7 @@ class FrameData
 public:
     FrameData()
         : version(co::VERSION_NONE.low())
+        , planVersion(co::VERSION_NONE.low())
         , useAlpha(true)
         , colorQuality(1.f)
         , depthQuality(1.f)
@@ -71,7 +73,8 @@ public:
 
     Images pendingImages;
 
-    uint64_t version; //!< The current version
+    uint64_t version;     //!< The current version
+    uint64_t planVersion; //!< The last version applied from a frame plan
 
     /** Data ready monitor for output->input synchronization. */
     Monitor readyVersion;
@@ -164,6 +167,10 @@ void FrameData::applyInstanceData(co::DataIStream& is)
 
 void FrameData::clear()
 {
+    // release adopted receive buffers, cached images are reset on reuse
+    for (Image* image : _impl->images)
+        image->setPixelViewport(PixelViewport());
+
     _impl->imageCacheLock.lock();
     _impl->imageCache.insert(_impl->imageCache.end(), _impl->images.begin(),
                              _impl->images.end());
@@ -184,6 +191,7 @@ void FrameData::flush()
     }
 
     _impl->imageCache.clear();
+    detail::MemoryPool::getInstance()->trim();
 }
 
 void FrameData::deleteGLObjects(util::ObjectManager& om)
@@ -343,6 +351,22 @@ void FrameData::setVersion(const uint64_t version)
     LBLOG(LOG_ASSEMBLY) << "New v" << version << std::endl;
 }
 
+co::ObjectVersion FrameData::getDataVersion() const
+{
+    return co::ObjectVersion(getID(), uint128_t(0, _impl->version));
+}
+
+void FrameData::applyPlan(const fabric::FrameData& data)
+{
+    if (_impl->planVersion >= _impl->version)
+        return;
+
+    clear();
+    fabric::FrameData::operator=(data);
+    _impl->planVersion = _impl->version;
+    LBLOG(LOG_ASSEMBLY) << "applied plan " << this << std::endl;
+}
+
 void FrameData::waitReady(const uint32_t timeout) const
 {
     if (!_impl->readyVersion.timedWaitGE(_impl->version, timeout))
@@ -413,7 +437,7 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
                          const PixelViewport& pvp, const Zoom& zoom,
                          const RenderContext& context,
                          const Frame::Buffer buffers_, const bool useAlpha,
-                         uint8_t* data)
+                         uint8_t* data, const co::ICommand& owner)
 {
     LBASSERT(_impl->readyVersion < frameDataVersion.version.low());
     if (_impl->readyVersion >= frameDataVersion.version.low())
@@ -473,7 +497,10 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
             image->setZoom(zoom);
             image->setContext(context);
             image->setQuality(buffer, header->quality);
-            image->setPixelData(buffer, pixelData);
+            if (compressor > EQ_COMPRESSOR_NONE)
+                image->setPixelData(buffer, pixelData);
+            else // pixels stay in the receive buffer of the owner command
+                image->adoptPixelData(buffer, pixelData, owner);
         }
     }
 
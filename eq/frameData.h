@@ -175,6 +175,12 @@ public:
     /** @internal */
     void setVersion(const uint64_t version);
 
+    /** @internal @return the identifier and version of the current data. */
+    co::ObjectVersion getDataVersion() const;
+
+    /** @internal Apply the data of the current version from a frame plan. */
+    void applyPlan(const fabric::FrameData& data);
+
     typedef lunchbox::Monitor<uint32_t> Listener; //!< Ready listener
 
     /**
@@ -201,7 +207,8 @@ public:
     bool addImage(const co::ObjectVersion& frameDataVersion,
                   const PixelViewport& pvp, const Zoom& zoom,
                   const RenderContext& context, const Frame::Buffer buffers,
-                  const bool useAlpha, uint8_t* data);
+                  const bool useAlpha, uint8_t* data,
+                  const co::ICommand& owner);
     void setReady(const co::ObjectVersion& frameData,
                   const fabric::FrameData& data); //!< @internal
 
@@ -20,6 +20,7 @@
 
 #include "image.h"
 
+#include "detail/memoryPool.h"
 #include "gl.h"
 #include "half.h"
 #include "log.h"
@@ -31,7 +32,6 @@
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 
-#include <lunchbox/buffer.h>
 #include <lunchbox/memoryMap.h>
 #include <pression/compressor.h>
 #include <pression/decompressor.h>
@@ -54,6 +54,7 @@
 
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
+#include <co/iCommand.h>
 
 namespace eq
 {
@@ -65,6 +66,7 @@ struct Memory : public PixelData
 public:
     Memory()
         : state(INVALID)
+        , isAdopted(false)
         , hasAlpha(true)
     {
     }
@@ -73,8 +75,13 @@ public:
         : PixelData(rhs)
         , state(rhs.state)
         , localBuffer(rhs.localBuffer)
+        , owner(rhs.owner)
+        , isAdopted(rhs.isAdopted)
         , hasAlpha(rhs.hasAlpha)
     {
+        if (isAdopted) // share the read-only pixels of the owner
+            return;
+
         if (rhs.localBuffer.isEmpty())
         {
             const size_t size = rhs.pvp.w * rhs.pvp.h * rhs.pixelSize;
@@ -89,6 +96,7 @@ public:
         PixelData::reset();
         state = INVALID;
         localBuffer.clear();
+        releaseOwner();
         hasAlpha = true;
     }
 
@@ -99,10 +107,41 @@ public:
         LBASSERT(pixelSize > 0);
         LBASSERT(pvp.hasArea());
 
+        releaseOwner();
         localBuffer.resize(pvp.getArea() * pixelSize);
         pixels = localBuffer.getData();
     }
 
+    /** Use pixels owned by the given command without copying them. */
+    void adopt(const co::ICommand& command, void* data)
+    {
+        localBuffer.clear();
+        owner = command;
+        isAdopted = true;
+        pixels = data;
+    }
+
+    /** Copy adopted pixels into the local buffer before they are written. */
+    void makeWritable()
+    {
+        if (!isAdopted)
+            return;
+
+        const size_t size = pvp.getArea() * pixelSize;
+        localBuffer.resize(size);
+        memcpy(localBuffer.getData(), pixels, size);
+        pixels = localBuffer.getData();
+        releaseOwner();
+    }
+
+    void releaseOwner()
+    {
+        if (!isAdopted)
+            return;
+        owner = co::ICommand();
+        isAdopted = false;
+    }
+
     enum State
     {
         INVALID,
@@ -114,8 +153,12 @@ public:
 
     /** During the call of setPixelData or writeImage, we have to
      * manage an internal buffer to copy the data. Otherwise the downloader
-     * allocates the memory. */
-    lunchbox::Bufferb localBuffer;
+     * allocates the memory. Pooled to avoid reallocation on resize. */
+    detail::PoolBuffer localBuffer;
+
+    /** Keeps the receive buffer of adopted, read-only pixels alive. */
+    co::ICommand owner;
+    bool isAdopted; //!< pixels point into the owner's buffer
 
     bool hasAlpha; //!< The uncompressed pixels contain alpha
 };
@@ -141,6 +184,7 @@ co::DataIStream& operator>>(co::DataIStream& is, Memory& mem)
     is >> mem.hasAlpha >> mem.state >> mem.externalFormat >>
         mem.internalFormat >> mem.pixelSize >> size;
 
+    mem.releaseOwner();
     mem.localBuffer.resize(size);
     is >> co::Array<void>(mem.localBuffer.getData(), size) >> mem.pvp;
     mem.pixels = mem.localBuffer.getData();
@@ -558,7 +602,9 @@ const uint8_t* Image::getPixelPointer(const Frame::Buffer buffer) const
 uint8_t* Image::getPixelPointer(const Frame::Buffer buffer)
 {
     LBASSERT(hasPixelData(buffer));
-    return reinterpret_cast<uint8_t*>(_impl->getMemory(buffer).pixels);
+    Memory& memory = _impl->getMemory(buffer);
+    memory.makeWritable();
+    return reinterpret_cast<uint8_t*>(memory.pixels);
 }
 
 const PixelData& Image::getPixelData(const Frame::Buffer buffer) const
@@ -691,6 +737,7 @@ bool Image::startReadback(const Frame::Buffer buffer,
     _setExternalFormat(buffer, info.outputTokenType, info.outputTokenSize,
                        alpha);
     attachment.memory.state = Memory::DOWNLOAD;
+    memory.releaseOwner();
 
     if (!memory.hasAlpha)
         flags |= EQ_COMPRESSOR_IGNORE_ALPHA;
@@ -888,6 +935,8 @@ void Image::setPixelViewport(const PixelViewport& pvp)
     _impl->pvp = pvp;
     _impl->color.memory.state = Memory::INVALID;
     _impl->depth.memory.state = Memory::INVALID;
+    _impl->color.memory.releaseOwner();
+    _impl->depth.memory.releaseOwner();
     _impl->color.memory.compressedData = pression::CompressorResult();
     _impl->depth.memory.compressedData = pression::CompressorResult();
 }
@@ -941,41 +990,14 @@ void Image::validatePixelData(const Frame::Buffer buffer)
 
 void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
 {
-    Memory& memory = _impl->getMemory(buffer);
-    memory.externalFormat = pixels.externalFormat;
-    memory.internalFormat = pixels.internalFormat;
-    memory.pixelSize = pixels.pixelSize;
-    memory.pvp = pixels.pvp;
-    memory.state = Memory::INVALID;
-    memory.compressedData = pression::CompressorResult();
-    memory.hasAlpha = false;
-
-    const EqCompressorInfos& transferrers =
-        _impl->findTransferers(buffer, 0 /*GLEW context*/);
-    if (transferrers.empty())
-        LBWARN << "No upload engines found for given pixel data" << std::endl;
-    else
-    {
-        memory.hasAlpha =
-            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
-#ifndef NDEBUG
-        for (EqCompressorInfosCIter i = transferrers.begin();
-             i != transferrers.end(); ++i)
-        {
-            LBASSERTINFO(memory.hasAlpha ==
-                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
-                         "Uploaders don't agree on alpha state of external "
-                             << "format: " << transferrers.front()
-                             << " != " << *i);
-        }
-#endif
-    }
+    _setPixelFormat(buffer, pixels);
 
     const uint32_t size = getPixelDataSize(buffer);
     LBASSERT(size > 0);
     if (size == 0)
         return;
 
+    Memory& memory = _impl->getMemory(buffer);
     if (pixels.compressedData.compressor <= EQ_COMPRESSOR_NONE)
     {
         validatePixelData(buffer); // alloc memory for pixels
@@ -1023,6 +1045,59 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
                                         outDims, pixels.compressorFlags);
 }
 
+void Image::adoptPixelData(const Frame::Buffer buffer, const PixelData& pixels,
+                           const co::ICommand& owner)
+{
+    if (pixels.compressedData.compressor > EQ_COMPRESSOR_NONE ||
+        !pixels.pixels)
+    {
+        setPixelData(buffer, pixels);
+        return;
+    }
+
+    _setPixelFormat(buffer, pixels);
+    if (getPixelDataSize(buffer) == 0)
+        return;
+
+    Memory& memory = _impl->getMemory(buffer);
+    memory.adopt(owner, pixels.pixels);
+    memory.state = Memory::VALID;
+    memory.compressedData = pression::CompressorResult();
+}
+
+void Image::_setPixelFormat(const Frame::Buffer buffer, const PixelData& pixels)
+{
+    Memory& memory = _impl->getMemory(buffer);
+    memory.externalFormat = pixels.externalFormat;
+    memory.internalFormat = pixels.internalFormat;
+    memory.pixelSize = pixels.pixelSize;
+    memory.pvp = pixels.pvp;
+    memory.state = Memory::INVALID;
+    memory.compressedData = pression::CompressorResult();
+    memory.hasAlpha = false;
+
+    const EqCompressorInfos& transferrers =
+        _impl->findTransferers(buffer, 0 /*GLEW context*/);
+    if (transferrers.empty())
+        LBWARN << "No upload engines found for given pixel data" << std::endl;
+    else
+    {
+        memory.hasAlpha =
+            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
+#ifndef NDEBUG
+        for (EqCompressorInfosCIter i = transferrers.begin();
+             i != transferrers.end(); ++i)
+        {
+            LBASSERTINFO(memory.hasAlpha ==
+                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
+                         "Uploaders don't agree on alpha state of external "
+                             << "format: " << transferrers.front()
+                             << " != " << *i);
+        }
+#endif
+    }
+}
+
 /** Find and activate a compression engine */
 bool Image::allocCompressor(const Frame::Buffer buffer, const uint32_t name)
 {
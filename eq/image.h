@@ -190,7 +190,10 @@ public:
     /** @return a pointer to the raw pixel data. @version 1.0 */
     EQ_API const uint8_t* getPixelPointer(const Frame::Buffer buffer) const;
 
-    /** @return a pointer to the raw pixel data. @version 1.0 */
+    /**
+     * @return a pointer to the raw, writable pixel data.
+     * @version 1.0
+     */
     EQ_API uint8_t* getPixelPointer(const Frame::Buffer buffer);
 
     /** @return the total size of the pixel data in bytes. @version 1.0 */
@@ -248,6 +251,23 @@ public:
      */
     EQ_API void setPixelData(const Frame::Buffer buffer, const PixelData& data);
 
+    /**
+     * @internal
+     * Set uncompressed pixel data without copying it.
+     *
+     * The pixels remain in the buffer of the given command, which is
+     * referenced until the pixel data is invalidated or replaced. Writable
+     * access through getPixelPointer() copies the pixels to local memory
+     * first. Compressed pixel data is decompressed as in setPixelData().
+     *
+     * @param buffer the image buffer to set.
+     * @param data the pixel data.
+     * @param owner the command owning the pixel memory.
+     */
+    EQ_API void adoptPixelData(const Frame::Buffer buffer,
+                               const PixelData& data,
+                               const co::ICommand& owner);
+
     /**
      * Set alpha data preservation during download and compression.
      * @version 1.0
@@ -414,6 +434,9 @@ private:
                             const uint32_t externalFormat,
                             const uint32_t pixelSize, const bool hasAlpha);
 
+    /** Set the format and size of the pixel data, invalidating it. */
+    void _setPixelFormat(const Frame::Buffer buffer, const PixelData& data);
+
     bool _readback(const Frame::Buffer buffer, const Zoom& zoom,
                    util::ObjectManager& glObjects);
 
@@ -176,6 +176,7 @@ Flags _getConfigFlags()
         fabric::ConfigParams::FLAG_LOAD_EQ_HORIZONTAL;
     configFlags["2D_vertical"] = fabric::ConfigParams::FLAG_LOAD_EQ_VERTICAL;
     configFlags["2D_tiles"] = fabric::ConfigParams::FLAG_LOAD_EQ_2D;
+    configFlags["auto_layout"] = fabric::ConfigParams::FLAG_AUTO_LAYOUT;
     return configFlags;
 }
 
@@ -21,6 +21,10 @@
 
 #include "client.h"
 #include "config.h"
+#include "detail/eventCoalescer.h"
+#include "detail/framePlan.h"
+#include "detail/memoryPool.h"
+#include "detail/topology.h"
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
@@ -40,9 +44,11 @@
 
 #include <co/barrier.h>
 #include <co/connection.h>
+#include <co/connectionDescription.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
 #include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
 
 namespace eq
 {
@@ -50,6 +56,9 @@ namespace
 {
 typedef std::unordered_map<uint128_t, co::Barrier*> BarrierHash;
 typedef std::unordered_map<uint128_t, FrameDataPtr> FrameDataHash;
+/** A latched head matrix and the last frame started before latching it */
+typedef std::pair<Matrix4f, uint32_t> LatchedHead;
+typedef std::unordered_map<uint128_t, LatchedHead> LatchedHeadHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
 
@@ -114,6 +123,12 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable<FrameDataHash> frameDatas;
 
+    /** The frame plans of the unfinished frames. */
+    lunchbox::Lockable<FramePlans, lunchbox::SpinLock> framePlans;
+
+    /** The newest head matrix per observer, set by Observer::latchHeadMatrix */
+    lunchbox::Lockable<LatchedHeadHash, lunchbox::SpinLock> latchedHeads;
+
     TransmitThread transmitter;
 };
 }
@@ -165,6 +180,8 @@ void Node::attach(const uint128_t& id, const uint32_t instanceID)
                     NodeFunc(this, &Node::_cmdFrameDataTransmit), commandQ);
     registerCommand(fabric::CMD_NODE_FRAMEDATA_READY,
                     NodeFunc(this, &Node::_cmdFrameDataReady), commandQ);
+    registerCommand(fabric::CMD_NODE_LATCH_HEAD,
+                    NodeFunc(this, &Node::_cmdLatchHead), commandQ);
 }
 
 void Node::setDirty(const uint64_t bits)
@@ -266,6 +283,19 @@ void Node::releaseFrameData(FrameDataPtr data)
     _impl->frameDatas->erase(i);
 }
 
+std::shared_ptr<const detail::PlannedFrame> Node::getPlannedFrame(
+    const uint32_t frameNumber, const uint128_t& frameID) const
+{
+    lunchbox::ScopedFastRead mutex(_impl->framePlans);
+    detail::FramePlans::const_iterator i =
+        _impl->framePlans->find(frameNumber);
+    if (i == _impl->framePlans->end())
+        return detail::PlannedFramePtr();
+
+    detail::FramePlan::const_iterator j = i->second.find(frameID);
+    return j == i->second.end() ? detail::PlannedFramePtr() : j->second;
+}
+
 void Node::waitInitialized() const
 {
     _impl->state.waitGE(STATE_INIT_FAILED);
@@ -295,25 +325,58 @@ bool Node::configExit()
 
 void Node::_setAffinity()
 {
-    const int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
+    co::LocalNodePtr node = getLocalNode();
+    int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
     switch (affinity)
     {
     case OFF:
-        break;
+        return;
 
     case AUTO:
-        // TODO
-        LBVERB << "No automatic thread placement for node threads "
-               << std::endl;
+    {
+        // The transmit, receiver and command threads, which send and receive
+        // compressed images, are only placed on request: on the socket of the
+        // given NUMA node, or of the network interface for AUTO.
+        const detail::Topology& topology = detail::Topology::getInstance();
+        int32_t numaNode = getIAttribute(IATTR_HINT_NUMA_NODE);
+        if (numaNode == UNDEFINED)
+        {
+            LBVERB << "No automatic thread placement for node threads "
+                   << std::endl;
+            return;
+        }
+        if (numaNode == AUTO)
+        {
+            for (co::ConnectionDescriptionPtr desc :
+                 node->getConnectionDescriptions())
+            {
+                numaNode =
+                    topology.getNICNode(desc->interfacename, desc->hostname);
+                if (numaNode >= 0)
+                    break;
+            }
+        }
+
+        affinity = numaNode < 0 ? lunchbox::Thread::NONE
+                                : topology.getAffinity(numaNode);
+        if (affinity == lunchbox::Thread::NONE)
+        {
+            LBWARN << "No thread placement for node threads, NUMA node "
+                   << numaNode << " not found" << std::endl;
+            return;
+        }
+        LBINFO << "Bound node threads to socket "
+               << affinity - lunchbox::Thread::SOCKET << " of NUMA node "
+               << numaNode << std::endl;
         break;
+    }
 
     default:
-        co::LocalNodePtr node = getLocalNode();
-        send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
-
-        node->setAffinity(affinity);
         break;
     }
+
+    send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
+    node->setAffinity(affinity);
 }
 
 void Node::waitFrameStarted(const uint32_t frameNumber) const
@@ -347,6 +410,12 @@ void Node::_finishFrame(const uint32_t frameNumber) const
 void Node::_frameFinish(const uint128_t& frameID, const uint32_t frameNumber)
 {
     frameFinish(frameID, frameNumber);
+    detail::MemoryPool::getInstance()->finishFrame();
+    {
+        lunchbox::ScopedFastWrite mutex(_impl->framePlans);
+        _impl->framePlans->erase(_impl->framePlans->begin(),
+                                 _impl->framePlans->upper_bound(frameNumber));
+    }
     LBLOG(LOG_TASKS) << "---- Finished Frame --- " << frameNumber << std::endl;
 
     if (_impl->unlockedFrame < frameNumber)
@@ -475,7 +544,7 @@ bool Node::processEvent(AxisEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_MAGELLAN_AXIS) << event;
+    detail::EventCoalescer::add(0, config, event);
     return true;
 }
 
@@ -483,7 +552,7 @@ bool Node::processEvent(ButtonEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_MAGELLAN_BUTTON) << event;
+    detail::EventCoalescer::send(0, config, EVENT_MAGELLAN_BUTTON) << event;
     return true;
 }
 
@@ -653,10 +722,27 @@ bool Node::_cmdFrameStart(co::ICommand& cmd)
     const uint128_t& configVersion = command.read<uint128_t>();
     const uint128_t& frameID = command.read<uint128_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
+    const uint32_t nPlannedFrames = command.read<uint32_t>();
 
     LBVERB << "handle node frame start " << command << " frame " << frameNumber
            << " id " << frameID << std::endl;
 
+    if (nPlannedFrames > 0)
+    {
+        detail::FramePlan plan;
+        for (uint32_t i = 0; i < nPlannedFrames; ++i)
+        {
+            const uint128_t& id = command.read<uint128_t>();
+            std::shared_ptr<detail::PlannedFrame> frame(
+                new detail::PlannedFrame);
+            frame->deserialize(command);
+            plan[id] = frame;
+        }
+
+        lunchbox::ScopedFastWrite mutex(_impl->framePlans);
+        _impl->framePlans.data[frameNumber].swap(plan);
+    }
+
     LBASSERT(_impl->currentFrame == frameNumber - 1);
 
     LBLOG(LOG_TASKS) << "----- Begin Frame ----- " << frameNumber << std::endl;
@@ -751,9 +837,9 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
 
     // Note on the const_cast: since the PixelData structure stores non-const
     // pointers, we have to go non-const at some point, even though we do not
-    // modify the data.
+    // modify the data. Uncompressed images reference the command buffer.
     LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
-                                useAlpha, const_cast<uint8_t*>(data)));
+                                useAlpha, const_cast<uint8_t*>(data), cmd));
     return true;
 }
 
@@ -776,6 +862,33 @@ bool Node::_cmdFrameDataReady(co::ICommand& cmd)
     return true;
 }
 
+bool Node::_cmdLatchHead(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    const uint128_t& observerID = command.read<uint128_t>();
+    const Matrix4f& matrix = command.read<Matrix4f>();
+    const uint32_t frameNumber = command.read<uint32_t>();
+
+    lunchbox::ScopedFastWrite mutex(_impl->latchedHeads);
+    (*_impl->latchedHeads)[observerID] = LatchedHead(matrix, frameNumber);
+    return true;
+}
+
+bool Node::getLatchedHeadMatrix(const uint128_t& observerID,
+                                const uint32_t frameNumber,
+                                Matrix4f& matrix) const
+{
+    lunchbox::ScopedFastRead mutex(_impl->latchedHeads);
+    LatchedHeadHash::const_iterator i =
+        _impl->latchedHeads->find(observerID);
+    // later frames have committed a newer head matrix
+    if (i == _impl->latchedHeads->end() || i->second.second < frameNumber)
+        return false;
+
+    matrix = i->second.first;
+    return true;
+}
+
 bool Node::_cmdSetAffinity(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
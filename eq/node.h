@@ -32,6 +32,7 @@ namespace eq
 namespace detail
 {
 class Node;
+struct PlannedFrame;
 }
 
 /**
@@ -92,6 +93,14 @@ public:
     /** @internal Release the frame data instance. */
     void releaseFrameData(FrameDataPtr data);
 
+    /**
+     * @internal
+     * @return the frame parameters sent with the given frame start, or an
+     *         empty pointer if the server does not use frame plans.
+     */
+    std::shared_ptr<const detail::PlannedFrame> getPlannedFrame(
+        uint32_t frameNumber, const uint128_t& frameID) const;
+
     /** @internal Wait for the node to be initialized. */
     EQ_API void waitInitialized() const;
 
@@ -122,6 +131,15 @@ public:
     /** @internal @return the number of the last finished frame. */
     uint32_t getFinishedFrame() const;
 
+    /**
+     * @internal
+     * @return true if a head matrix was latched for the given observer and
+     *         is newer than the head matrix committed for the given frame.
+     * @sa Observer::latchHeadMatrix()
+     */
+    bool getLatchedHeadMatrix(const uint128_t& observerID,
+                              uint32_t frameNumber, Matrix4f& matrix) const;
+
     /**
      * Send an error event to the application node.
      *
@@ -288,6 +306,7 @@ private:
     bool _cmdFrameDataTransmit(co::ICommand& command);
     bool _cmdFrameDataReady(co::ICommand& command);
     bool _cmdSetAffinity(co::ICommand& command);
+    bool _cmdLatchHead(co::ICommand& command);
 
     LB_TS_VAR(_nodeThread);
 };
@@ -173,6 +173,14 @@ bool Observer::handleEvent(EventICommand& command)
     return false;
 }
 
+void Observer::latchHeadMatrix(const Matrix4f& matrix)
+{
+    Config* config = getConfig();
+    LBASSERT(config);
+    config->send(config->getServer(), fabric::CMD_CONFIG_LATCH_HEAD)
+        << getID() << matrix << config->getCurrentFrame();
+}
+
 bool Observer::configExit()
 {
 #ifdef EQUALIZER_USE_VRPN
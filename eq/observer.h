@@ -58,6 +58,23 @@ public:
      * @return true if the event requires a redraw, false otherwise.
      */
     EQ_API virtual bool handleEvent(EventICommand& command);
+
+    /**
+     * Send the newest head matrix directly to all render nodes.
+     *
+     * The matrix does not change the head matrix of this observer and is not
+     * committed. Channels looking through this observer use the latest latched
+     * matrix to correct their frustum and head transform right before
+     * Channel::frameDraw(), which reduces the motion-to-photon latency of
+     * pipelined frames. The latched matrix applies to the frames started so
+     * far, and is ignored by later frames, which use their committed head
+     * matrix. The head matrix for the next frame still has to be set using
+     * setHeadMatrix().
+     *
+     * @param matrix the newest head matrix.
+     * @version 2.2
+     */
+    EQ_API void latchHeadMatrix(const Matrix4f& matrix);
     //@}
 
     /** @name Data Access */
@@ -28,6 +28,9 @@
 #include "channel.h"
 #include "client.h"
 #include "config.h"
+#include "detail/eventCoalescer.h"
+#include "detail/framePlan.h"
+#include "detail/topology.h"
 #include "exception.h"
 #include "frame.h"
 #include "frameData.h"
@@ -47,12 +50,16 @@
 #include <eq/fabric/elementVisitor.h>
 #include <eq/fabric/leafVisitor.h>
 #include <eq/fabric/task.h>
+#include <eq/util/uploader.h>
 
 #include <boost/lexical_cast.hpp>
 #include <co/global.h>
 #include <co/objectICommand.h>
 #include <co/queueSlave.h>
 #include <co/worker.h>
+#include <lunchbox/bitOperation.h>
+
+#include <algorithm>
 #include <sstream>
 
 #ifdef EQUALIZER_USE_HWLOC_GL
@@ -93,6 +100,16 @@ typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef ViewHash::const_iterator ViewHashCIter;
 typedef ViewHash::iterator ViewHashIter;
 typedef QueueHash::const_iterator QueueHashCIter;
+
+int32_t _getNUMANode(const Pipe& pipe)
+{
+    const Pipes& pipes = pipe.getNode()->getPipes();
+    const size_t index =
+        std::find(pipes.begin(), pipes.end(), &pipe) - pipes.begin();
+    return detail::Topology::getInstance().getPipeNode(
+        pipe.getIAttribute(Pipe::IATTR_HINT_NUMA_NODE), pipe.getDevice(),
+        index);
+}
 }
 
 namespace detail
@@ -225,6 +242,9 @@ public:
     RenderThread* thread;
 
     detail::TransferThread transferThread;
+
+    /** The asynchronous uploader, started by the application. */
+    util::Uploader uploader;
 };
 
 void RenderThread::run()
@@ -529,8 +549,28 @@ void Pipe::_setupAffinity()
     switch (affinity)
     {
     case AUTO:
-        lunchbox::Thread::setAffinity(_getAutoAffinity());
+    {
+        // An explicit NUMA node overrides the GPU locality found by hwloc. With
+        // an AUTO node the sysfs topology is a guess if hwloc knows nothing,
+        // an unset node keeps the hwloc placement only.
+        const int32_t numaNode = getIAttribute(IATTR_HINT_NUMA_NODE);
+        const int32_t gpuAffinity =
+            numaNode >= 0 ? lunchbox::Thread::NONE : _getAutoAffinity();
+        if (gpuAffinity == lunchbox::Thread::NONE && numaNode != UNDEFINED)
+        {
+            // Pipe memory, e.g. read back pixels, is first touched by this
+            // thread and therefore allocated on the same NUMA node.
+            const int32_t node = _getNUMANode(*this);
+            if (node >= 0 && detail::Topology::getInstance().bind(node))
+            {
+                LBINFO << "Bound pipe " << getName() << " to NUMA node "
+                       << node << std::endl;
+                break;
+            }
+        }
+        lunchbox::Thread::setAffinity(gpuAffinity);
         break;
+    }
 
     case OFF:
     default:
@@ -596,8 +636,26 @@ Frame* Pipe::getFrame(const co::ObjectVersion& frameVersion, const Eye eye,
 {
     LB_TS_THREAD(_pipeThread);
     Frame* frame = _impl->frames[frameVersion.identifier];
+    detail::PlannedFramePtr planned;
+    if (getConfig()->getIAttribute(Config::IATTR_FRAME_PLAN) == ON)
+    {
+        // the node thread receives the plan, not synchronized in ASYNC mode
+        const uint32_t frameNumber = getCurrentFrame();
+        getNode()->waitFrameStarted(frameNumber);
+        planned =
+            getNode()->getPlannedFrame(frameNumber, frameVersion.identifier);
+    }
 
-    if (!frame)
+    if (planned) // parameters were sent with the frame start
+    {
+        if (!frame)
+        {
+            frame = new Frame();
+            _impl->frames[frameVersion.identifier] = frame;
+        }
+        frame->setData(planned->frame);
+    }
+    else if (!frame)
     {
         ClientPtr client = getClient();
         frame = new Frame();
@@ -616,7 +674,13 @@ Frame* Pipe::getFrame(const co::ObjectVersion& frameVersion, const Eye eye,
 
     if (isOutput)
     {
-        if (!frameData->isAttached())
+        const unsigned i = lunchbox::getIndexOfLastBit(eye);
+        if (planned)
+        {
+            LBASSERT(planned->isOutput && planned->hasData[i]);
+            frameData->applyPlan(planned->datas[i]);
+        }
+        else if (!frameData->isAttached())
         {
             ClientPtr client = getClient();
             LBCHECK(client->mapObject(frameData.get(), dataVersion));
@@ -642,7 +706,8 @@ void Pipe::flushFrames(util::ObjectManager& om)
     {
         Frame* frame = i->second;
         frame->setFrameData(0); // datas are flushed below
-        client->unmapObject(frame);
+        if (frame->isAttached()) // not mapped when using frame plans
+            client->unmapObject(frame);
         delete frame;
     }
     _impl->frames.clear();
@@ -661,7 +726,8 @@ void Pipe::flushFrames(util::ObjectManager& om)
         FrameDataPtr data = i->second;
         data->resetPlugins();
         data->deleteGLObjects(om);
-        client->unmapObject(data.get());
+        if (data->isAttached())
+            client->unmapObject(data.get());
         getNode()->releaseFrameData(data);
     }
     _impl->outputFrameDatas.clear();
@@ -895,6 +961,11 @@ WindowSystem Pipe::getWindowSystem() const
     return _impl->windowSystem;
 }
 
+util::Uploader& Pipe::getUploader()
+{
+    return _impl->uploader;
+}
+
 EventOCommand Pipe::sendError(const uint32_t error)
 {
     return getConfig()->sendError(EVENT_PIPE_ERROR, Error(error, getID()));
@@ -1196,6 +1267,7 @@ bool Pipe::_cmdConfigExit(co::ICommand& cmd)
     LBLOG(LOG_INIT) << "TASK pipe config exit " << command << std::endl;
 
     _impl->state = STATE_STOPPING; // needed in View::detach (from _flushViews)
+    _impl->uploader.stop(); // normally stopped by its window
 
     // send before node gets a chance to send its destroy command
     getNode()->send(getLocalNode(), fabric::CMD_NODE_DESTROY_PIPE) << getID();
@@ -1269,6 +1341,7 @@ bool Pipe::_cmdFrameStart(co::ICommand& cmd)
     LBASSERTINFO(_impl->currentFrame + 1 == frameNumber,
                  "current " << _impl->currentFrame << " start " << frameNumber);
 
+    _impl->uploader.startFrame();
     frameStart(frameID, frameNumber);
     return true;
 }
@@ -1310,6 +1383,7 @@ bool Pipe::_cmdFrameFinish(co::ICommand& cmd)
     }
 
     _releaseViews();
+    detail::EventCoalescer::flush(); // send the events of this frame
 
     const uint128_t version = commit();
     if (version != co::VERSION_NONE)
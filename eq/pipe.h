@@ -107,6 +107,12 @@ public:
      * @version 1.0
      */
     EQ_API WindowSystem getWindowSystem() const;
+
+    /**
+     * @return the asynchronous texture and buffer uploader of this pipe.
+     * @version 2.2
+     */
+    EQ_API util::Uploader& getUploader();
     //@}
 
     /**
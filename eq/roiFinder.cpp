@@ -36,6 +36,8 @@
 #include <lunchbox/os.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+
 namespace eq
 {
 #define glewGetContext glObjects.glewGetContext
@@ -452,6 +454,84 @@ uint8_t ROIFinder::_splitArea(Area& a)
     return areasPerVariant;
 }
 
+PixelViewports ROIFinder::_dilatePrediction(
+    const PixelViewports& prediction) const
+{
+    // convert to dilated, grid-aligned block coordinates
+    const PixelViewport bounds(0, 0, _w, _h);
+    PixelViewports blocks;
+    for (const PixelViewport& region : prediction)
+    {
+        PixelViewport pvp(region.x / GRID_SIZE - _pvp.x - 1,
+                          region.y / GRID_SIZE - _pvp.y - 1,
+                          (region.w + GRID_SIZE - 1) / GRID_SIZE + 2,
+                          (region.h + GRID_SIZE - 1) / GRID_SIZE + 2);
+        pvp.intersect(bounds);
+        if (!pvp.hasArea())
+            continue;
+
+        // merge overlapping regions, which would read back pixels twice
+        for (size_t i = 0; i < blocks.size();)
+        {
+            PixelViewport overlap = blocks[i];
+            overlap.intersect(pvp);
+            if (!overlap.hasArea())
+            {
+                ++i;
+                continue;
+            }
+
+            pvp.merge(blocks[i]);
+            blocks[i] = blocks.back();
+            blocks.pop_back();
+            i = 0; // the merged region may overlap already checked ones
+        }
+        blocks.push_back(pvp);
+    }
+    return blocks;
+}
+
+bool ROIFinder::_validatePrediction(const PixelViewports& prediction,
+                                    PixelViewports& resultPVPs)
+{
+    if (prediction.empty())
+        return false;
+
+    const PixelViewports blocks = _dilatePrediction(prediction);
+
+    if (_coverage.size() < _mask.size())
+        _coverage.resize(_mask.size());
+    memset(&_coverage[0], 0, _coverage.size());
+
+    for (const PixelViewport& pvp : blocks)
+        for (int32_t y = pvp.y; y < pvp.y + pvp.h; ++y)
+            memset(&_coverage[y * _wb + pvp.x], 1, pvp.w);
+
+    // all occupied blocks have to be within the dilated regions
+    for (int32_t y = 0; y < _h; ++y)
+    {
+        const uint8_t* mask = &_mask[y * _wb];
+        const uint8_t* coverage = &_coverage[y * _wb];
+        for (int32_t x = 0; x < _w; ++x)
+            if (mask[x] && !coverage[x])
+                return false;
+    }
+
+    // shrink dilated regions to the occupied blocks of this frame
+    for (const PixelViewport& block : blocks)
+    {
+        PixelViewport pvp = _getObjectPVP(block, &_mask[0]);
+        if (!pvp.hasArea())
+            continue;
+
+        pvp.x += _pvp.x;
+        pvp.y += _pvp.y;
+        pvp.apply(Zoom(GRID_SIZE, GRID_SIZE));
+        resultPVPs.push_back(pvp);
+    }
+    return true;
+}
+
 void ROIFinder::_findAreas(PixelViewports& resultPVPs)
 {
     LBASSERT(_areasToCheck.empty());
@@ -668,11 +748,20 @@ PixelViewports ROIFinder::findRegions(const uint32_t buffers,
     // Analyze readed back data and find regions of interest
     _init();
 
-    _emptyFinder.update(&_mask[0], _wb, _hb);
-    _emptyFinder.setLimits(200, 0.002f);
-
     result.clear();
-    _findAreas(result);
+#ifdef EQ_ROI_USE_TRACKER
+    // reuse last frame's regions if they still cover the occupied blocks
+    const bool hit =
+        _validatePrediction(_roiTracker.getPrediction(ticket), result);
+    _roiTracker.updatePrediction(hit, ticket);
+    if (!hit)
+#endif
+    {
+        result.clear();
+        _emptyFinder.update(&_mask[0], _wb, _hb);
+        _emptyFinder.setLimits(200, 0.002f);
+        _findAreas(result);
+    }
 
 #ifdef EQ_ROI_USE_TRACKER
     _roiTracker.updateDelay(result, ticket);
@@ -680,4 +769,78 @@ PixelViewports ROIFinder::findRegions(const uint32_t buffers,
 
     return result;
 }
+
+PixelViewports ROIFinder::findRegions(const Image& image)
+{
+    const PixelViewport& pvp = image.getPixelViewport();
+    PixelViewports result;
+
+    const bool useDepth = image.hasPixelData(Frame::Buffer::depth);
+    const Frame::Buffer buffer =
+        useDepth ? Frame::Buffer::depth : Frame::Buffer::color;
+    if (!pvp.hasArea() || !image.hasPixelData(buffer) ||
+        image.getPixelSize(buffer) != 4)
+    {
+        result.push_back(pvp);
+        return result;
+    }
+
+    _pvpOriginal = pvp;
+    _resize(_getBoundingPVP(pvp));
+    _computeBlockInfo(image);
+    _init();
+
+    _emptyFinder.update(&_mask[0], _wb, _hb);
+    _emptyFinder.setLimits(200, 0.002f);
+    _findAreas(result);
+    return result;
+}
+
+void ROIFinder::_computeBlockInfo(const Image& image)
+{
+    const bool useDepth = image.hasPixelData(Frame::Buffer::depth);
+    const Frame::Buffer buffer =
+        useDepth ? Frame::Buffer::depth : Frame::Buffer::color;
+    const uint32_t* pixels =
+        reinterpret_cast<const uint32_t*>(image.getPixelPointer(buffer));
+    // far depth, or black ignoring alpha in RGBA and BGRA
+    const uint32_t mask = useDepth ? 0xffffffffu : 0x00ffffffu;
+    const uint32_t background = useDepth ? 0xffffffffu : 0u;
+
+    float* info = &_perBlockInfo[0];
+    for (int32_t y = 0; y < _h; ++y)
+    {
+        const int32_t yStart =
+            std::max((_pvp.y + y) * GRID_SIZE, _pvpOriginal.y) -
+            _pvpOriginal.y;
+        const int32_t yEnd = std::min((_pvp.y + y + 1) * GRID_SIZE,
+                                      _pvpOriginal.y + _pvpOriginal.h) -
+                             _pvpOriginal.y;
+
+        for (int32_t x = 0; x < _w; ++x, info += 4)
+        {
+            const int32_t xStart =
+                std::max((_pvp.x + x) * GRID_SIZE, _pvpOriginal.x) -
+                _pvpOriginal.x;
+            const int32_t xEnd = std::min((_pvp.x + x + 1) * GRID_SIZE,
+                                          _pvpOriginal.x + _pvpOriginal.w) -
+                                 _pvpOriginal.x;
+
+            bool empty = true;
+            for (int32_t i = yStart; i < yEnd && empty; ++i)
+            {
+                const uint32_t* row = pixels + i * _pvpOriginal.w;
+                for (int32_t j = xStart; j < xEnd; ++j)
+                {
+                    if ((row[j] & mask) != background)
+                    {
+                        empty = false;
+                        break;
+                    }
+                }
+            }
+            info[0] = empty ? 1.f : 0.f;
+        }
+    }
+}
 }
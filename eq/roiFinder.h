@@ -34,7 +34,7 @@ namespace eq
 class ROIFinder
 {
 public:
-    ROIFinder();
+    EQ_API ROIFinder();
     virtual ~ROIFinder() {}
     /**
      * Processes current rendering target and selects areas for read back.
@@ -53,6 +53,30 @@ public:
                                const uint128_t& frameID,
                                util::ObjectManager& glObjects);
 
+    /**
+     * Selects the areas of an image in main memory, without using OpenGL.
+     *
+     * Blocks are empty if all their pixels have the far depth value, or if the
+     * image has no depth all their pixels are black. Supports 32 bit color and
+     * depth pixels, and otherwise returns the image pixel viewport.
+     *
+     * @param image the image to analyse.
+     * @return the occupied areas, in the same coordinates as findRegions().
+     */
+    EQ_API PixelViewports findRegions(const Image& image);
+
+    /** @return the number of frames which validated the previous regions. */
+    uint64_t getPredictionHits() const
+    {
+        return _roiTracker.getPredictionHits();
+    }
+
+    /** @return the number of frames which needed a full region analysis. */
+    uint64_t getPredictionMisses() const
+    {
+        return _roiTracker.getPredictionMisses();
+    }
+
 private:
     ROIFinder(const ROIFinder&) = delete;
     ROIFinder& operator=(const ROIFinder&) = delete;
@@ -65,6 +89,9 @@ private:
         actuall read-back */
     void _readbackInfo(util::ObjectManager& glObjects);
 
+    /** Fills _perBlockInfo from the pixels of an image in main memory. */
+    void _computeBlockInfo(const Image& image);
+
     /** Clears masks, filles per-block occupancy _mask from _perBlockInfo,
         that was previously read-back from GPU in _readbackInfo */
     void _init();
@@ -84,6 +111,25 @@ private:
     /** Find areas in current mask*/
     void _findAreas(PixelViewports& resultPVPs);
 
+    /**
+     * Dilate the regions of the previous frame by one block.
+     *
+     * @return the dilated regions in block coordinates, with overlapping
+     *         regions merged.
+     */
+    PixelViewports _dilatePrediction(const PixelViewports& prediction) const;
+
+    /**
+     * Validate the regions of the previous frame against the current mask.
+     *
+     * If all occupied blocks are covered by the dilated regions, the result is
+     * the bounding box of the occupied blocks within each region.
+     *
+     * @return true if the prediction was valid, false otherwise.
+     */
+    bool _validatePrediction(const PixelViewports& prediction,
+                             PixelViewports& resultPVPs);
+
     /** Only used in debug build, to invalidate unused areas */
     void _invalidateAreas(Area* areas, uint8_t num);
 
@@ -137,6 +183,7 @@ private:
     int32_t _wbhb; //!< _wb * _wh (total number of blocks in _mask)
 
     Vectorub _mask; //!< mask of occupied blocks (main data)
+    Vectorub _coverage; //!< blocks covered by the predicted regions
 
     std::vector<float> _perBlockInfo; //!< buffer for data from GPU
 
@@ -29,6 +29,8 @@ ROITracker::Area::Area(const PixelViewport& pvp_, uint32_t lastSkip_,
 ROITracker::ROITracker()
     : _needsUpdate(false)
     , _lastStage(0)
+    , _hits(0)
+    , _misses(0)
 {
     _ticket = reinterpret_cast<uint8_t*>(this);
     _prvFrame = new std::unordered_map<uint32_t, Stage>;
@@ -108,11 +110,13 @@ bool ROITracker::useROIFinder(const PixelViewport& pvp, const uint32_t stage,
     if (match->skip == 0) // don't skip frame
     {
         curStage.areas.push_back(Area(pvp, match->lastSkip));
+        curStage.areas.back().regions = match->regions;
         return _returnPositive(ticket);
     }
     // else skip frame
 
     curStage.areas.push_back(Area(pvp, match->lastSkip, match->skip - 1));
+    curStage.areas.back().regions = match->regions;
     return false;
 }
 
@@ -132,6 +136,7 @@ void ROITracker::updateDelay(const PixelViewports& pvps, const uint8_t* ticket)
         totalAreaFound += pvps[i].getArea();
 
     Area& area = (*_curFrame)[_lastStage].areas.back();
+    area.regions = pvps;
     if (totalAreaFound < area.pvp.getArea() * 4 / 5)
     {
         // ROI cutted enough, reset failure statistics
@@ -146,4 +151,23 @@ void ROITracker::updateDelay(const PixelViewports& pvps, const uint8_t* ticket)
     }
     _needsUpdate = false;
 }
+
+const PixelViewports& ROITracker::getPrediction(const uint8_t* ticket) const
+{
+    LBASSERT(_needsUpdate);
+    LBASSERTINFO(ticket == _ticket, "Wrong ticket");
+
+    return (*_curFrame)[_lastStage].areas.back().regions;
+}
+
+void ROITracker::updatePrediction(const bool hit, const uint8_t* ticket)
+{
+    LBASSERT(_needsUpdate);
+    LBASSERTINFO(ticket == _ticket, "Wrong ticket");
+
+    if (hit)
+        ++_hits;
+    else
+        ++_misses;
+}
 }
@@ -72,6 +72,26 @@ public:
      */
     void updateDelay(const PixelViewports& pvps, const uint8_t* ticket);
 
+    /**
+     * Get the regions found for the matching area of the previous frame.
+     *
+     * Only valid between a positive useROIFinder and the corresponding
+     * updateDelay call. The returned regions are the undilated ROIFinder
+     * result of the last analysis of this area and may be empty.
+     *
+     * @param  ticket  value from useROIFinder
+     * @return the regions of the previous frame for the current area.
+     */
+    const PixelViewports& getPrediction(const uint8_t* ticket) const;
+
+    /** Count the outcome of the validation of a prediction. */
+    void updatePrediction(const bool hit, const uint8_t* ticket);
+
+    /** @return the number of predictions which passed validation. */
+    uint64_t getPredictionHits() const { return _hits; }
+    /** @return the number of predictions which failed validation. */
+    uint64_t getPredictionMisses() const { return _misses; }
+
 private:
     ROITracker(const ROITracker&) = delete;
     ROITracker& operator=(const ROITracker&) = delete;
@@ -85,6 +105,7 @@ private:
         PixelViewport pvp;
         uint32_t lastSkip; //!< Previousely skiped number of frames
         uint32_t skip;     //!< Number of frames to skip ROIFinder
+        PixelViewports regions; //!< Last ROIFinder result for this area
     };
     /** Set of readback areas per compositiong stage */
     struct Stage
@@ -103,6 +124,8 @@ private:
     bool _needsUpdate; //!< true after getDelay, false after updateDelay
     uint128_t _lastFrameID; //!< used to determine new frames
     uint32_t _lastStage;    //!< used in updateDelay to find last added area
+    uint64_t _hits;         //!< number of reused predictions
+    uint64_t _misses;       //!< number of failed predictions
 
     bool _returnPositive(uint8_t*& ticket);
 };
@@ -0,0 +1,228 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "autoLayout.h"
+
+#include "canvas.h"
+#include "channel.h"
+#include "config.h"
+#include "layout.h"
+#include "node.h"
+#include "pipe.h"
+#include "view.h"
+#include "window.h"
+
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+/** @return the destination channels of the given canvas */
+Channels _getChannels(const Config& config, const Canvas& canvas)
+{
+    Channels channels;
+    for (const Node* node : config.getNodes())
+        for (const Pipe* pipe : node->getPipes())
+            for (const Window* window : pipe->getWindows())
+                for (Channel* channel : window->getChannels())
+                    if (channel->getView() && channel->getCanvas() == &canvas)
+                        channels.push_back(channel);
+    return channels;
+}
+
+size_t _getActiveCandidate(const Canvas& canvas)
+{
+    const Layouts& candidates = canvas.getLayoutCandidates();
+    const size_t index =
+        std::find(candidates.begin(), candidates.end(),
+                  canvas.getActiveLayout()) -
+        candidates.begin();
+    return index < candidates.size() ? index : 0;
+}
+}
+
+AutoLayout::AutoLayout(Config& config, Canvas& canvas)
+    : _config(config)
+    , _canvas(canvas)
+    , _channels(_getChannels(config, canvas))
+    , _selector(canvas.getLayoutCandidates().size(),
+                _getActiveCandidate(canvas))
+    , _area(0)
+    , _areaThreshold(.2f)
+    , _listening(false)
+{
+    _selector.restart();
+    _listen(_selector.isEvaluating());
+    LBINFO << "Selecting the layout of canvas " << canvas.getName() << " from "
+           << canvas.getLayoutCandidates().size() << " candidates"
+           << std::endl;
+}
+
+AutoLayout::~AutoLayout()
+{
+    _listen(false);
+}
+
+void AutoLayout::update()
+{
+    if (!_canvas.isRunning())
+        return;
+
+    const Layout* layout = _canvas.getActiveLayout();
+    const size_t candidate = _getCandidate(layout);
+    if (candidate != _selector.getCurrent())
+    {
+        // switched by the application
+        _frames.clear();
+        _spans.clear();
+        if (candidate >= _canvas.getLayoutCandidates().size())
+        {
+            _listen(false);
+            return;
+        }
+        _selector.select(candidate);
+    }
+
+    _checkChanges(layout);
+    _addSamples();
+
+    const size_t current = _selector.getCurrent();
+    if (current != candidate)
+    {
+        const Layout* next = _canvas.getLayoutCandidates()[current];
+        const Layouts& layouts = _canvas.getLayouts();
+        const uint32_t index =
+            std::find(layouts.begin(), layouts.end(), next) - layouts.begin();
+        LBINFO << (_selector.isEvaluating() ? "Evaluating" : "Selected")
+               << " layout " << next->getName() << std::endl;
+        _canvas.selectLayout(index);
+    }
+
+    _listen(_selector.isEvaluating());
+    if (_listening)
+        _frames[_config.getCurrentFrame() + 1] = current;
+}
+
+void AutoLayout::notifyLoadData(Channel*, const uint32_t frameNumber,
+                                const Statistics& statistics, const Viewport&)
+{
+    if (_frames.find(frameNumber) == _frames.end())
+        return;
+
+    for (const Statistic& stat : statistics)
+    {
+        std::map<uint32_t, Span>::iterator i = _spans.find(frameNumber);
+        if (i == _spans.end())
+            _spans[frameNumber] = Span(stat.startTime, stat.endTime);
+        else
+        {
+            i->second.first = std::min(i->second.first, stat.startTime);
+            i->second.second = std::max(i->second.second, stat.endTime);
+        }
+    }
+}
+
+size_t AutoLayout::_getCandidate(const Layout* layout) const
+{
+    const Layouts& candidates = _canvas.getLayoutCandidates();
+    return std::find(candidates.begin(), candidates.end(), layout) -
+           candidates.begin();
+}
+
+void AutoLayout::_checkChanges(const Layout* layout)
+{
+    bool changed = false;
+
+    // The application may only name the model of the active view
+    for (const View* view : layout->getViews())
+    {
+        const std::string& model = view->getEqualizer().getModelName();
+        if (model.empty() || model == _model)
+            continue;
+
+        LBINFO << "Model changed to " << model << std::endl;
+        _model = model;
+        changed = true;
+        break;
+    }
+
+    uint64_t area = 0;
+    for (const Channel* channel : _channels)
+        if (channel->getLayout() == layout)
+            area += channel->getPixelViewport().getArea();
+
+    const float delta = float(area) - float(_area);
+    if (std::abs(delta) > _areaThreshold * float(_area))
+    {
+        if (_area != 0)
+        {
+            LBINFO << "Canvas size changed from " << _area << " to " << area
+                   << " pixels" << std::endl;
+            changed = true;
+        }
+        _area = area;
+    }
+
+    if (!changed)
+        return;
+
+    _frames.clear();
+    _spans.clear();
+    _selector.restart();
+}
+
+void AutoLayout::_listen(const bool listen)
+{
+    if (listen == _listening)
+        return;
+
+    for (Channel* channel : _channels)
+    {
+        if (listen)
+            channel->addListener(this);
+        else
+            channel->removeListener(this);
+    }
+    _listening = listen;
+    _frames.clear();
+    _spans.clear();
+}
+
+void AutoLayout::_addSamples()
+{
+    // Keep one frame of slack for the load data to arrive
+    const uint32_t finished = _config.getFinishedFrame();
+    while (!_frames.empty() && _frames.begin()->first < finished)
+    {
+        const uint32_t frame = _frames.begin()->first;
+        std::map<uint32_t, Span>::iterator i = _spans.find(frame);
+        if (i != _spans.end())
+        {
+            const float time = float(i->second.second - i->second.first);
+            _selector.addSample(_frames.begin()->second, time);
+            _spans.erase(i);
+        }
+        _frames.erase(_frames.begin());
+    }
+}
+}
+}
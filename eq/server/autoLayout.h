@@ -0,0 +1,90 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_AUTOLAYOUT_H
+#define EQSERVER_AUTOLAYOUT_H
+
+#include <eq/server/api.h>
+#include <eq/server/channelListener.h> // base class
+#include <eq/server/layoutSelector.h>  // member
+#include <eq/server/types.h>
+
+#include <map>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Activates the fastest of the candidate layouts of a canvas.
+ *
+ * The frame time of a layout is the span of the statistics of the canvas'
+ * destination channels, which includes waiting for and assembling the input
+ * frames, but not the idle time of the application. All candidates are
+ * evaluated when the config is started, and again when the model rendered by
+ * the active layout or the size of its destination channels changes by more
+ * than the area threshold. When the application activates another layout, it
+ * is used until the next evaluation, or until the application activates a
+ * candidate again if it is not a candidate.
+ *
+ * The destination channels are only observed during an evaluation, since
+ * observed channels finish each draw to deliver their statistics.
+ */
+class AutoLayout : public ChannelListener
+{
+public:
+    /** Select the layout of the given canvas in the given running config. */
+    EQSERVER_API AutoLayout(Config& config, Canvas& canvas);
+    EQSERVER_API virtual ~AutoLayout();
+
+    /** Update the selection before the next frame is started. */
+    EQSERVER_API void update();
+
+    /** Set the relative area change restarting the evaluation, .2 default. */
+    void setAreaThreshold(const float threshold) { _areaThreshold = threshold; }
+
+    /** @return the relative area change restarting the evaluation. */
+    float getAreaThreshold() const { return _areaThreshold; }
+
+    /** @sa ChannelListener::notifyLoadData */
+    void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                        const Statistics& statistics,
+                        const Viewport& region) override;
+
+private:
+    Config& _config;
+    Canvas& _canvas;
+    Channels _channels;
+    LayoutSelector _selector;
+
+    std::map<uint32_t, size_t> _frames; //!< candidate of each started frame
+    typedef std::pair<int64_t, int64_t> Span;
+    std::map<uint32_t, Span> _spans; //!< statistics span of each frame
+
+    std::string _model;
+    uint64_t _area;
+    float _areaThreshold;
+    bool _listening;
+
+    size_t _getCandidate(const Layout* layout) const;
+    void _listen(bool listen);
+    void _checkChanges(const Layout* layout);
+    void _addSamples();
+};
+}
+}
+
+#endif // EQSERVER_AUTOLAYOUT_H
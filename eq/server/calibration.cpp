@@ -0,0 +1,79 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "calibration.h"
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const float _bytesPerPixel = 4.f; // RGBA8 output frames
+}
+
+float Calibration::getCost(const Result& result)
+{
+    if (result.pixels == 0)
+        return 0.f;
+
+    const float megaPixels = float(result.pixels) * 1e-6f;
+    float cost = (result.drawTime + result.readbackTime) / megaPixels;
+    if (result.bytes > 0)
+        cost += result.transmitTime / float(result.bytes) * _bytesPerPixel *
+                1e6f;
+    return cost;
+}
+
+std::vector<float> Calibration::computeWeights(const Results& results,
+                                               const float tolerance)
+{
+    std::vector<float> weights(results.size(), 1.f);
+
+    std::vector<float> speeds;
+    for (const Result& result : results)
+    {
+        const float cost = getCost(result);
+        speeds.push_back(cost > 0.f ? 1.f / cost : 0.f);
+    }
+
+    float sum = 0.f;
+    size_t nKnown = 0;
+    float minSpeed = 0.f;
+    float maxSpeed = 0.f;
+    for (const float speed : speeds)
+    {
+        if (speed <= 0.f)
+            continue;
+        minSpeed = nKnown == 0 ? speed : std::min(minSpeed, speed);
+        maxSpeed = std::max(maxSpeed, speed);
+        sum += speed;
+        ++nKnown;
+    }
+
+    if (nKnown < 2 || maxSpeed <= minSpeed * (1.f + tolerance))
+        return weights;
+
+    const float average = sum / float(nKnown);
+    for (size_t i = 0; i < speeds.size(); ++i)
+        if (speeds[i] > 0.f)
+            weights[i] = speeds[i] / average;
+    return weights;
+}
+}
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_CALIBRATION_H
+#define EQSERVER_CALIBRATION_H
+
+#include <eq/server/api.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Derives channel resource weights from a calibration pass.
+ *
+ * Each channel renders and reads back a synthetic workload. The server then
+ * times the transmission of a probe of the read back size, which the channel
+ * answers outside of its queued frame tasks. The cost of a channel is the time
+ * to draw, read back and transmit one megapixel. The weight of a channel is its
+ * speed relative to the average channel. Channels within the tolerance of each
+ * other are considered equal, which keeps measurement noise on homogeneous
+ * clusters from biasing the load balancing.
+ */
+class Calibration
+{
+public:
+    /** The measurement of one channel. */
+    struct Result
+    {
+        Result()
+            : drawTime(0.f)
+            , readbackTime(0.f)
+            , transmitTime(0.f)
+            , pixels(0)
+            , bytes(0)
+        {
+        }
+
+        float drawTime;     //!< draw time of the workload in ms
+        float readbackTime; //!< readback time of the workload in ms
+        float transmitTime; //!< transmit time of the probe in ms
+        uint32_t pixels;    //!< number of pixels drawn and read back
+        uint64_t bytes;     //!< size of the transmitted probe
+    };
+    typedef std::vector<Result> Results;
+
+    /** @return the cost of one megapixel in ms, or 0 if unknown. */
+    EQSERVER_API static float getCost(const Result& result);
+
+    /**
+     * Compute the resource weight of each result.
+     *
+     * Unknown costs get the weight 1.
+     * @param results the measurements.
+     * @param tolerance the relative speed difference considered equal.
+     * @return the weights, with an average of 1.
+     */
+    EQSERVER_API static std::vector<float> computeWeights(
+        const Results& results, float tolerance = .1f);
+};
+}
+}
+
+#endif // EQSERVER_CALIBRATION_H
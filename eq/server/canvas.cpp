@@ -94,6 +94,13 @@ void Canvas::exit()
         _state = STATE_STOPPED;
 }
 
+void Canvas::selectLayout(const uint32_t index)
+{
+    const uint32_t oldIndex = getActiveLayoutIndex();
+    if (useLayout(index))
+        _switchLayout(oldIndex, index);
+}
+
 void Canvas::_switchLayout(const uint32_t oldIndex, const uint32_t newIndex)
 {
     if (oldIndex == newIndex)
@@ -56,6 +56,15 @@ public:
     bool isRunning() const { return _state == STATE_RUNNING; }
     /** @return true if this canvas should be deleted. */
     bool needsDelete() const { return _state == STATE_DELETE; }
+
+    /** Set the layouts activated automatically by their performance. */
+    void setLayoutCandidates(const Layouts& layouts)
+    {
+        _layoutCandidates = layouts;
+    }
+
+    /** @return the layouts activated automatically by their performance. */
+    const Layouts& getLayoutCandidates() const { return _layoutCandidates; }
     //@}
 
     /**
@@ -67,6 +76,9 @@ public:
 
     /** Schedule deletion of this canvas. */
     void postDelete();
+
+    /** Activate the given layout and distribute the change to the clients. */
+    void selectLayout(uint32_t index);
     //@}
 
 protected:
@@ -80,6 +92,8 @@ private:
         STATE_DELETE,      // next: destructor
     } _state;
 
+    Layouts _layoutCandidates;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
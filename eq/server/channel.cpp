@@ -87,6 +87,8 @@ Channel::Channel(Window* parent)
     , _segment(0)
     , _state(STATE_STOPPED)
     , _lastDrawCompound(0)
+    , _resourceWeight(1.f)
+    , _calibrationTime(0)
     , _private(0)
 {
     const Global* global = Global::instance();
@@ -109,6 +111,8 @@ Channel::Channel(const Channel& from)
     , _segment(0)
     , _state(STATE_STOPPED)
     , _lastDrawCompound(0)
+    , _resourceWeight(1.f)
+    , _calibrationTime(0)
     , _private(0)
 {
     // Don't copy view and segment. Will be re-set by segment copy ctor
@@ -127,6 +131,10 @@ void Channel::attach(const uint128_t& id, const uint32_t instanceID)
                     CmdFunc(this, &Channel::_cmdConfigExitReply), cmdQ);
     registerCommand(fabric::CMD_CHANNEL_FRAME_FINISH_REPLY,
                     CmdFunc(this, &Channel::_cmdFrameFinishReply), mainQ);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE_REPLY,
+                    CmdFunc(this, &Channel::_cmdCalibrateReply), mainQ);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE_PROBE_REPLY,
+                    CmdFunc(this, &Channel::_cmdCalibrateProbeReply), mainQ);
 }
 
 Channel::~Channel()
@@ -139,6 +147,10 @@ void Channel::postDelete()
     // command invokation after channel deletion
     registerCommand(fabric::CMD_CHANNEL_FRAME_FINISH_REPLY,
                     CmdFunc(this, &Channel::_cmdNop), 0);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE_REPLY,
+                    CmdFunc(this, &Channel::_cmdNop), 0);
+    registerCommand(fabric::CMD_CHANNEL_CALIBRATE_PROBE_REPLY,
+                    CmdFunc(this, &Channel::_cmdNop), 0);
 }
 
 Config* Channel::getConfig()
@@ -414,6 +426,12 @@ bool Channel::update(const uint128_t& frameID, const uint32_t frameNumber)
     return updated;
 }
 
+void Channel::calibrate()
+{
+    _calibration = Calibration::Result();
+    send(fabric::CMD_CHANNEL_CALIBRATE);
+}
+
 co::ObjectOCommand Channel::send(const uint32_t cmd)
 {
     return getNode()->send(cmd, getID());
@@ -439,9 +457,9 @@ void Channel::removeListener(ChannelListener* listener)
         _listeners.erase(i);
 }
 
-void Channel::_fireLoadData(const uint32_t frameNumber,
-                            const fabric::Statistics& statistics,
-                            const Viewport& region)
+void Channel::fireLoadData(const uint32_t frameNumber,
+                           const fabric::Statistics& statistics,
+                           const Viewport& region)
 {
     LB_TS_SCOPED(_serverThread);
     for (ChannelListener* listener : _listeners)
@@ -480,7 +498,42 @@ bool Channel::_cmdFrameFinishReply(co::ICommand& cmd)
     const uint32_t frameNumber = command.read<uint32_t>();
     const Statistics& statistics = command.read<Statistics>();
 
-    _fireLoadData(frameNumber, statistics, region);
+    fireLoadData(frameNumber, statistics, region);
+    return true;
+}
+
+bool Channel::_cmdCalibrateReply(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    _calibration.drawTime = command.read<float>();
+    _calibration.readbackTime = command.read<float>();
+    _calibration.pixels = command.read<uint32_t>();
+    _calibration.bytes = command.read<uint64_t>();
+
+    if (_calibration.bytes == 0)
+    {
+        getConfig()->addCalibration(this, _calibration);
+        return true;
+    }
+
+    // Time the transmission of the read back size separately, since the round
+    // trip of the calibration includes waiting for queued frame tasks.
+    _calibrationTime = getServer()->getTime();
+    send(fabric::CMD_CHANNEL_CALIBRATE_PROBE) << _calibration.bytes;
+    return true;
+}
+
+bool Channel::_cmdCalibrateProbeReply(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    _calibration.transmitTime =
+        float(getServer()->getTime() - _calibrationTime);
+
+    LBLOG(LOG_INIT) << "Calibrated " << getName() << ": draw "
+                    << _calibration.drawTime << " readback "
+                    << _calibration.readbackTime << " transmit "
+                    << _calibration.transmitTime << " ms" << std::endl;
+    getConfig()->addCalibration(this, _calibration);
     return true;
 }
 
@@ -512,8 +565,11 @@ void Channel::output(std::ostream& os) const
 
         os << (i == IATTR_HINT_STATISTICS
                    ? "hint_statistics   "
-                   : i == IATTR_HINT_SENDTOKEN ? "hint_sendtoken    "
-                                               : "ERROR ")
+                   : i == IATTR_HINT_SENDTOKEN
+                         ? "hint_sendtoken    "
+                         : i == IATTR_HINT_READBACK_DEPTH
+                               ? "hint_readback_depth "
+                               : "ERROR ")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
     for (SAttribute i = static_cast<SAttribute>(0); i < SATTR_LAST;
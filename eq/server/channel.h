@@ -19,7 +19,8 @@
 #ifndef EQSERVER_CHANNEL_H
 #define EQSERVER_CHANNEL_H
 
-#include "state.h" // enum
+#include "calibration.h" // member
+#include "state.h"       // enum
 #include "types.h"
 #include <eq/server/api.h>
 
@@ -123,6 +124,17 @@ public:
         _lastDrawCompound = compound;
     }
     const Compound* getLastDrawCompound() const { return _lastDrawCompound; }
+
+    /**
+     * Set the relative speed of this channel.
+     *
+     * The weight splits the static 2D and DB compounds, and the load and tree
+     * equalizers until they have load data.
+     */
+    void setResourceWeight(const float weight) { _resourceWeight = weight; }
+
+    /** @return the relative speed of this channel, 1 by default. */
+    float getResourceWeight() const { return _resourceWeight; }
     void setIAttribute(const IAttribute attr, const int32_t value)
     {
         fabric::Channel<Window, Channel>::setIAttribute(attr, value);
@@ -159,6 +171,13 @@ public:
      */
     bool update(const uint128_t& frameID, const uint32_t frameNumber);
 
+    /**
+     * Start the calibration of this channel.
+     *
+     * The result is passed to Config::addCalibration() asynchronously.
+     */
+    void calibrate();
+
     co::ObjectOCommand send(const uint32_t cmd);
     //@}
 
@@ -170,6 +189,9 @@ public:
     void removeListener(ChannelListener* listener);
     /** @return true if the channel has listeners */
     bool hasListeners() const { return !_listeners.empty(); }
+    /** @internal Notify all listeners of new load data. */
+    void fireLoadData(const uint32_t frameNumber, const Statistics& statistics,
+                      const Viewport& region);
     //@}
 
     bool omitOutput() const;          //!< @internal
@@ -198,6 +220,15 @@ private:
     /** The last draw compound for this entity */
     const Compound* _lastDrawCompound;
 
+    /** The relative speed of this channel. */
+    float _resourceWeight;
+
+    /** The pending calibration result. */
+    Calibration::Result _calibration;
+
+    /** The server time when the calibration probe was sent. */
+    int64_t _calibrationTime;
+
     typedef std::vector<ChannelListener*> ChannelListeners;
     ChannelListeners _listeners;
 
@@ -211,13 +242,12 @@ private:
 
     void _setupRenderContext(const uint128_t& frameID, RenderContext& context);
 
-    void _fireLoadData(const uint32_t frameNumber, const Statistics& statistics,
-                       const Viewport& region);
-
     /* command handler functions. */
     bool _cmdConfigInitReply(co::ICommand& command);
     bool _cmdConfigExitReply(co::ICommand& command);
     bool _cmdFrameFinishReply(co::ICommand& command);
+    bool _cmdCalibrateReply(co::ICommand& command);
+    bool _cmdCalibrateProbeReply(co::ICommand& command);
     bool _cmdNop(co::ICommand& /*command*/) { return true; }
     virtual void updateCapabilities();
 };
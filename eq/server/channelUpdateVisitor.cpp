@@ -344,7 +344,10 @@ void ChannelUpdateVisitor::_updateFrameRate(const Compound* compound) const
     Window* window = _channel->getWindow();
 
     if (maxFPS < window->getMaxFPS())
+    {
         window->setMaxFPS(maxFPS);
+        window->setFrameOffset(compound->getInheritFrameOffset());
+    }
 }
 
 uint32_t ChannelUpdateVisitor::_getDrawBuffer(const Compound* compound) const
@@ -142,6 +142,7 @@ Compound::Data::Data()
     , period(LB_UNDEFINED_UINT32)
     , phase(LB_UNDEFINED_UINT32)
     , maxFPS(std::numeric_limits<float>::max())
+    , frameOffset(0.f)
 {
     const Global* global = Global::instance();
     for (int i = 0; i < IATTR_ALL; ++i)
@@ -689,6 +690,8 @@ void Compound::_computePerspective(RenderContext& context,
     _computeFrustumCorners(context.frustum, frustumData, eye, false);
     _computeHeadTransform(context.headTransform, frustumData.getTransform(),
                           eye);
+    context.eyeWall = eye;
+    context.frustumType = frustumData.getType();
 
     const bool isHMD = (frustumData.getType() != Wall::TYPE_FIXED);
     if (isHMD)
@@ -1328,6 +1331,7 @@ void Compound::_updateInheritNode()
         _inherit.phase = _data.phase;
 
     _inherit.maxFPS = _data.maxFPS;
+    _inherit.frameOffset = _data.frameOffset;
 
     if (_data.buffers != Frame::Buffer::undefined)
         _inherit.buffers = _data.buffers;
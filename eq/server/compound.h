@@ -213,6 +213,9 @@ public:
     const Zoom& getZoom() const { return _data.zoom; }
     void setMaxFPS(const float fps) { _data.maxFPS = fps; }
     float getMaxFPS() const { return _data.maxFPS; }
+    /** Set the offset in ms of the frame pacing grid of the max FPS. */
+    void setFrameOffset(const float offset) { _data.frameOffset = offset; }
+    float getFrameOffset() const { return _data.frameOffset; }
     void setUsage(const float usage)
     {
         LBASSERT(usage >= 0.f);
@@ -309,6 +312,7 @@ public:
     {
         return _inherit.pvp;
     }
+    const Viewport& getInheritViewport() const { return _inherit.vp; }
     const Range& getInheritRange() const { return _inherit.range; }
     const Pixel& getInheritPixel() const { return _inherit.pixel; }
     const SubPixel& getInheritSubPixel() const { return _inherit.subPixel; }
@@ -316,6 +320,7 @@ public:
     uint32_t getInheritPeriod() const { return _inherit.period; }
     uint32_t getInheritPhase() const { return _inherit.phase; }
     float getInheritMaxFPS() const { return _inherit.maxFPS; }
+    float getInheritFrameOffset() const { return _inherit.frameOffset; }
     int32_t getInheritIAttribute(const IAttribute attr) const
     {
         return _inherit.iAttributes[attr];
@@ -530,6 +535,7 @@ private:
         uint32_t phase;
         int32_t iAttributes[IATTR_ALL];
         float maxFPS;
+        float frameOffset;
 
         // compound activation per eye
         uint32_t active[fabric::NUM_EYES];
@@ -19,6 +19,7 @@
 
 #include "config.h"
 
+#include "autoLayout.h"
 #include "canvas.h"
 #include "changeLatencyVisitor.h"
 #include "compound.h"
@@ -27,6 +28,7 @@
 #include "equalizers/equalizer.h"
 #include "global.h"
 #include "layout.h"
+#include "loadTrace.h"
 #include "log.h"
 #include "node.h"
 #include "observer.h"
@@ -39,18 +41,27 @@
 #include <eq/fabric/event.h>
 #include <eq/fabric/iAttribute.h>
 #include <eq/fabric/paths.h>
+#include <eq/fabric/statistic.h>
 
 #include <co/objectICommand.h>
 
 #include <boost/foreach.hpp>
 #include <lunchbox/sleep.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
 #include "channelStopFrameVisitor.h"
 #include "configDeregistrator.h"
 #include "configRegistrator.h"
 #include "configUpdateSyncVisitor.h"
 #include "configUpdateVisitor.h"
 #include "nodeFailedVisitor.h"
+#ifdef EQUALIZER_USE_HWSD
+#include "config/resources.h"
+#endif
 
 namespace eq
 {
@@ -68,6 +79,8 @@ Config::Config(ServerPtr parent)
     , _state(STATE_UNUSED)
     , _needsFinish(false)
     , _lastCheck(0)
+    , _loadRecorder(0)
+    , _nPendingCalibrations(0)
     , _private(0)
 {
     const Global* global = Global::instance();
@@ -85,6 +98,8 @@ Config::Config(ServerPtr parent)
 
 Config::~Config()
 {
+    _deleteAutoLayouts();
+    delete _loadRecorder;
     while (!_compounds.empty())
     {
         Compound* compound = _compounds.back();
@@ -116,6 +131,10 @@ void Config::attach(const uint128_t& id, const uint32_t instanceID)
                     ConfigFunc(this, &Config::_cmdFinishAllFrames), mainQ);
     registerCommand(fabric::CMD_CONFIG_CHECK_FRAME,
                     ConfigFunc(this, &Config::_cmdCheckFrame), mainQ);
+    registerCommand(fabric::CMD_CONFIG_LATCH_HEAD,
+                    ConfigFunc(this, &Config::_cmdLatchHead), mainQ);
+    registerCommand(fabric::CMD_CONFIG_CALIBRATE,
+                    ConfigFunc(this, &Config::_cmdCalibrate), mainQ);
 }
 
 namespace
@@ -173,6 +192,51 @@ public:
         return TRAVERSE_CONTINUE;
     }
 };
+
+class EqualizerStateVisitor : public ConfigVisitor
+{
+public:
+    EqualizerStateVisitor(EqualizerStore& store, const bool save)
+        : _store(store)
+        , _save(save)
+    {
+    }
+
+    // No need to go down on nodes.
+    VisitorResult visitPre(Node*) override { return TRAVERSE_PRUNE; }
+    VisitorResult visit(Compound* compound) override
+    {
+        for (Equalizer* equalizer : compound->getEqualizers())
+        {
+            if (_save)
+                equalizer->saveState(_store);
+            else
+                equalizer->loadState(_store);
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    EqualizerStore& _store;
+    const bool _save;
+};
+
+class RunningChannelsVisitor : public ConfigVisitor
+{
+public:
+    VisitorResult visit(Channel* channel) override
+    {
+        if (channel->isRunning())
+            _channels.push_back(channel);
+        return TRAVERSE_CONTINUE;
+    }
+
+    VisitorResult visitPre(Compound*) override { return TRAVERSE_PRUNE; }
+    const Channels& getChannels() const { return _channels; }
+
+private:
+    Channels _channels;
+};
 }
 
 const Channel* Config::findChannel(const std::string& name) const
@@ -546,6 +610,12 @@ EventOCommand Config::sendError(const uint32_t type, const Error& error)
     return Super::sendError(findApplicationNetNode(), type, error);
 }
 
+void Config::sendStatistic(const Statistic& statistic)
+{
+    EventOCommand cmd(send(findApplicationNetNode(), fabric::CMD_CONFIG_EVENT));
+    cmd << EVENT_STATISTIC << statistic;
+}
+
 //---------------------------------------------------------------------------
 // update running entities (init/exit/runtime change)
 //---------------------------------------------------------------------------
@@ -583,28 +653,103 @@ bool Config::_updateRunning(const bool canFail)
     return result;
 }
 
+namespace
+{
+/** Call func for each index below size, using up to nThreads threads. */
+template <class F>
+void _runParallel(const size_t size, const int32_t nThreads, const F& func)
+{
+    if (size == 0)
+        return;
+
+    std::atomic<size_t> next(0);
+    auto run = [&] {
+        for (size_t i = next++; i < size; i = next++)
+            func(i);
+    };
+
+    std::vector<std::thread> threads;
+    const size_t nExtra = std::min(size, size_t(std::max(nThreads, 1))) - 1;
+    for (size_t i = 0; i < nExtra; ++i)
+        threads.emplace_back(run);
+    run();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+}
+
 bool Config::_connectNodes()
 {
-    bool success = true;
-    lunchbox::Clock clock;
-    const Nodes& nodes = getNodes();
-    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    Nodes nodes;
+    Nodes renderNodes;
+    for (Node* node : getNodes())
     {
-        Node* node = *i;
         if (!node->isActive())
             continue;
+        if (node->isApplicationNode())
+            nodes.push_back(node);
+        else
+            renderNodes.push_back(node);
+    }
 
-        if (!node->connect())
-            success = false;
+    const int32_t fanout = getIAttribute(IATTR_LAUNCH_FANOUT);
+    if (fanout < 2)
+    {
+        nodes.insert(nodes.end(), renderNodes.begin(), renderNodes.end());
+        return _connectNodes(nodes, Nodes(nodes.size(), 0));
     }
 
-    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    // Tree launch: the server launches the first fanout render nodes, render
+    // node i launches the render nodes fanout*(i+1) to fanout*(i+2)-1.
+    bool success = true;
+    size_t begin = 0;
+    size_t levelSize = fanout;
+    do
     {
-        Node* node = *i;
-        if (node->isActive() && !node->syncLaunch(clock))
+        const size_t end = std::min(begin + levelSize, renderNodes.size());
+        Nodes launchers;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const size_t parent = i / fanout;
+            launchers.push_back(parent == 0 ? 0 : renderNodes[parent - 1]);
+        }
+        nodes.insert(nodes.end(), renderNodes.begin() + begin,
+                     renderNodes.begin() + end);
+        launchers.insert(launchers.begin(), nodes.size() - launchers.size(),
+                         0);
+
+        if (!_connectNodes(nodes, launchers))
             success = false;
-    }
+        nodes.clear();
+        begin = end;
+        levelSize *= fanout;
+    } while (begin < renderNodes.size());
+    return success;
+}
 
+bool Config::_connectNodes(const Nodes& nodes, const Nodes& launchers)
+{
+    LBASSERT(nodes.size() == launchers.size());
+    const int32_t nThreads = getIAttribute(IATTR_LAUNCH_THREADS);
+    std::atomic<bool> success(true);
+
+    _runParallel(nodes.size(), nThreads, [&](const size_t i) {
+        if (!nodes[i]->connect(launchers[i]))
+            success = false;
+    });
+
+    // one launch command for all children of a launching node
+    std::map<const Node*, Nodes> launches;
+    for (Node* node : nodes)
+        if (node->getLauncher())
+            launches[node->getLauncher()].push_back(node);
+    for (const auto& launch : launches)
+        launch.first->launch(launch.second);
+
+    _runParallel(nodes.size(), nThreads, [&](const size_t i) {
+        if (!nodes[i]->syncLaunch())
+            success = false;
+    });
     return success;
 }
 
@@ -817,11 +962,86 @@ bool Config::_init(const uint128_t& initID)
     UpdateEqualizersVisitor updater;
     accept(updater);
 
+    const char* trace = getenv("EQ_SERVER_LOAD_TRACE");
+    if (trace)
+        _loadRecorder = new LoadRecorder(*this, trace);
+
+    // Warm-start all equalizers, including the ones of inactive layouts
+    const char* state = getenv("EQ_SERVER_EQUALIZER_STATE");
+    if (state)
+        _equalizerStore.load(state);
+    EqualizerStateVisitor loader(_equalizerStore, false);
+    accept(loader);
+
+    _nPendingCalibrations = 0;
+    if (getenv("EQ_SERVER_CALIBRATE"))
+        calibrate();
+
+    for (auto canvas : getCanvases())
+        if (canvas->getLayoutCandidates().size() > 1)
+            _autoLayouts.push_back(new AutoLayout(*this, *canvas));
+
     _needsFinish = false;
     _state = STATE_RUNNING;
     return true;
 }
 
+void Config::_deleteAutoLayouts()
+{
+    for (AutoLayout* autoLayout : _autoLayouts)
+        delete autoLayout;
+    _autoLayouts.clear();
+}
+
+//---------------------------------------------------------------------------
+// calibration
+//---------------------------------------------------------------------------
+void Config::calibrate()
+{
+    if (_nPendingCalibrations > 0)
+    {
+        LBWARN << "Ignoring calibration request, calibration running"
+               << std::endl;
+        return;
+    }
+
+    RunningChannelsVisitor visitor;
+    accept(visitor);
+    _calibrating = visitor.getChannels();
+    _calibrations.assign(_calibrating.size(), Calibration::Result());
+    _nPendingCalibrations = _calibrating.size();
+
+    for (Channel* channel : _calibrating)
+        channel->calibrate();
+}
+
+void Config::addCalibration(Channel* channel,
+                            const Calibration::Result& result)
+{
+    ChannelsCIter i =
+        std::find(_calibrating.begin(), _calibrating.end(), channel);
+    if (_nPendingCalibrations == 0 || i == _calibrating.end())
+        return; // stale reply after exit or re-init
+
+    _calibrations[i - _calibrating.begin()] = result;
+    if (--_nPendingCalibrations > 0)
+        return;
+
+    const std::vector<float>& weights =
+        Calibration::computeWeights(_calibrations);
+    for (size_t j = 0; j < _calibrating.size(); ++j)
+    {
+        LBINFO << "Channel " << _calibrating[j]->getName()
+               << " resource weight " << weights[j] << std::endl;
+        _calibrating[j]->setResourceWeight(weights[j]);
+    }
+#ifdef EQUALIZER_USE_HWSD
+    config::Resources::applyWeights(this);
+#endif
+    _calibrating.clear();
+    _calibrations.clear();
+}
+
 //---------------------------------------------------------------------------
 // exit
 //---------------------------------------------------------------------------
@@ -833,6 +1053,17 @@ bool Config::exit()
     LBASSERT(_state == STATE_RUNNING || _state == STATE_INITIALIZING);
     _state = STATE_EXITING;
 
+    delete _loadRecorder;
+    _loadRecorder = 0;
+    _nPendingCalibrations = 0;
+    _deleteAutoLayouts();
+
+    EqualizerStateVisitor saver(_equalizerStore, true);
+    accept(saver);
+    const char* state = getenv("EQ_SERVER_EQUALIZER_STATE");
+    if (state)
+        _equalizerStore.save(state);
+
     const Canvases& canvases = getCanvases();
     for (Canvases::const_iterator i = canvases.begin(); i != canvases.end();
          ++i)
@@ -883,6 +1114,8 @@ void Config::_startFrame(const uint128_t& frameID)
         Compound* compound = *i;
         compound->update(_currentFrame);
     }
+    if (_loadRecorder)
+        _loadRecorder->recordSplits(_currentFrame);
 
     ConfigUpdateDataVisitor configDataVisitor;
     accept(configDataVisitor);
@@ -1036,6 +1269,9 @@ bool Config::_cmdUpdate(co::ICommand& cmd)
     const uint32_t finishID = command.read<uint32_t>();
 
     sync();
+    if (_state == STATE_RUNNING)
+        for (AutoLayout* autoLayout : _autoLayouts)
+            autoLayout->update();
     commit();
 
     co::NodePtr node = command.getRemoteNode();
@@ -1121,6 +1357,36 @@ bool Config::_cmdCreateReply(co::ICommand& cmd)
     return true;
 }
 
+bool Config::_cmdLatchHead(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    const uint128_t& observerID = command.read<uint128_t>();
+    const Matrix4f& matrix = command.read<Matrix4f>();
+    const uint32_t frameNumber = command.read<uint32_t>();
+
+    // forward directly, bypassing the config commit of the observer
+    const Nodes& nodes = getNodes();
+    for (Node* node : nodes)
+    {
+        if (!node->isRunning() || !node->isActive())
+            continue;
+
+        node->send(fabric::CMD_NODE_LATCH_HEAD) << observerID << matrix
+                                                << frameNumber;
+        node->flushSendBuffer();
+    }
+    return true;
+}
+
+bool Config::_cmdCalibrate(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    LBVERB << "handle calibrate " << command << std::endl;
+
+    calibrate();
+    return true;
+}
+
 bool Config::_cmdCheckFrame(co::ICommand& cmd)
 {
     const int64_t lastInterval = getServer()->getTime() - _lastCheck;
@@ -20,8 +20,10 @@
 #ifndef EQSERVER_CONFIG_H
 #define EQSERVER_CONFIG_H
 
+#include "calibration.h" // member
 #include "server.h" // used in inline method
 #include "state.h"  // enum
+#include "equalizers/equalizerStore.h" // member
 #include "types.h"
 #include "visitorResult.h" // enum
 #include <eq/server/api.h>
@@ -185,6 +187,23 @@ public:
 
     EventOCommand sendError(const uint32_t type, const Error& error);
 
+    /** Send a statistic event to the application. */
+    void sendStatistic(const Statistic& statistic);
+
+    /** @return the balancing state of all equalizers. */
+    EqualizerStore& getEqualizerStore() { return _equalizerStore; }
+
+    /**
+     * Start the calibration of all running channels.
+     *
+     * Once all channels have replied, their resource weights are updated from
+     * the results, and the static 2D and DB compounds are split accordingly.
+     */
+    void calibrate();
+
+    /** @internal Add the calibration result of the given channel. */
+    void addCalibration(Channel* channel, const Calibration::Result& result);
+
     /** Return the initID, used for late initialization  */
     uint128_t getInitID() { return _initID; }
     /** Activate the given canvas after it is complete (dest channels). */
@@ -202,6 +221,8 @@ public:
     void postNeedsFinish() { _needsFinish = true; }
     /** @internal @return the last finished frame */
     uint32_t getFinishedFrame() const { return _finishedFrame.get(); }
+    /** @internal @return the last started frame */
+    uint32_t getCurrentFrame() const { return _currentFrame; }
     /** @internal */
     virtual VisitorResult _acceptCompounds(ConfigVisitor& visitor);
     /** @internal */
@@ -256,6 +277,24 @@ private:
 
     int64_t _lastCheck;
 
+    /** Records channel loads if EQ_SERVER_LOAD_TRACE is set. */
+    LoadRecorder* _loadRecorder;
+
+    /** Equalizer state, persistent if EQ_SERVER_EQUALIZER_STATE is set. */
+    EqualizerStore _equalizerStore;
+
+    /** The channels of the running calibration. */
+    Channels _calibrating;
+
+    /** The calibration results received so far, indexed like _calibrating. */
+    Calibration::Results _calibrations;
+
+    /** The number of pending calibration results. */
+    size_t _nPendingCalibrations;
+
+    /** Selects the layout of canvases with layout candidates. */
+    AutoLayouts _autoLayouts;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -268,8 +307,7 @@ private:
 
     void _updateCanvases();
     bool _connectNodes();
-    bool _connectNode(Node* node);
-    bool _syncConnectNode(Node* node, const lunchbox::Clock& clock);
+    bool _connectNodes(const Nodes& nodes, const Nodes& launchers);
     void _startNodes();
     lunchbox::Request<void> _createConfig(Node* node);
     bool _updateNodes(const bool canFail);
@@ -279,6 +317,7 @@ private:
     void _syncClock();
     void _verifyFrameFinished(const uint32_t frameNumber);
     bool _init(const uint128_t& initID);
+    void _deleteAutoLayouts();
 
     void _startFrame(const uint128_t& frameID);
     void _flushAllFrames();
@@ -305,6 +344,8 @@ private:
     bool _cmdCreateReply(co::ICommand& command);
     bool _cmdFreezeLoadBalancing(co::ICommand& command);
     bool _cmdCheckFrame(co::ICommand& command);
+    bool _cmdLatchHead(co::ICommand& command);
+    bool _cmdCalibrate(co::ICommand& command);
 
     LB_TS_VAR(_cmdThread);
     LB_TS_VAR(_mainThread);
@@ -168,6 +168,10 @@ void Display::discoverLocal(Config* config, const ConfigParams& params)
     else
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_SIMPLE);
 
+    const bool autoLayout =
+        scalability &&
+        (params.getFlags() & fabric::ConfigParams::FLAG_AUTO_LAYOUT);
+    Layouts candidates;
     for (StringsCIter i = names.begin(); i != names.end(); ++i)
     {
         Layout* layout = new Layout(config);
@@ -178,7 +182,15 @@ void Display::discoverLocal(Config* config, const ConfigParams& params)
         view->setWall(wall);
 
         canvas->addLayout(layout);
+
+        // Subpixel changes the image and DPlex the latency, don't select them
+        if (autoLayout && *i != EQ_SERVER_CONFIG_LAYOUT_SUBPIXEL &&
+            *i != EQ_SERVER_CONFIG_LAYOUT_DPLEX)
+        {
+            candidates.push_back(layout);
+        }
     }
+    canvas->setLayoutCandidates(candidates);
 
     config->activateCanvas(canvas);
 }
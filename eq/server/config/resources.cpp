@@ -269,23 +269,47 @@ const Compounds& _addSources(Compound* compound, const Channels& channels,
     return compound->getChildren();
 }
 
-void _fill2DCompound(Compound* compound, const Channels& channels)
+/**
+ * @return the start of each child and the end of the last one in [0, 100000],
+ *         proportional to the resource weight of the child's channel.
+ */
+std::vector<size_t> _getStarts(const Compounds& children)
 {
-    const Compounds& children = _addSources(compound, channels);
-    const size_t step = size_t(100000.0f / float(children.size()));
-    size_t start = 0;
-    for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
+    float total = 0.f;
+    for (const Compound* child : children)
+        total += child->getChannel()->getResourceWeight();
+
+    std::vector<size_t> starts;
+    float start = 0.f;
+    for (const Compound* child : children)
     {
-        Compound* child = *i;
-        if (i + 1 == children.end()) // last - correct rounding 'error'
-            child->setViewport(
-                fabric::Viewport(float(start) / 100000.f, 0.f,
-                                 (100000.f - float(start)) / 100000.f, 1.f));
-        else
-            child->setViewport(fabric::Viewport(float(start) / 100000.f, 0.f,
-                                                float(step) / 100000.f, 1.f));
-        start += step;
+        starts.push_back(size_t(100000.f * start / total));
+        start += child->getChannel()->getResourceWeight();
     }
+    starts.push_back(100000); // last - correct rounding 'error'
+    return starts;
+}
+
+void _setViewports(const Compounds& children)
+{
+    const std::vector<size_t>& starts = _getStarts(children);
+    for (size_t i = 0; i < children.size(); ++i)
+        children[i]->setViewport(
+            fabric::Viewport(float(starts[i]) / 100000.f, 0.f,
+                             float(starts[i + 1] - starts[i]) / 100000.f, 1.f));
+}
+
+void _setRanges(const Compounds& children)
+{
+    const std::vector<size_t>& starts = _getStarts(children);
+    for (size_t i = 0; i < children.size(); ++i)
+        children[i]->setRange(Range(float(starts[i]) / 100000.f,
+                                    float(starts[i + 1]) / 100000.f));
+}
+
+void _fill2DCompound(Compound* compound, const Channels& channels)
+{
+    _setViewports(_addSources(compound, channels));
 }
 
 Compound* _add2DCompound(Compound* root, const Channels& channels,
@@ -324,20 +348,7 @@ Compound* _addDBCompound(Compound* root, const Channels& channels,
         compound->addEqualizer(new LoadEqualizer(params.getEqualizer()));
     }
 
-    const Compounds& children = _addSources(compound, channels);
-    const size_t step = size_t(100000.0f / float(children.size()));
-    size_t start = 0;
-    for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
-    {
-        Compound* child = *i;
-        if (i + 1 == children.end()) // last - correct rounding 'error'
-            child->setRange(Range(float(start) / 100000.f, 1.f));
-        else
-            child->setRange(
-                Range(float(start) / 100000.f, float(start + step) / 100000.f));
-        start += step;
-    }
-
+    _setRanges(_addSources(compound, channels));
     return compound;
 }
 
@@ -900,6 +911,21 @@ private:
     const PixelViewport& _pvp;
     Channels _channels;
 };
+
+class ApplyWeightsVisitor : public ConfigVisitor
+{
+public:
+    VisitorResult visitPre(Node*) final { return TRAVERSE_PRUNE; }
+    VisitorResult visit(Compound* compound) final
+    {
+        const std::string& name = compound->getName();
+        if (name == EQ_SERVER_CONFIG_LAYOUT_2D_STATIC)
+            _setViewports(compound->getChildren());
+        else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_STATIC)
+            _setRanges(compound->getChildren());
+        return TRAVERSE_CONTINUE;
+    }
+};
 }
 
 Channels Resources::configureSourceChannels(Config* config)
@@ -929,6 +955,12 @@ Channels Resources::configureSourceChannels(Config* config)
     return addSources.getChannels();
 }
 
+void Resources::applyWeights(Config* config)
+{
+    ApplyWeightsVisitor visitor;
+    config->accept(visitor);
+}
+
 #if 0 // LB_GCC_4_5_OR_LATER
 #pragma GCC diagnostic ignored "-Wunused-but-set-variable"
 #endif
@@ -51,6 +51,9 @@ public:
     static void configure(const Compounds& compounds, const Channels& channels,
                           const fabric::ConfigParams& params);
     static void configureWall(Config* config, const Channels& channels);
+
+    /** Split the static 2D and DB compounds by channel resource weight. */
+    static void applyWeights(Config* config);
 };
 
 enum class DemoMode
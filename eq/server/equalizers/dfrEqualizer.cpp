@@ -21,6 +21,7 @@
 #include "../compoundVisitor.h"
 #include "../config.h"
 #include "../log.h"
+#include "equalizerStore.h"
 
 #include <eq/fabric/statistic.h>
 #include <eq/fabric/zoom.h>
@@ -111,6 +112,37 @@ void DFREqualizer::notifyUpdatePre(Compound* compound, const uint32_t /*frame*/)
     compound->setZoom(newZoom);
 }
 
+void DFREqualizer::saveState(EqualizerStore& store) const
+{
+    const Compound* compound = getCompound();
+    if (!compound || _lastTime == 0) // not used in this run
+        return;
+
+    EqualizerStore::State state;
+    state.push_back(compound->getZoom().x());
+    state.push_back(_current);
+    store.set(getStateKey(), state);
+}
+
+void DFREqualizer::loadState(const EqualizerStore& store)
+{
+    Compound* compound = getCompound();
+    const EqualizerStore::State* state = store.get(getStateKey());
+    if (!compound || !state || state->size() != 2 || (*state)[0] <= 0.f)
+        return;
+
+    compound->setZoom(Zoom((*state)[0], (*state)[0]));
+    _current = (*state)[1];
+}
+
+void DFREqualizer::resetState()
+{
+    Compound* compound = getCompound();
+    if (compound)
+        compound->setZoom(Zoom::NONE);
+    _current = getFrameRate();
+}
+
 void DFREqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
                                   const Statistics& statistics,
                                   const Viewport& /*region*/)
@@ -47,6 +47,15 @@ public:
 
     uint32_t getType() const final { return fabric::DFR_EQUALIZER; }
 
+    /** Save the zoom and the current frame rate. */
+    void saveState(EqualizerStore& store) const final;
+
+    /** Restore the zoom and the current frame rate. */
+    void loadState(const EqualizerStore& store) final;
+
+    /** Reset the zoom and assume the target frame rate. */
+    void resetState() final;
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
@@ -20,10 +20,15 @@
 
 #include "../compound.h"
 #include "../config.h"
+#include "../layout.h"
 #include "../log.h"
+#include "../view.h"
+#include "equalizerStore.h"
 
 #include <lunchbox/debug.h>
 
+#include <sstream>
+
 namespace eq
 {
 namespace server
@@ -52,7 +57,19 @@ Equalizer::Equalizer(const Equalizer& from)
 
 Equalizer& Equalizer::operator=(const fabric::Equalizer& from)
 {
+    if (!_compound || from.getModelName() == getModelName())
+    {
+        fabric::Equalizer::operator=(from);
+        return *this;
+    }
+
+    // model switch: keep the state of the old model, use the one of the new
+    // or the default split if the new model has none
+    EqualizerStore& store = getConfig()->getEqualizerStore();
+    saveState(store);
     fabric::Equalizer::operator=(from);
+    resetState();
+    loadState(store);
     return *this;
 }
 
@@ -81,5 +98,28 @@ const Config* Equalizer::getConfig() const
     LBASSERT(_compound);
     return _compound->getConfig();
 }
+
+Config* Equalizer::getConfig()
+{
+    LBASSERT(_compound);
+    return _compound->getConfig();
+}
+
+std::string Equalizer::getStateKey() const
+{
+    LBASSERT(_compound);
+    const Channel* channel = _compound->getChannel();
+    if (!channel)
+        channel = _compound->getInheritChannel();
+    const View* view = channel ? channel->getView() : 0;
+    const Layout* layout = view ? view->getLayout() : 0;
+
+    std::ostringstream key;
+    key << getConfig()->getName() << '/' << (layout ? layout->getName() : "")
+        << '/' << getModelName() << '/'
+        << (channel ? channel->getName() : "") << '/' << getType() << '/'
+        << _compound->getTaskID();
+    return key.str();
+}
 }
 }
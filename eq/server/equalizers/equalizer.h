@@ -54,6 +54,7 @@ public:
     Compound* getCompound() { return _compound; }
     /** @return the config. */
     const Config* getConfig() const;
+    Config* getConfig();
 
     /** Attach to a compound and detach the previous compound. */
     virtual void attach(Compound*);
@@ -62,6 +63,19 @@ public:
     bool isActive() const { return _active; }
     virtual uint32_t getType() const = 0;
 
+    /** Save the balancing state, if any, to the given store. */
+    virtual void saveState(EqualizerStore&) const {}
+
+    /** Restore the balancing state, if found in the given store. */
+    virtual void loadState(const EqualizerStore&) {}
+
+    /** Discard the balancing state, restarting from the default split. */
+    virtual void resetState() {}
+
+protected:
+    /** @return the key of this equalizer's state in an EqualizerStore. */
+    std::string getStateKey() const;
+
 private:
     // override in sub-classes to handle dynamic compounds.
     void notifyChildAdded(Compound*, Compound*) override { LBUNIMPLEMENTED }
@@ -0,0 +1,173 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "equalizerStore.h"
+
+#include <lunchbox/debug.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const std::string _header = "#Equalizer state 1";
+
+/** Escape line breaks in names, which would end the state's line. */
+std::string _escape(const std::string& key)
+{
+    std::string escaped;
+    for (const char c : key)
+    {
+        switch (c)
+        {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+bool _unescape(const std::string& escaped, std::string& key)
+{
+    key.clear();
+    for (size_t i = 0; i < escaped.size(); ++i)
+    {
+        if (escaped[i] != '\\')
+        {
+            key += escaped[i];
+            continue;
+        }
+        if (++i == escaped.size())
+            return false;
+        switch (escaped[i])
+        {
+        case '\\':
+            key += '\\';
+            break;
+        case 'n':
+            key += '\n';
+            break;
+        case 'r':
+            key += '\r';
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+void EqualizerStore::set(const std::string& key, const State& state)
+{
+    _states[key] = state;
+}
+
+const EqualizerStore::State* EqualizerStore::get(const std::string& key) const
+{
+    const auto i = _states.find(key);
+    return i == _states.end() ? 0 : &i->second;
+}
+
+bool EqualizerStore::read(std::istream& is)
+{
+    std::string line;
+    if (!std::getline(is, line) || line != _header)
+        return false;
+
+    std::map<std::string, State> states;
+    while (std::getline(is, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::istringstream values(line);
+        size_t size = 0;
+        if (!(values >> size))
+            return false;
+
+        State state(size);
+        for (float& value : state)
+            if (!(values >> value))
+                return false;
+
+        std::string escaped;
+        std::string key;
+        values.get(); // separator
+        if (!std::getline(values, escaped) || escaped.empty() ||
+            !_unescape(escaped, key))
+        {
+            return false;
+        }
+        states[key].swap(state);
+    }
+
+    for (auto& entry : states)
+        _states[entry.first].swap(entry.second);
+    return true;
+}
+
+void EqualizerStore::write(std::ostream& os) const
+{
+    os << _header << std::endl;
+    for (const auto& entry : _states)
+    {
+        os << entry.second.size();
+        for (const float value : entry.second)
+            os << ' ' << value;
+        os << ' ' << _escape(entry.first) << std::endl;
+    }
+}
+
+bool EqualizerStore::load(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+    if (read(file))
+        return true;
+
+    LBWARN << "Ignoring malformed equalizer state file " << filename
+           << std::endl;
+    return false;
+}
+
+bool EqualizerStore::save(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file.is_open())
+    {
+        LBWARN << "Can't write equalizer state file " << filename << std::endl;
+        return false;
+    }
+    write(file);
+    return file.good();
+}
+}
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_EQUALIZERSTORE_H
+#define EQSERVER_EQUALIZERSTORE_H
+
+#include <eq/server/api.h>
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Keeps the balancing state of equalizers across layout and model switches
+ * and application runs.
+ *
+ * Each equalizer stores a list of values under a key identifying its config,
+ * layout, model and compound. The store is written to a text file with one
+ * state per line, the number of values and the values followed by the key.
+ * Backslashes and line breaks in the key are escaped with a backslash.
+ */
+class EqualizerStore
+{
+public:
+    typedef std::vector<float> State;
+
+    /** Set the state stored under the given key. */
+    EQSERVER_API void set(const std::string& key, const State& state);
+
+    /** @return the state stored under the given key, or 0. */
+    EQSERVER_API const State* get(const std::string& key) const;
+
+    /** @return true if no state is stored. */
+    bool isEmpty() const { return _states.empty(); }
+
+    /** Remove all states. */
+    void clear() { _states.clear(); }
+
+    /** Add the states read from the stream. @return success. */
+    EQSERVER_API bool read(std::istream& is);
+
+    /** Write all states to the stream. */
+    EQSERVER_API void write(std::ostream& os) const;
+
+    /** Add the states of the given file. @return success. */
+    EQSERVER_API bool load(const std::string& filename);
+
+    /** Save all states to the given file. @return success. */
+    EQSERVER_API bool save(const std::string& filename) const;
+
+private:
+    std::map<std::string, State> _states;
+};
+}
+}
+
+#endif // EQSERVER_EQUALIZERSTORE_H
@@ -17,17 +17,17 @@
 
 #include "framerateEqualizer.h"
 
+#include "../channel.h"
 #include "../compound.h"
 #include "../compoundVisitor.h"
 #include "../config.h"
 #include "../log.h"
+#include "../window.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
 
-#define USE_AVERAGE
 #define VSYNC_CAP 60.f
-#define SLOWDOWN 1.05f
 
 namespace eq
 {
@@ -78,19 +78,19 @@ private:
 };
 }
 
-// The smooth load balancer adapts the framerate of the compound to be the
-// average frame rate of all children, taking the DPlex period into account.
+// The framerate equalizer adapts the framerate of the compound to a high
+// percentile of the frame times of all children, taking the DPlex period into
+// account.
 
 FramerateEqualizer::FramerateEqualizer()
-    : _nSamples(0)
 {
     LBINFO << "New FramerateEqualizer @" << (void*)this << std::endl;
 }
 
 FramerateEqualizer::FramerateEqualizer(const FramerateEqualizer& from)
     : Equalizer(from)
-    , _nSamples(0)
 {
+    _model.setDamping(from.getDamping());
 }
 
 FramerateEqualizer::~FramerateEqualizer()
@@ -108,39 +108,33 @@ void FramerateEqualizer::_init()
 {
     const Compound* compound = getCompound();
 
-    if (_nSamples > 0 || !compound)
+    if (!_loadListeners.empty() || !compound)
         return;
 
-    _nSamples = 1;
-
     // Subscribe to child channel load events
     const Compounds& children = compound->getChildren();
 
-    LBASSERT(_loadListeners.empty());
     _loadListeners.resize(children.size());
+    _model.setNumSources(children.size());
 
     for (size_t i = 0; i < children.size(); ++i)
     {
         Compound* child = children[i];
-        const uint32_t period = child->getInheritPeriod();
         LoadListener& loadListener = _loadListeners[i];
 
         loadListener.parent = this;
-        loadListener.period = period;
+        loadListener.index = i;
+        loadListener.period = child->getInheritPeriod();
 
         LoadSubscriber subscriber(&loadListener);
         child->accept(subscriber);
-
-        _nSamples = LB_MAX(_nSamples, period);
     }
-
-    _nSamples = LB_MIN(_nSamples, 100);
 }
 
 void FramerateEqualizer::_exit()
 {
     const Compound* compound = getCompound();
-    if (!compound || _nSamples == 0)
+    if (!compound || _loadListeners.empty())
         return;
 
     const Compounds& children = compound->getChildren();
@@ -156,90 +150,60 @@ void FramerateEqualizer::_exit()
     }
 
     _loadListeners.clear();
-    _times.clear();
-    _nSamples = 0;
+    _model.setNumSources(0);
 }
 
 void FramerateEqualizer::notifyUpdatePre(Compound* compound,
-                                         const uint32_t frameNumber)
+                                         const uint32_t /*frameNumber*/)
 {
     _init();
 
-    // find starting point of contiguous block
-    const ssize_t size = ssize_t(_times.size());
-    ssize_t from = 0;
-    if (size > 0)
-    {
-        for (ssize_t i = size - 1; i >= 0; --i)
-        {
-            if (_times[i].second == 0.f)
-            {
-                from = i;
-                break;
-            }
-        }
-    }
-
-    // find max / avg time in block
-    size_t nSamples = 0;
-#ifdef USE_AVERAGE
-    float sumTime = 0.f;
-#else
-    float maxTime = 0.f;
-#endif
-
-    LBLOG(LOG_LB2) << "Searching " << from + 1 << ".." << size << std::endl;
-    for (++from; from < size && nSamples < _nSamples; ++from)
+    if (isFrozen() || !compound->isActive() || !isActive())
     {
-        const FrameTime& time = _times[from];
-        LBASSERT(time.first > 0);
-        LBASSERT(time.second != 0.f);
-
-        ++nSamples;
-#ifdef USE_AVERAGE
-        sumTime += time.second;
-#else
-        maxTime = LB_MAX(maxTime, time.second);
-#endif
-        LBLOG(LOG_LB2) << "Using " << time.first << ", " << time.second << "ms"
-                       << std::endl;
+        _setInterval(compound, 0.f);
+        return;
     }
 
-    if (nSamples == _nSamples) // If we have a full set
-        while (from < ssize_t(_times.size()))
-            _times.pop_back(); //  delete all older samples
-    // always execute code above to not leak memory
+    const float interval = _model.update();
+    if (interval <= 0.f)
+        return;
 
-    if (isFrozen() || !compound->isActive() || !isActive())
+#ifdef VSYNC_CAP
+    if (1000.f / interval > VSYNC_CAP)
     {
-        compound->setMaxFPS(std::numeric_limits<float>::max());
+        _setInterval(compound, 0.f);
         return;
     }
-
-    if (nSamples > 0)
-    {
-// TODO: totalTime *= 1.f - damping;
-#ifdef USE_AVERAGE
-        const float time = (sumTime / nSamples) * SLOWDOWN;
-#else
-        const float time = maxTime * SLOWDOWN;
 #endif
 
-        const float fps = 1000.f / time;
-#ifdef VSYNC_CAP
-        if (fps > VSYNC_CAP)
-            compound->setMaxFPS(std::numeric_limits<float>::max());
-        else
-#endif
-            compound->setMaxFPS(fps);
+    _setInterval(compound, interval);
+    LBLOG(LOG_LB2) << 1000.f / interval << " Hz, " << interval << "ms"
+                   << std::endl;
+}
 
-        LBLOG(LOG_LB2) << fps << " Hz from " << nSamples << "/" << _times.size()
-                       << " samples, " << time << "ms" << std::endl;
-    }
+void FramerateEqualizer::_setInterval(Compound* compound, const float interval)
+{
+    const float fps = interval > 0.f ? 1000.f / interval
+                                     : std::numeric_limits<float>::max();
+    compound->setMaxFPS(fps);
+    compound->setFrameOffset(0.f);
+
+    // Pace DPlex sources rendering in their own window to their period, offset
+    // by their phase, so that they start their frames evenly spread.
+    const Channel* channel = compound->getChannel();
+    const Window* window = channel ? channel->getWindow() : 0;
+    const Compounds& children = compound->getChildren();
+    for (Compound* child : children)
+    {
+        const Channel* childChannel = child->getChannel();
+        const uint32_t period = child->getInheritPeriod();
+        if (period <= 1 || !childChannel || childChannel->getWindow() == window)
+            continue;
 
-    if (frameNumber > 0)
-        _times.push_front(FrameTime(frameNumber, 0.f));
-    LBASSERT(_times.size() < 10);
+        const uint32_t phase = child->getInheritPhase() % period;
+        child->setMaxFPS(interval > 0.f ? fps / float(period) : fps);
+        child->setFrameOffset(interval * float(phase));
+    }
 }
 
 void FramerateEqualizer::LoadListener::notifyLoadData(
@@ -273,25 +237,26 @@ void FramerateEqualizer::LoadListener::notifyLoadData(
     if (startTime == endTime) // very fast draws might report 0 times
         ++endTime;
 
-    for (std::deque<FrameTime>::iterator i = parent->_times.begin();
-         i != parent->_times.end(); ++i)
-    {
-        FrameTime& frameTime = *i;
-        if (frameTime.first != frameNumber)
-            continue;
-
-        const float time = static_cast<float>(endTime - startTime) / period;
-        frameTime.second = LB_MAX(frameTime.second, time);
-        LBLOG(LOG_LB2) << "Frame " << frameNumber << " channel "
-                       << channel->getName() << " time " << time << " period "
-                       << period << std::endl;
-    }
+    const float time = static_cast<float>(endTime - startTime) / period;
+    parent->_model.addSample(index, time);
+    LBLOG(LOG_LB2) << "Frame " << frameNumber << " channel "
+                   << channel->getName() << " time " << time << " period "
+                   << period << std::endl;
 }
 
 std::ostream& operator<<(std::ostream& os, const FramerateEqualizer* lb)
 {
-    if (lb)
-        os << "framerate_equalizer {}" << std::endl;
+    if (!lb)
+        return os;
+
+    if (lb->getDamping() == PacingModel().getDamping())
+        return os << "framerate_equalizer {}" << std::endl;
+
+    os << lunchbox::disableFlush << "framerate_equalizer" << std::endl
+       << '{' << std::endl
+       << "    damping " << lb->getDamping() << std::endl
+       << '}' << std::endl
+       << lunchbox::enableFlush;
     return os;
 }
 }
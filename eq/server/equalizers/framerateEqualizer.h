@@ -20,6 +20,7 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"          // base class
+#include "pacingModel.h"        // member
 
 namespace eq
 {
@@ -30,6 +31,11 @@ std::ostream& operator<<(std::ostream& os, const FramerateEqualizer*);
 /**
  * Adapts the frame rate of a compound to smoothen its output.
  *
+ * The frame interval is computed by a PacingModel from the frame times of all
+ * children. The windows of the compound are paced to a grid of this interval,
+ * and the windows of DPlex children to a grid of their period, offset by their
+ * phase. This spreads the DPlex sources evenly over their period.
+ *
  * Does not support period settings underneath a child. One channel should
  * not be used in compounds with a different inherit period.
  */
@@ -48,22 +54,25 @@ public:
 
     uint32_t getType() const final { return fabric::FRAMERATE_EQUALIZER; }
 
+    /** Set the weight of the old frame rate when it increases. */
+    void setDamping(const float damping) { _model.setDamping(damping); }
+
+    /** @return the weight of the old frame rate when it increases. */
+    float getDamping() const { return _model.getDamping(); }
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override
     {
-        LBASSERT(_nSamples == 0);
+        LBASSERT(_loadListeners.empty());
     }
     void notifyChildRemove(Compound*, Compound*) override
     {
-        LBASSERT(_nSamples == 0);
+        LBASSERT(_loadListeners.empty());
     }
 
 private:
-    /** Frame number with max time. */
-    typedef std::pair<uint32_t, float> FrameTime;
-
-    /** Historical data to compute new frame rate. */
-    std::deque<FrameTime> _times;
+    /** Computes the frame interval from the children's frame times. */
+    PacingModel _model;
 
     /** Helper class connecting on child tree for load gathering. */
     class LoadListener : public ChannelListener
@@ -75,6 +84,7 @@ private:
                                     const Viewport& region);
 
         FramerateEqualizer* parent;
+        size_t index;
         uint32_t period;
     };
 
@@ -82,11 +92,9 @@ private:
     std::vector<LoadListener> _loadListeners;
     friend class LoadListener;
 
-    /** The number of samples to use from _times. */
-    uint32_t _nSamples;
-
     void _init();
     void _exit();
+    void _setInterval(Compound* compound, float interval);
 };
 } // namespace server
 } // namespace eq
@@ -21,6 +21,7 @@
 
 #include "../compound.h"
 #include "../log.h"
+#include "equalizerStore.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
@@ -31,12 +32,36 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const LoadEqualizer::Node*);
 
+namespace
+{
+// The part of a load item's range within the given range. Splits of a hybrid
+// tree only account for the load of the subtree's range and viewport.
+float _getShare(const Range& data, const Range& range)
+{
+    if (range == Range::ALL)
+        return 1.f;
+    const float start = LB_MAX(data.start, range.start);
+    const float end = LB_MIN(data.end, range.end);
+    return end > start ? (end - start) / data.getSize() : 0.f;
+}
+
+float _getShare(const Viewport& data, const Viewport& vp)
+{
+    if (vp == Viewport::FULL)
+        return 1.f;
+    Viewport overlap = data;
+    overlap.intersect(vp);
+    return overlap.hasArea() ? overlap.getArea() / data.getArea() : 0.f;
+}
+}
+
 // The tree load balancer organizes the children in a binary tree. At each
 // level, a relative split position is determined by balancing the left subtree
 // against the right subtree.
 
 LoadEqualizer::LoadEqualizer()
     : _tree(0)
+    , _seeding(false)
 {
     LBVERB << "New LoadEqualizer @" << (void*)this << std::endl;
 }
@@ -44,6 +69,7 @@ LoadEqualizer::LoadEqualizer()
 LoadEqualizer::LoadEqualizer(const fabric::Equalizer& from)
     : Equalizer(from)
     , _tree(0)
+    , _seeding(false)
 {
 }
 
@@ -72,9 +98,9 @@ void LoadEqualizer::notifyUpdatePre(Compound* compound,
         case 0:
             return; // no child compounds, can't do anything.
         case 1:     // one child, 'balance' it:
-            if (getMode() == MODE_DB)
+            if (getMode() == MODE_DB || getMode() == MODE_HYBRID)
                 children.front()->setRange(Range());
-            else
+            if (getMode() != MODE_DB)
                 children.front()->setViewport(Viewport());
             return;
 
@@ -91,10 +117,75 @@ void LoadEqualizer::notifyUpdatePre(Compound* compound,
         _history.back().first = frameNumber;
     }
 
-    _update(_tree, Viewport(), Range());
+    if (getMode() == MODE_HYBRID)
+    {
+        const LBFrameData& frameData = _history.front();
+        float drawTime = 0.f;
+        float compositeTime = 0.f;
+        if (frameData.first > 0)
+            _addSamples(_tree, frameData.first, frameData.second, drawTime,
+                        compositeTime);
+    }
+
+    _update(_tree, frameNumber, Viewport(), Range());
     _computeSplit();
 }
 
+void LoadEqualizer::saveState(EqualizerStore& store) const
+{
+    if (_history.empty() || _history.front().first == 0) // no measured frame
+        return;
+
+    LBDatas items = _history.front().second;
+    _removeEmpty(items);
+    if (items.empty())
+        return;
+
+    EqualizerStore::State state;
+    for (const Data& data : items)
+    {
+        state.push_back(data.vp.x);
+        state.push_back(data.vp.y);
+        state.push_back(data.vp.w);
+        state.push_back(data.vp.h);
+        state.push_back(data.range.start);
+        state.push_back(data.range.end);
+        state.push_back(float(data.time));
+    }
+    store.set(getStateKey(), state);
+}
+
+void LoadEqualizer::loadState(const EqualizerStore& store)
+{
+    const EqualizerStore::State* state = store.get(getStateKey());
+    if (!state || state->empty() || state->size() % 7 != 0)
+        return;
+
+    // replaces the fake data set of _checkHistory, pending frames are dropped
+    LBFrameData frameData;
+    frameData.first = 0;
+    for (size_t i = 0; i < state->size(); i += 7)
+    {
+        const float* values = &(*state)[i];
+        Data data;
+        data.vp = Viewport(values[0], values[1], values[2], values[3]);
+        data.range = Range(values[4], values[5]);
+        data.time = LB_MAX(int64_t(values[6]), 1);
+        frameData.second.push_back(data);
+    }
+
+    _history.clear();
+    _history.push_back(frameData);
+    _seeding = false;
+    LBLOG(LOG_LB1) << "Restored " << frameData.second.size()
+                   << " load items for " << getStateKey() << std::endl;
+}
+
+void LoadEqualizer::resetState()
+{
+    _history.clear();
+}
+
 LoadEqualizer::Node* LoadEqualizer::_buildTree(const Compounds& compounds)
 {
     Node* node = new Node;
@@ -176,6 +267,8 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
             int64_t endTime = 0;
             bool loadSet = false;
             int64_t transmitTime = 0;
+            int64_t drawTime = 0;
+            int64_t readbackTime = 0;
             for (size_t k = 0; k < statistics.size(); ++k)
             {
                 const Statistic& stat = statistics[k];
@@ -190,7 +283,12 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
                 {
                 case Statistic::CHANNEL_CLEAR:
                 case Statistic::CHANNEL_DRAW:
+                    drawTime += stat.endTime - stat.startTime;
+                    startTime = LB_MIN(startTime, stat.startTime);
+                    endTime = LB_MAX(endTime, stat.endTime);
+                    break;
                 case Statistic::CHANNEL_READBACK:
+                    readbackTime += stat.endTime - stat.startTime;
                     startTime = LB_MIN(startTime, stat.startTime);
                     endTime = LB_MAX(endTime, stat.endTime);
                     break;
@@ -221,6 +319,11 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
             data.time = LB_MAX(data.time, 1);
             data.time = LB_MAX(data.time, transmitTime);
             data.assembleTime = LB_MAX(data.assembleTime, 0);
+            data.drawTime = drawTime;
+            // assembly happens on destinations, readback and transmit on
+            // sources: all of it is the cost of compositing this split
+            data.compositeTime =
+                readbackTime + LB_MAX(transmitTime, 0) + data.assembleTime;
             LBLOG(LOG_LB2) << "Added time " << data.time << " (+"
                            << data.assembleTime << ") for "
                            << channel->getName() << " " << data.vp << ", "
@@ -277,6 +380,8 @@ void LoadEqualizer::_checkHistory()
     // 2. delete old, unneeded data sets
     while (!_history.empty() && _history.front().first < useFrame)
         _history.pop_front();
+    if (useFrame > 0)
+        _seeding = false;
 
     if (_history.empty()) // insert fake set
     {
@@ -292,6 +397,9 @@ void LoadEqualizer::_checkHistory()
         data.time = 1;
         LBASSERT(data.taskID == 0);
         LBASSERT(data.channel == 0);
+
+        // without load data, split by the calibrated channel speeds
+        _seeding = true;
     }
 }
 
@@ -301,21 +409,57 @@ float LoadEqualizer::_getTotalResources() const
 
     float resources = 0.f;
     for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
+        resources += _getResources(*i);
+
+    return resources;
+}
+
+float LoadEqualizer::_getResources(const Compound* compound) const
+{
+    if (!compound->isActive())
+        return 0.f;
+    if (!_seeding)
+        return compound->getUsage();
+    return compound->getUsage() * compound->getChannel()->getResourceWeight();
+}
+
+void LoadEqualizer::_addSamples(Node* node, const uint32_t frame,
+                                const LBDatas& items, float& drawTime,
+                                float& compositeTime)
+{
+    if (node->compound)
     {
-        const Compound* compound = *i;
-        if (compound->isActive())
-            resources += compound->getUsage();
+        const Channel* channel = node->compound->getChannel();
+        for (const Data& data : items)
+        {
+            if (data.channel != channel)
+                continue;
+            drawTime += float(data.drawTime);
+            compositeTime += float(data.compositeTime);
+        }
+        return;
     }
 
-    return resources;
+    float subtreeDraw = 0.f;
+    float subtreeComposite = 0.f;
+    _addSamples(node->left, frame, items, subtreeDraw, subtreeComposite);
+    _addSamples(node->right, frame, items, subtreeDraw, subtreeComposite);
+    node->selector.addSample(frame, subtreeDraw, subtreeComposite);
+
+    drawTime += subtreeDraw;
+    compositeTime += subtreeComposite;
 }
 
-void LoadEqualizer::_update(Node* node, const Viewport& vp, const Range& range)
+void LoadEqualizer::_update(Node* node, const uint32_t frame,
+                            const Viewport& vp, const Range& range)
 {
     if (!node)
         return;
 
     node->mode = getMode();
+    if (node->mode == MODE_HYBRID)
+        node->mode = node->compound ? MODE_2D : node->selector.select(frame);
+
     if (node->mode == MODE_2D)
     {
         PixelViewport pvp = getCompound()->getChannel()->getPixelViewport();
@@ -330,7 +474,7 @@ void LoadEqualizer::_update(Node* node, const Viewport& vp, const Range& range)
     if (node->compound)
         _updateLeaf(node);
     else
-        _updateNode(node, vp, range);
+        _updateNode(node, frame, vp, range);
 }
 
 void LoadEqualizer::_updateLeaf(Node* node)
@@ -339,7 +483,7 @@ void LoadEqualizer::_updateLeaf(Node* node)
     const Channel* channel = compound->getChannel();
     LBASSERT(channel);
     const PixelViewport& pvp = channel->getPixelViewport();
-    node->resources = compound->isActive() ? compound->getUsage() : 0.f;
+    node->resources = _getResources(compound);
     LBLOG(LOG_LB2) << channel->getName() << " active " << compound->isActive()
                    << " using " << node->resources << std::endl;
     LBASSERT(node->resources >= 0.f);
@@ -375,8 +519,8 @@ void LoadEqualizer::_updateLeaf(Node* node)
         node->resources = 0.f;
 }
 
-void LoadEqualizer::_updateNode(Node* node, const Viewport& vp,
-                                const Range& range)
+void LoadEqualizer::_updateNode(Node* node, const uint32_t frame,
+                                const Viewport& vp, const Range& range)
 {
     Node* left = node->left;
     Node* right = node->right;
@@ -415,8 +559,8 @@ void LoadEqualizer::_updateNode(Node* node, const Viewport& vp,
         break;
     }
 
-    _update(left, leftVP, leftRange);
-    _update(right, rightVP, rightRange);
+    _update(left, frame, leftVP, leftRange);
+    _update(right, frame, rightVP, rightRange);
 
     node->resources = left->resources + right->resources;
 
@@ -534,12 +678,12 @@ void LoadEqualizer::_computeSplit()
 
     LBDatas sortedData[3] = {items, items, items};
 
-    if (getMode() == MODE_DB)
+    if (getMode() == MODE_DB || getMode() == MODE_HYBRID)
     {
         LBDatas& rangeData = sortedData[MODE_DB];
         sort(rangeData.begin(), rangeData.end(), _compareRange);
     }
-    else
+    if (getMode() != MODE_DB)
     {
         LBDatas& xData = sortedData[MODE_VERTICAL];
         sort(xData.begin(), xData.end(), _compareX);
@@ -607,7 +751,7 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
     {
     case MODE_VERTICAL:
     {
-        LBASSERT(range == Range::ALL);
+        LBASSERT(range == Range::ALL || getMode() == MODE_HYBRID);
 
         float splitPos = vp.x;
         const float end = vp.getXEnd();
@@ -671,8 +815,9 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
 
                 if (yContrib > 0.f)
                 {
-                    const float percentage =
-                        (width / data.vp.w) * (yContrib / data.vp.h);
+                    const float percentage = (width / data.vp.w) *
+                                             (yContrib / data.vp.h) *
+                                             _getShare(data.range, range);
                     currentTime += (data.time * percentage);
 
                     LBLOG(LOG_LB2)
@@ -773,7 +918,7 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
 
     case MODE_HORIZONTAL:
     {
-        LBASSERT(range == Range::ALL);
+        LBASSERT(range == Range::ALL || getMode() == MODE_HYBRID);
         float splitPos = vp.y;
         const float end = vp.getYEnd();
 
@@ -837,8 +982,9 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
 
                 if (xContrib > 0.f)
                 {
-                    const float percentage =
-                        (height / data.vp.h) * (xContrib / data.vp.w);
+                    const float percentage = (height / data.vp.h) *
+                                             (xContrib / data.vp.w) *
+                                             _getShare(data.range, range);
                     currentTime += (data.time * percentage);
 
                     LBLOG(LOG_LB2)
@@ -933,7 +1079,7 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
 
     case MODE_DB:
     {
-        LBASSERT(vp == Viewport::FULL);
+        LBASSERT(vp == Viewport::FULL || getMode() == MODE_HYBRID);
         float splitPos = range.start;
         const float end = range.end;
 
@@ -987,7 +1133,8 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
                     LBASSERTINFO( data.range.end >= currentPos,
                                   data.range.end << " < " << currentPos);
 #endif
-                currentTime += data.time * size / data.range.getSize();
+                currentTime += data.time * size / data.range.getSize() *
+                               _getShare(data.vp, vp);
             }
 
             LBLOG(LOG_LB2) << splitPos << "..." << currentPos
@@ -1051,8 +1198,9 @@ void LoadEqualizer::_computeSplit(Node* node, const float time, LBDatas* datas,
 void LoadEqualizer::_assign(Compound* compound, const Viewport& vp,
                             const Range& range)
 {
-    LBASSERTINFO(vp == Viewport::FULL || range == Range::ALL,
-                 "Mixed 2D/DB load-balancing not implemented");
+    LBASSERTINFO(vp == Viewport::FULL || range == Range::ALL ||
+                     getMode() == MODE_HYBRID,
+                 "Mixed 2D/DB load-balancing only in hybrid mode");
 
     compound->setViewport(vp);
     compound->setRange(range);
@@ -21,6 +21,7 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"          // base class
+#include "modeSelector.h"       // member
 
 #include <eq/fabric/range.h>    // member
 #include <eq/fabric/viewport.h> // member
@@ -34,7 +35,13 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const LoadEqualizer*);
 
-/** Adapts the 2D tiling or DB range of the attached compound's children. */
+/**
+ * Adapts the 2D tiling or DB range of the attached compound's children.
+ *
+ * In hybrid mode, each split of the internal binary tree selects sort-first or
+ * sort-last decomposition per frame, based on the draw and compositing times
+ * of its subtree. Hybrid mode requires output frames with color and depth.
+ */
 class LoadEqualizer : public Equalizer, protected ChannelListener
 {
 public:
@@ -51,6 +58,16 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::LOAD_EQUALIZER; }
+
+    /** Save the load of the last complete frame. */
+    void saveState(EqualizerStore& store) const final;
+
+    /** Use the saved load until the first frame completes. */
+    void loadState(const EqualizerStore& store) final;
+
+    /** Drop the load history, using a uniform split until new data arrives. */
+    void resetState() final;
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override { LBASSERT(!_tree); }
     void notifyChildRemove(Compound*, Compound*) override { LBASSERT(!_tree); }
@@ -85,6 +102,7 @@ private:
         float resistancef;
         Vector2i resistance2i;
         Vector2i maxSize;
+        ModeSelector selector; //!< Split mode in hybrid mode
     };
     friend std::ostream& operator<<(std::ostream& os, const Node* node);
     typedef std::vector<Node*> LBNodes;
@@ -99,6 +117,8 @@ private:
             , destTaskID(0)
             , time(-1)
             , assembleTime(0)
+            , drawTime(0)
+            , compositeTime(0)
         {
         }
         Channel* channel;
@@ -108,12 +128,15 @@ private:
         Range range;
         int64_t time;
         int64_t assembleTime;
+        int64_t drawTime;
+        int64_t compositeTime;
     };
 
     typedef std::vector<Data> LBDatas;
     typedef std::pair<uint32_t, LBDatas> LBFrameData;
 
     std::deque<LBFrameData> _history;
+    bool _seeding; //!< split by channel weights until load data arrives
 
     //-------------------- Methods --------------------
     /** @return true if we have a valid LB tree */
@@ -135,14 +158,20 @@ private:
     /** Obsolete _history so that front-most item is youngest available. */
     void _checkHistory();
 
+    /** Feed the draw and compositing times to the hybrid mode selectors. */
+    void _addSamples(Node* node, uint32_t frame, const LBDatas& items,
+                     float& drawTime, float& compositeTime);
+
     /** Update all node fields influencing the split */
-    void _update(Node* node, const Viewport& vp, const Range& range);
+    void _update(Node* node, uint32_t frame, const Viewport& vp,
+                 const Range& range);
     void _updateLeaf(Node* node);
-    void _updateNode(Node* node, const Viewport& vp, const Range& range);
+    void _updateNode(Node* node, uint32_t frame, const Viewport& vp,
+                     const Range& range);
 
     /** Adjust the split of each node based on the front-most _history. */
     void _computeSplit();
-    void _removeEmpty(LBDatas& items);
+    static void _removeEmpty(LBDatas& items);
 
     void _computeSplit(Node* node, const float time, LBDatas* sortedData,
                        const Viewport& vp, const Range& range);
@@ -150,6 +179,8 @@ private:
 
     /** Get the resource for all children compound. */
     float _getTotalResources() const;
+    /** @return the usage of a child, weighted by its channel while seeding. */
+    float _getResources(const Compound* compound) const;
 
     static bool _compareX(const Data& data1, const Data& data2)
     {
@@ -0,0 +1,111 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "modeSelector.h"
+
+#include "../log.h"
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const float _weight = .5f;      // of a new sample in the smoothed costs
+const float _hysteresis = .15f; // other mode needs to be 15% faster
+const float _maxShareDB = .5f;  // probe 2D when compositing is above
+const float _minShare2D = .25f; // probe DB when compositing is below
+const uint32_t _minSamples = 8; // measured frames between switches
+const uint32_t _maxAge = 256;   // samples until a measurement is outdated
+}
+
+ModeSelector::ModeSelector()
+    : _mode(fabric::Equalizer::MODE_2D)
+    , _compositeShare(0.f)
+    , _switchFrame(0)
+    , _lastFrame(0)
+    , _samples(0)
+{
+}
+
+void ModeSelector::addSample(const uint32_t frame, const float drawTime,
+                             const float compositeTime)
+{
+    if (frame <= _lastFrame || frame < _switchFrame)
+        return;
+    _lastFrame = frame;
+
+    const float time = drawTime + compositeTime;
+    if (time <= 0.f)
+        return;
+
+    const size_t index = _getIndex(_mode);
+    Cost& current = _costs[index];
+    Cost& other = _costs[1 - index];
+    const float share = compositeTime / time;
+
+    if (current.valid && current.age < _maxAge)
+    {
+        current.time = (1.f - _weight) * current.time + _weight * time;
+        _compositeShare =
+            (1.f - _weight) * _compositeShare + _weight * share;
+    }
+    else
+    {
+        current.time = time;
+        _compositeShare = share;
+    }
+    current.age = 0;
+    current.valid = true;
+    if (other.age < _maxAge)
+        ++other.age;
+    ++_samples;
+}
+
+ModeSelector::Mode ModeSelector::select(const uint32_t frame)
+{
+    if (_samples < _minSamples)
+        return _mode;
+
+    const size_t index = _getIndex(_mode);
+    const Cost& current = _costs[index];
+    const Cost& other = _costs[1 - index];
+
+    bool change = false;
+    if (other.valid && other.age < _maxAge)
+        change = other.time * (1.f + _hysteresis) < current.time;
+    else if (_mode == fabric::Equalizer::MODE_DB)
+        change = _compositeShare > _maxShareDB;
+    else
+        change = _compositeShare < _minShare2D;
+
+    if (!change)
+        return _mode;
+
+    const Mode mode = _mode == fabric::Equalizer::MODE_DB
+                          ? fabric::Equalizer::MODE_2D
+                          : fabric::Equalizer::MODE_DB;
+    LBLOG(LOG_LB1) << "Switch from " << _mode << " to " << mode
+                   << " decomposition, time " << current.time << " vs "
+                   << (other.valid ? other.time : 0.f) << ", compositing "
+                   << _compositeShare * 100.f << "% @ " << frame << std::endl;
+    _mode = mode;
+    _switchFrame = frame;
+    _samples = 0;
+    return _mode;
+}
+}
+}
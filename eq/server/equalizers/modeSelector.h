@@ -0,0 +1,96 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_MODESELECTOR_H
+#define EQSERVER_MODESELECTOR_H
+
+#include <eq/fabric/equalizer.h> // Mode enum
+#include <eq/server/api.h>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Selects sort-first or sort-last decomposition for one subtree of a hybrid
+ * LoadEqualizer.
+ *
+ * The selector tracks the total draw and compositing time measured for each
+ * mode. It switches to the other mode when that mode was measured recently and
+ * is cheaper by more than the hysteresis. Without a recent measurement, it
+ * probes the other mode when compositing dominates a sort-last subtree, or
+ * when drawing dominates a sort-first subtree. After a switch, the mode is
+ * kept for a minimum number of measured frames.
+ */
+class ModeSelector
+{
+public:
+    typedef fabric::Equalizer::Mode Mode;
+
+    EQSERVER_API ModeSelector();
+
+    /**
+     * Add the time measured for a subtree in a frame.
+     *
+     * Frames rendered before the last mode switch, and frames not newer than
+     * the last sample are ignored.
+     *
+     * @param frame the frame number of the measurement.
+     * @param drawTime the summed clear and draw time of all leaves.
+     * @param compositeTime the summed readback and transmit time.
+     */
+    EQSERVER_API void addSample(uint32_t frame, float drawTime,
+                                float compositeTime);
+
+    /**
+     * Select the mode for the given frame.
+     *
+     * @return MODE_DB or MODE_2D.
+     */
+    EQSERVER_API Mode select(uint32_t frame);
+
+    /** @return the current mode. */
+    Mode getMode() const { return _mode; }
+private:
+    struct Cost
+    {
+        Cost()
+            : time(0.f)
+            , age(0)
+            , valid(false)
+        {
+        }
+        float time;   //!< smoothed total time of one frame
+        uint32_t age; //!< samples since the last measurement in this mode
+        bool valid;
+    };
+
+    Mode _mode;
+    Cost _costs[2]; //!< indexed by _getIndex()
+    float _compositeShare;
+    uint32_t _switchFrame;
+    uint32_t _lastFrame;
+    uint32_t _samples; //!< samples since the last switch
+
+    static size_t _getIndex(const Mode mode)
+    {
+        return mode == fabric::Equalizer::MODE_DB ? 1 : 0;
+    }
+};
+}
+}
+
+#endif // EQSERVER_MODESELECTOR_H
@@ -0,0 +1,105 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pacingModel.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const size_t _nSamples = 64;    // frame times kept per source
+const float _decay = .95f;      // weight of a sample relative to a newer one
+const float _hysteresis = .03f; // ignore decreases below 3%
+}
+
+PacingModel::PacingModel()
+    : _interval(0.f)
+    , _percentile(.9f)
+    , _damping(.8f)
+{
+}
+
+void PacingModel::setNumSources(const size_t nSources)
+{
+    _times.clear();
+    _times.resize(nSources);
+    _interval = 0.f;
+}
+
+void PacingModel::addSample(const size_t source, const float time)
+{
+    LBASSERT(source < _times.size());
+    std::deque<float>& times = _times[source];
+    times.push_front(time);
+    if (times.size() > _nSamples)
+        times.pop_back();
+}
+
+float PacingModel::getPercentile(const size_t source) const
+{
+    LBASSERT(source < _times.size());
+    const std::deque<float>& times = _times[source];
+    if (times.empty())
+        return 0.f;
+
+    typedef std::pair<float, float> Sample; // time, weight
+    std::vector<Sample> samples;
+    samples.reserve(times.size());
+
+    float weight = 1.f;
+    float total = 0.f;
+    for (const float time : times)
+    {
+        samples.push_back(Sample(time, weight));
+        total += weight;
+        weight *= _decay;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const float limit = total * _percentile;
+    float sum = 0.f;
+    for (const Sample& sample : samples)
+    {
+        sum += sample.second;
+        if (sum >= limit)
+            return sample.first;
+    }
+    return samples.back().first;
+}
+
+float PacingModel::update()
+{
+    float target = 0.f;
+    for (size_t i = 0; i < _times.size(); ++i)
+        target = std::max(target, getPercentile(i));
+
+    if (target <= 0.f)
+        return _interval;
+
+    if (target > _interval)
+        _interval = target;
+    else if (target < _interval * (1.f - _hysteresis))
+        _interval = _interval * _damping + target * (1.f - _damping);
+    return _interval;
+}
+}
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_PACINGMODEL_H
+#define EQSERVER_PACINGMODEL_H
+
+#include <eq/server/api.h>
+
+#include <deque>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Computes the target frame interval of a FramerateEqualizer.
+ *
+ * Each source keeps a distribution of its recent frame times. The times are
+ * normalized by the source's DPlex period, and older samples decay
+ * exponentially. The interval is a high percentile of the slowest source, so a
+ * single hiccup does not change it. When the sources get slower, the interval
+ * rises immediately, which avoids late frames. When they get faster, it falls
+ * by the damping factor. Decreases below the hysteresis are ignored.
+ */
+class PacingModel
+{
+public:
+    EQSERVER_API PacingModel();
+
+    /** Set the number of sources, dropping all samples. */
+    EQSERVER_API void setNumSources(size_t nSources);
+
+    /** Add a normalized frame time in milliseconds for the given source. */
+    EQSERVER_API void addSample(size_t source, float time);
+
+    /**
+     * Update the interval from the samples received so far.
+     *
+     * @return the new interval in milliseconds, or 0 without samples.
+     */
+    EQSERVER_API float update();
+
+    /** @return the current interval in milliseconds, or 0. */
+    float getInterval() const { return _interval; }
+
+    /** @return the frame time percentile of the given source. */
+    EQSERVER_API float getPercentile(size_t source) const;
+
+    /** Set the percentile of the frame times used, in ]0, 1]. */
+    void setPercentile(const float percentile) { _percentile = percentile; }
+
+    /** Set the weight of the old interval when the interval falls. */
+    void setDamping(const float damping) { _damping = damping; }
+
+    /** @return the weight of the old interval when the interval falls. */
+    float getDamping() const { return _damping; }
+
+private:
+    std::vector<std::deque<float>> _times; //!< newest first, per source
+    float _interval;
+    float _percentile;
+    float _damping;
+};
+}
+}
+
+#endif // EQSERVER_PACINGMODEL_H
@@ -20,6 +20,7 @@
 
 #include "../compound.h"
 #include "../log.h"
+#include "equalizerStore.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
@@ -36,6 +37,7 @@ std::ostream& operator<<(std::ostream& os, const TreeEqualizer::Node*);
 
 TreeEqualizer::TreeEqualizer()
     : _tree(0)
+    , _seeding(true)
 {
     LBINFO << "New TreeEqualizer @" << (void*)this << std::endl;
 }
@@ -44,6 +46,7 @@ TreeEqualizer::TreeEqualizer(const TreeEqualizer& from)
     : Equalizer(from)
     , ChannelListener(from)
     , _tree(0)
+    , _seeding(true)
 {
 }
 
@@ -76,16 +79,106 @@ void TreeEqualizer::notifyUpdatePre(Compound* compound,
             return;
         default:
             _tree = _buildTree(children);
+            _seeding = true;
+            _applyState();
         }
     }
 
     // compute new data
     _update(_tree);
-    _split(_tree);
+    if (_seeding)
+        _seedSplit(_tree);
+    else
+        _split(_tree);
     _assign(_tree, Viewport(), Range());
     LBLOG(LOG_LB2) << "LB tree: " << _tree;
 }
 
+void TreeEqualizer::saveState(EqualizerStore& store) const
+{
+    if (!_tree)
+        return;
+
+    EqualizerStore::State state;
+    _getState(_tree, state);
+    store.set(getStateKey(), state);
+}
+
+void TreeEqualizer::loadState(const EqualizerStore& store)
+{
+    const EqualizerStore::State* state = store.get(getStateKey());
+    if (!state)
+        return;
+
+    _state = *state;
+    if (_tree)
+        _applyState();
+}
+
+void TreeEqualizer::resetState()
+{
+    _clearTree(_tree);
+    delete _tree;
+    _tree = 0;
+    _state.clear();
+}
+
+void TreeEqualizer::_getState(const Node* node, std::vector<float>& state)
+{
+    if (!node)
+        return;
+
+    state.push_back(node->split);
+    state.push_back(float(node->time));
+    _getState(node->left, state);
+    _getState(node->right, state);
+}
+
+void TreeEqualizer::_setState(Node* node, const std::vector<float>& state,
+                              size_t& index)
+{
+    if (!node)
+        return;
+
+    node->split = state[index++];
+    node->oldsplit = node->split;
+    node->time = LB_MAX(int64_t(state[index++]), 1);
+    _setState(node->left, state, index);
+    _setState(node->right, state, index);
+}
+
+void TreeEqualizer::_applyState()
+{
+    std::vector<float> current;
+    _getState(_tree, current);
+    if (current.size() == _state.size())
+    {
+        size_t index = 0;
+        _setState(_tree, _state, index);
+        _seeding = false;
+        LBLOG(LOG_LB1) << "Restored tree for " << getStateKey() << std::endl;
+    }
+    _state.clear();
+}
+
+float TreeEqualizer::_seedSplit(Node* node)
+{
+    const Compound* compound = node->compound;
+    if (compound)
+    {
+        if (!compound->isActive())
+            return 0.f;
+        const Channel* channel = compound->getChannel();
+        return compound->getUsage() * channel->getResourceWeight();
+    }
+
+    const float left = _seedSplit(node->left);
+    const float right = _seedSplit(node->right);
+    if (left + right > 0.f)
+        node->split = left / (left + right);
+    return left + right;
+}
+
 TreeEqualizer::Node* TreeEqualizer::_buildTree(const Compounds& compounds)
 {
     Node* node = new Node;
@@ -197,6 +290,7 @@ void TreeEqualizer::_notifyLoadData(Node* node, Channel* channel,
     node->time = endTime - startTime;
     node->time = LB_MAX(node->time, 1);
     node->time = LB_MAX(node->time, timeTransmit);
+    _seeding = false;
 }
 
 void TreeEqualizer::_update(Node* node)
@@ -51,6 +51,16 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::TREE_EQUALIZER; }
+
+    /** Save the split and time of each tree node. */
+    void saveState(EqualizerStore& store) const final;
+
+    /** Restore the splits and times of a tree of the same size. */
+    void loadState(const EqualizerStore& store) final;
+
+    /** Drop the tree, which is rebuilt with the default splits. */
+    void resetState() final;
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override { LBASSERT(!_tree); }
     void notifyChildRemove(Compound*, Compound*) override { LBASSERT(!_tree); }
@@ -95,6 +105,9 @@ private:
 
     Node* _tree; // <! The binary split tree of all children
 
+    std::vector<float> _state; //!< restored state, applied once _tree exists
+    bool _seeding; //!< split by channel weights until load data arrives
+
     //-------------------- Methods --------------------
     /** @return true if we have a valid LB tree */
     Node* _buildTree(const Compounds& children);
@@ -102,6 +115,20 @@ private:
     /** Clear the tree, does not delete the nodes. */
     void _clearTree(Node* node);
 
+    /** Append the split and time of each node in pre-order. */
+    static void _getState(const Node* node, std::vector<float>& state);
+    /** Set the split and time of each node in pre-order. */
+    static void _setState(Node* node, const std::vector<float>& state,
+                          size_t& index);
+    /** Apply and clear _state if it matches the tree. */
+    void _applyState();
+
+    /**
+     * Split the tree by the resource weights of the channels.
+     * @return the weighted resources of the node.
+     */
+    float _seedSplit(Node* node);
+
     void _notifyLoadData(Node* node, Channel* channel,
                          const Statistics& statistics);
 
@@ -22,6 +22,8 @@
 #include "../config.h"
 #include "../log.h"
 #include "../pipe.h"
+#include "../server.h"
+#include "../view.h"
 
 #include <eq/fabric/statistic.h>
 
@@ -52,6 +54,9 @@ ViewEqualizer::~ViewEqualizer()
 }
 
 ViewEqualizer::Listener::Listener()
+    : _lastFrame(0)
+    , _lastEnd(0)
+    , _fps(0.f)
 {
 }
 
@@ -305,15 +310,11 @@ void ViewEqualizer::_update(const uint32_t frameNumber)
 
     //----- Gather data for frame
     Loads loads;
-    int64_t totalTime(0);
 
     for (Listeners::iterator i = _listeners.begin(); i != _listeners.end(); ++i)
     {
         Listener& listener = *i;
-        const Listener::Load& load = listener.useLoad(frame);
-
-        totalTime += load.time;
-        loads.push_back(load);
+        loads.push_back(listener.useLoad(frame));
     }
 
     const Compound* compound = getCompound();
@@ -322,17 +323,32 @@ void ViewEqualizer::_update(const uint32_t frameNumber)
         // always execute code above to not leak memory
         return;
 
-    if (totalTime == 0) // no data
-        totalTime = 1;
-
-    const float resourceTime(static_cast<float>(totalTime) /
-                             static_cast<float>(_nPipes));
-    LBLOG(LOG_LB1) << resourceTime << "ms/resource" << std::endl;
-
-    //----- Assign new resource usage
+    //----- Schedule resources to views
     const Compounds& children = compound->getChildren();
     const size_t size(_listeners.size());
     LBASSERT(children.size() == size);
+
+    ViewScheduler::Views views;
+    bool scheduled = false;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const Channel* channel = children[i]->getInheritChannel();
+        const View* view = channel ? channel->getView() : 0;
+        ViewScheduler::View entry(static_cast<float>(loads[i].time));
+        if (view)
+        {
+            entry.targetFPS = view->getEqualizer().getTargetFrameRate();
+            entry.weight = view->getEqualizer().getWeight();
+            scheduled = scheduled || entry.targetFPS > 0.f ||
+                        entry.weight != 1.f;
+        }
+        views.push_back(entry);
+    }
+    ViewScheduler::schedule(views, static_cast<float>(_nPipes));
+    if (scheduled)
+        _sendStatistics(frame, loads, views);
+
+    //----- Assign new resource usage
     lunchbox::PtrHash<Pipe*, float> pipeUsage;
     float* leftOvers = static_cast<float*>(alloca(size * sizeof(float)));
 
@@ -346,7 +362,7 @@ void ViewEqualizer::_update(const uint32_t frameNumber)
         if (!child->isActive())
             continue;
 
-        float segmentResources(load.time / resourceTime);
+        float segmentResources(LB_MAX(views[i].share, MIN_USAGE));
 
         LBLOG(LOG_LB1) << "----- balance step 1 for view " << i << " ("
                        << child->getChannel()->getName() << " "
@@ -421,6 +437,46 @@ void ViewEqualizer::_update(const uint32_t frameNumber)
     }
 }
 
+void ViewEqualizer::_sendStatistics(const uint32_t frame, const Loads& loads,
+                                    const ViewScheduler::Views& views)
+{
+    if (frame == 0) // no data yet
+        return;
+
+    Config* config = getConfig();
+    const Compounds& children = getCompound()->getChildren();
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        const Compound* child = children[i];
+        const Channel* channel = child->getInheritChannel();
+        const View* view = channel ? channel->getView() : 0;
+        if (!child->isActive() || !view)
+            continue;
+
+        const Listener::Load& load = loads[i];
+        Statistic statistic;
+        statistic.type = Statistic::VIEW_FPS;
+        statistic.serial = view->getSerial();
+        statistic.originator = view->getID();
+        statistic.time = config->getServer()->getTime();
+        statistic.frameNumber = frame;
+        statistic.task = child->getTaskID();
+        statistic.startTime = load.start;
+        statistic.endTime = load.end;
+        statistic.ratio = views[i].share;
+        statistic.currentFPS = load.fps;
+        statistic.targetFPS = views[i].targetFPS;
+        snprintf(statistic.resourceName, 32, "%s", view->getName().c_str());
+        statistic.resourceName[31] = 0;
+        config->sendStatistic(statistic);
+
+        LBLOG(LOG_LB1) << "View " << view->getName() << " at "
+                       << statistic.currentFPS << " of "
+                       << statistic.targetFPS << " FPS using "
+                       << statistic.ratio << " resources" << std::endl;
+    }
+}
+
 uint32_t ViewEqualizer::_findInputFrameNumber() const
 {
     LBASSERT(!_listeners.empty());
@@ -578,6 +634,9 @@ ViewEqualizer::Listener::Load::Load(const uint32_t frame_,
     , missing(missing_)
     , nResources(missing_)
     , time(time_)
+    , start(std::numeric_limits<int64_t>::max())
+    , end(0)
+    , fps(0.f)
 {
 }
 
@@ -644,6 +703,8 @@ void ViewEqualizer::Listener::notifyLoadData(Channel* channel,
 
     const int64_t time = LB_MAX(endTime - startTime, transmitTime);
     load.time += time;
+    load.start = LB_MIN(load.start, startTime);
+    load.end = LB_MAX(load.end, endTime);
     --load.missing;
 
     if (load.missing == 0)
@@ -680,6 +741,20 @@ const ViewEqualizer::Listener::Load& ViewEqualizer::Listener::useLoad(
             if (load.time == 0)
                 load.time = 1;
 
+            // completion interval of the frames finished since the last use
+            if (_lastFrame > 0 && load.frame > _lastFrame &&
+                load.end > _lastEnd)
+            {
+                _fps = 1000.f * float(load.frame - _lastFrame) /
+                       float(load.end - _lastEnd);
+            }
+            if (load.frame != _lastFrame)
+            {
+                _lastFrame = load.frame;
+                _lastEnd = load.end;
+            }
+            load.fps = _fps;
+
             ++i;
             _loads.erase(i, _loads.end());
             return load;
@@ -20,6 +20,7 @@
 
 #include "../channelListener.h" // nested base class
 #include "equalizer.h"          // base class
+#include "viewScheduler.h"      // member
 
 #include <deque>
 #include <lunchbox/hash.h>
@@ -34,6 +35,12 @@ std::ostream& operator<<(std::ostream& os, const ViewEqualizer*);
 /**
  * An Equalizer allocating resources to multiple destination channels of a
  * single view.
+ *
+ * The resources are split between the children using a ViewScheduler. The
+ * target frame rate and weight of each child's view are read from the view's
+ * equalizer settings. When any view has a target or a weight, the achieved and
+ * target frame rate of each view is sent to the application as a
+ * Statistic::VIEW_FPS event.
  */
 class ViewEqualizer : public Equalizer
 {
@@ -84,6 +91,9 @@ private:
             uint32_t missing;
             uint32_t nResources;
             int64_t time;
+            int64_t start; //!< first draw start time of all resources
+            int64_t end;   //!< last draw end time of all resources
+            float fps;     //!< frame rate since the previously used load
         };
 
         /** @return the frame number of the youngest complete load. */
@@ -101,6 +111,10 @@ private:
         typedef std::deque<Load> LoadDeque;
         LoadDeque _loads;
 
+        uint32_t _lastFrame; //!< frame of the previously used load
+        int64_t _lastEnd;    //!< draw end time of the previously used load
+        float _fps;          //!< last frame rate between two used loads
+
         Load& _getLoad(const uint32_t frameNumber);
         friend std::ostream& operator<<(std::ostream& os,
                                         const ViewEqualizer::Listener&);
@@ -126,6 +140,9 @@ private:
     void _update(const uint32_t frameNumber);
     /** Find the frame number to use for update. */
     uint32_t _findInputFrameNumber() const;
+    /** Send the achieved and target frame rate of each view. */
+    void _sendStatistics(const uint32_t frame, const Loads& loads,
+                         const ViewScheduler::Views& views);
 };
 std::ostream& operator<<(std::ostream& os,
                          const ViewEqualizer::Listener& listener);
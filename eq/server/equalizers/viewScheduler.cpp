@@ -0,0 +1,112 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "viewScheduler.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+typedef std::vector<ViewScheduler::View*> ViewPtrs;
+
+/** Distribute resources in proportion to weight times cost. */
+void _distribute(const ViewPtrs& views, const float nResources)
+{
+    float total = 0.f;
+    for (const ViewScheduler::View* view : views)
+        total += view->weight * view->cost;
+
+    for (ViewScheduler::View* view : views)
+    {
+        if (total > 0.f)
+            view->share += nResources * view->weight * view->cost / total;
+        else
+            view->share += nResources / float(views.size());
+    }
+}
+}
+
+float ViewScheduler::getNeed(const View& view)
+{
+    return view.cost * view.targetFPS * .001f;
+}
+
+float ViewScheduler::getFPS(const View& view)
+{
+    if (view.cost <= 0.f)
+        return 0.f;
+    return 1000.f * view.share / view.cost;
+}
+
+void ViewScheduler::schedule(Views& views, float nResources)
+{
+    ViewPtrs targeted;
+    ViewPtrs others;
+    ViewPtrs all;
+    for (View& view : views)
+    {
+        LBASSERT(view.weight > 0.f);
+        view.share = 0.f;
+        all.push_back(&view);
+        if (getNeed(view) > 0.f)
+            targeted.push_back(&view);
+        else
+            others.push_back(&view);
+    }
+
+    // Fill the needs of the targeted views. Each round gives the unsaturated
+    // views resources in proportion to weight times need, and saturates the
+    // views whose need is met.
+    while (!targeted.empty() && nResources > 0.f)
+    {
+        float total = 0.f;
+        for (const View* view : targeted)
+            total += view->weight * getNeed(*view);
+
+        const float scale = nResources / total;
+        ViewPtrs unsaturated;
+        for (View* view : targeted)
+        {
+            if (scale * view->weight >= 1.f)
+            {
+                view->share = getNeed(*view);
+                nResources -= view->share;
+            }
+            else
+                unsaturated.push_back(view);
+        }
+
+        if (unsaturated.size() == targeted.size()) // no view saturated
+        {
+            for (View* view : targeted)
+                view->share = scale * view->weight * getNeed(*view);
+            nResources = 0.f;
+        }
+        targeted.swap(unsaturated);
+    }
+
+    if (nResources <= 0.f)
+        return;
+    _distribute(others.empty() ? all : others, nResources);
+}
+}
+}
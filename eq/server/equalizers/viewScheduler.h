@@ -0,0 +1,72 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_VIEWSCHEDULER_H
+#define EQSERVER_VIEWSCHEDULER_H
+
+#include <eq/server/api.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Splits the resources of a ViewEqualizer between its views.
+ *
+ * Views with a target frame rate first receive the resources needed to reach
+ * it, estimated from their cost. When not all targets can be met, the
+ * resources are shared in proportion to weight times need. The remaining
+ * resources are distributed to the views without a target, or to all views if
+ * every view has one, in proportion to weight times cost. Without targets and
+ * weights this is the cost-proportional split of the ViewEqualizer.
+ */
+class ViewScheduler
+{
+public:
+    /** The input and output of one view. */
+    struct View
+    {
+        View(const float cost_, const float targetFPS_ = 0.f,
+             const float weight_ = 1.f)
+            : cost(cost_)
+            , targetFPS(targetFPS_)
+            , weight(weight_)
+            , share(0.f)
+        {
+        }
+
+        float cost;      //!< time of the view on a single resource, in ms
+        float targetFPS; //!< frame rate to schedule for, or 0
+        float weight;    //!< priority of the view
+        float share;     //!< output: the number of assigned resources
+    };
+    typedef std::vector<View> Views;
+
+    /** Compute the share of each view from the given number of resources. */
+    EQSERVER_API static void schedule(Views& views, float nResources);
+
+    /** @return the resources needed by a view to reach its target, or 0. */
+    EQSERVER_API static float getNeed(const View& view);
+
+    /** @return the frame rate expected for the share of a view. */
+    EQSERVER_API static float getFPS(const View& view);
+};
+}
+}
+
+#endif // EQSERVER_VIEWSCHEDULER_H
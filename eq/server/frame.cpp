@@ -19,6 +19,7 @@
 #include "frame.h"
 
 #include "compound.h"
+#include "config.h"
 #include "frameData.h"
 #include "node.h"
 
@@ -29,6 +30,15 @@ namespace eq
 {
 namespace server
 {
+namespace
+{
+bool _usePlan(const Compound* compound)
+{
+    return compound && compound->getConfig()->getIAttribute(
+                           Config::IATTR_FRAME_PLAN) == fabric::ON;
+}
+}
+
 Frame::Frame()
     : _compound(0)
     , _buffers(Buffer::undefined)
@@ -97,13 +107,25 @@ void Frame::commitData()
             if (_frameData[i] != _masterFrameData)
                 _frameData[i]->fabric::FrameData::operator=(*_masterFrameData);
 
-            _frameData[i]->commit();
+            if (_usePlan(_compound)) // sent by Node::update
+                _frameData[i]->advancePlanVersion();
+            else
+                _frameData[i]->commit();
         }
     }
 }
 
 uint128_t Frame::commit(const uint32_t incarnation)
 {
+    if (_usePlan(_compound))
+    {
+        for (unsigned i = 0; i < NUM_EYES; ++i)
+            _setDataVersion(i, _frameData[i] ? _frameData[i]->getPlanVersion()
+                                             : co::ObjectVersion());
+        getNode()->addPlannedFrame(this);
+        return getVersion();
+    }
+
     for (unsigned i = 0; i < NUM_EYES; ++i)
         _setDataVersion(i, co::ObjectVersion(_frameData[i]));
     return co::Object::commit(incarnation);
@@ -56,6 +56,11 @@ public:
     {
         return (_frameData[lunchbox::getIndexOfLastBit(eye)] != 0);
     }
+    /** @return the frame data of the given eye pass, or 0. */
+    const FrameData* getData(const Eye eye) const
+    {
+        return _frameData[lunchbox::getIndexOfLastBit(eye)];
+    }
 
     /**
      * Set the frame's viewport wrt the compound (output frames) or wrt the
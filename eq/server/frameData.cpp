@@ -27,6 +27,7 @@ namespace server
 {
 FrameData::FrameData()
     : _frameNumber(0)
+    , _planVersion(co::VERSION_FIRST.low())
 {
     setBuffers(fabric::Frame::Buffer::undefined);
 }
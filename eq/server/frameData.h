@@ -23,6 +23,8 @@
 #include <eq/fabric/frameData.h> // member
 #include <eq/server/types.h>
 
+#include <co/objectVersion.h> // return value
+
 namespace eq
 {
 namespace server
@@ -46,6 +48,13 @@ public:
     /** Set the output frame zoom factor. */
     void setZoom(const Zoom& zoom_) { _zoom = zoom_; }
     const Zoom& getZoom() const { return _zoom; }
+    /** Advance the version sent in frame plans instead of committing. */
+    void advancePlanVersion() { ++_planVersion; }
+    /** @return the identifier and version sent in frame plans. */
+    co::ObjectVersion getPlanVersion() const
+    {
+        return co::ObjectVersion(getID(), uint128_t(0, _planVersion));
+    }
     //@}
 
 protected:
@@ -62,6 +71,9 @@ private:
 
     /** The number of the config frame when this data was last used. */
     uint32_t _frameNumber;
+
+    /** The version of the data in frame plans, starts at the registration. */
+    uint64_t _planVersion;
 };
 }
 }
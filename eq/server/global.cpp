@@ -66,6 +66,9 @@ void Global::_setupDefaults()
 
     _configFAttributes[Config::FATTR_EYE_BASE] = 0.05f;
     _configIAttributes[Config::IATTR_ROBUSTNESS] = fabric::AUTO;
+    _configIAttributes[Config::IATTR_FRAME_PLAN] = fabric::OFF;
+    _configIAttributes[Config::IATTR_LAUNCH_THREADS] = 16;
+    _configIAttributes[Config::IATTR_LAUNCH_FANOUT] = fabric::OFF;
 
     // node
     for (uint32_t i = 0; i < Node::CATTR_ALL; ++i)
@@ -124,6 +127,7 @@ void Global::_setupDefaults()
     _channelIAttributes[Channel::IATTR_HINT_STATISTICS] = fabric::NICEST;
 #endif
     _channelIAttributes[Channel::IATTR_HINT_SENDTOKEN] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_READBACK_DEPTH] = fabric::AUTO;
 
     // compound
     for (uint32_t i = 0; i < Compound::IATTR_ALL; ++i)
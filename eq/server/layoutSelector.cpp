@@ -0,0 +1,116 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "layoutSelector.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const float _unmeasured = std::numeric_limits<float>::max();
+}
+
+LayoutSelector::LayoutSelector(const size_t nCandidates, const size_t selected)
+    : _costs(nCandidates, _unmeasured)
+    , _selected(selected)
+    , _current(selected)
+    , _skipped(0)
+    , _warmup(5)
+    , _nSamples(10)
+    , _hysteresis(.1f)
+    , _evaluating(false)
+{
+    LBASSERT(selected < nCandidates);
+}
+
+void LayoutSelector::restart()
+{
+    _costs.assign(_costs.size(), _unmeasured);
+    _times.clear();
+    _skipped = 0;
+    _current = _selected;
+    _evaluating = _costs.size() > 1;
+}
+
+void LayoutSelector::select(const size_t candidate)
+{
+    LBASSERT(candidate < _costs.size());
+    _times.clear();
+    _skipped = 0;
+    _selected = candidate;
+    _current = candidate;
+    _evaluating = false;
+}
+
+bool LayoutSelector::addSample(const size_t candidate, const float time)
+{
+    if (!_evaluating || candidate != _current)
+        return false;
+
+    if (_skipped < _warmup)
+    {
+        ++_skipped;
+        return false;
+    }
+
+    _times.push_back(time);
+    if (_times.size() < std::max(_nSamples, size_t(1)))
+        return false;
+
+    std::vector<float>::iterator median = _times.begin() + _times.size() / 2;
+    std::nth_element(_times.begin(), median, _times.end());
+    _costs[_current] = *median;
+    _times.clear();
+    _skipped = 0;
+
+    const size_t previous = _current;
+    _current = _findUnmeasured();
+    if (_current == _costs.size())
+        _finish();
+    return _current != previous;
+}
+
+float LayoutSelector::getCost(const size_t candidate) const
+{
+    const float cost = _costs[candidate];
+    return cost == _unmeasured ? 0.f : cost;
+}
+
+size_t LayoutSelector::_findUnmeasured() const
+{
+    return std::find(_costs.begin(), _costs.end(), _unmeasured) -
+           _costs.begin();
+}
+
+void LayoutSelector::_finish()
+{
+    const size_t best =
+        std::min_element(_costs.begin(), _costs.end()) - _costs.begin();
+    if (_costs[best] < _costs[_selected] * (1.f - _hysteresis))
+        _selected = best;
+
+    _current = _selected;
+    _evaluating = false;
+}
+}
+}
@@ -0,0 +1,99 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_LAYOUTSELECTOR_H
+#define EQSERVER_LAYOUTSELECTOR_H
+
+#include <eq/server/api.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Selects the fastest of a set of candidate layouts from measured frame times.
+ *
+ * An evaluation measures each candidate in turn, starting with the selected
+ * one. The first frames after a switch are ignored to let the equalizers
+ * converge, the cost of the candidate is the median of the following frame
+ * times. Once all candidates are measured, the fastest one is selected if it
+ * is faster than the previously selected one by more than the hysteresis.
+ */
+class LayoutSelector
+{
+public:
+    /** Construct a new selector using the given candidate. */
+    EQSERVER_API explicit LayoutSelector(size_t nCandidates,
+                                         size_t selected = 0);
+
+    /** Start a new evaluation of all candidates. */
+    EQSERVER_API void restart();
+
+    /** Select the given candidate, cancelling a running evaluation. */
+    EQSERVER_API void select(size_t candidate);
+
+    /**
+     * Add the time of a frame rendered with the given candidate.
+     *
+     * Frames of other candidates than the current one are ignored.
+     * @return true if the current candidate changed.
+     */
+    EQSERVER_API bool addSample(size_t candidate, float time);
+
+    /** @return the candidate to render the next frames with. */
+    size_t getCurrent() const { return _current; }
+
+    /** @return the fastest known candidate. */
+    size_t getSelected() const { return _selected; }
+
+    /** @return true while the candidates are measured. */
+    bool isEvaluating() const { return _evaluating; }
+
+    /** @return the measured cost of the given candidate in ms, or 0. */
+    EQSERVER_API float getCost(size_t candidate) const;
+
+    /** Set the number of frames ignored after a switch. */
+    void setWarmup(const size_t frames) { _warmup = frames; }
+
+    /** Set the number of frames measured per candidate. */
+    void setNumSamples(const size_t frames) { _nSamples = frames; }
+
+    /** Set the relative speedup needed to change the selection. */
+    void setHysteresis(const float hysteresis) { _hysteresis = hysteresis; }
+
+    /** @return the relative speedup needed to change the selection. */
+    float getHysteresis() const { return _hysteresis; }
+
+private:
+    std::vector<float> _costs; //!< median frame time, max if not measured
+    std::vector<float> _times; //!< of the current candidate
+    size_t _selected;
+    size_t _current;
+    size_t _skipped;
+    size_t _warmup;
+    size_t _nSamples;
+    float _hysteresis;
+    bool _evaluating;
+
+    size_t _findUnmeasured() const;
+    void _finish();
+};
+}
+}
+
+#endif // EQSERVER_LAYOUTSELECTOR_H
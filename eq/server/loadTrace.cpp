@@ -0,0 +1,467 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "loadTrace.h"
+
+#include "canvas.h"
+#include "channel.h"
+#include "compound.h"
+#include "compoundUpdateActivateVisitor.h"
+#include "compoundUpdateDataVisitor.h"
+#include "config.h"
+#include "layout.h"
+#include "node.h"
+#include "observer.h"
+#include "pipe.h"
+#include "view.h"
+#include "window.h"
+
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const char* const _header = "# Equalizer load trace 2";
+
+/** @return all channels of the config in a stable order */
+Channels _getChannels(const Config& config)
+{
+    Channels channels;
+    for (const Node* node : config.getNodes())
+        for (const Pipe* pipe : node->getPipes())
+            for (const Window* window : pipe->getWindows())
+                for (Channel* channel : window->getChannels())
+                    channels.push_back(channel);
+    return channels;
+}
+
+/** @return the name of the statistic type as a single token */
+std::string _getToken(const Statistic::Type type)
+{
+    std::string name = Statistic::getName(type);
+    std::replace(name.begin(), name.end(), ' ', '_');
+    return name;
+}
+
+/** @return the statistic type of the given token, or NONE */
+Statistic::Type _getType(const std::string& token)
+{
+    for (int i = 1; i < Statistic::ALL; ++i)
+        if (_getToken(Statistic::Type(i)) == token)
+            return Statistic::Type(i);
+    return Statistic::NONE;
+}
+
+size_t _getIndex(const Channels& channels, const Channel* channel)
+{
+    return std::find(channels.begin(), channels.end(), channel) -
+           channels.begin();
+}
+
+/** @return true for the statistics scaling with the work of a split */
+bool _isRenderStatistic(const Statistic& stat)
+{
+    switch (stat.type)
+    {
+    case Statistic::CHANNEL_CLEAR:
+    case Statistic::CHANNEL_DRAW:
+    case Statistic::CHANNEL_READBACK:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/** @return the relative cost of rendering a split */
+float _getWork(const Viewport& vp, const Range& range)
+{
+    return vp.getArea() * (range.end - range.start);
+}
+
+/** Calls the functor for all active drawing compounds with a channel. */
+template <class F>
+class DrawVisitor : public CompoundVisitor
+{
+public:
+    explicit DrawVisitor(const F& func)
+        : _func(func)
+    {
+    }
+
+    VisitorResult visit(const Compound* compound) override
+    {
+        if (compound->getChannel() &&
+            compound->testInheritTask(fabric::TASK_DRAW) &&
+            compound->isActive())
+        {
+            _func(compound);
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    const F& _func;
+};
+
+template <class F>
+void _forEachDraw(const Config& config, const F& func)
+{
+    DrawVisitor<F> visitor(func);
+    for (Compound* compound : config.getCompounds())
+        compound->accept(visitor);
+}
+}
+
+LoadRecorder::LoadRecorder(Config& config, const std::string& filename)
+    : _config(config)
+    , _channels(_getChannels(config))
+    , _file(filename.c_str())
+{
+    if (!_file)
+    {
+        LBWARN << "Can't open load trace " << filename << std::endl;
+        return;
+    }
+
+    _file << _header << '\n';
+    for (Channel* channel : _channels)
+        channel->addListener(this);
+    LBINFO << "Recording load of " << _channels.size() << " channels to "
+           << filename << std::endl;
+}
+
+LoadRecorder::~LoadRecorder()
+{
+    for (Channel* channel : _channels)
+        channel->removeListener(this);
+}
+
+void LoadRecorder::recordSplits(const uint32_t frameNumber)
+{
+    if (!_file)
+        return;
+
+    _forEachDraw(_config, [&](const Compound* compound) {
+        const Channel* channel = compound->getChannel();
+        const Viewport& vp = compound->getInheritViewport();
+        const Range& range = compound->getInheritRange();
+
+        _file << "split " << frameNumber << " "
+              << _getIndex(_channels, channel) << " "
+              << compound->getTaskID() << " " << vp.x << " " << vp.y << " "
+              << vp.w << " " << vp.h << " " << range.start << " "
+              << range.end << " " << channel->getName() << '\n';
+    });
+}
+
+void LoadRecorder::notifyLoadData(Channel* channel, const uint32_t frameNumber,
+                                  const Statistics& statistics,
+                                  const Viewport& region)
+{
+    if (!_file)
+        return;
+
+    _file << "load " << _config.getCurrentFrame() << " " << frameNumber << " "
+          << _getIndex(_channels, channel) << " " << region.x << " "
+          << region.y << " " << region.w << " " << region.h << " "
+          << statistics.size();
+    for (const Statistic& stat : statistics)
+        _file << " " << _getToken(stat.type) << " " << stat.task << " "
+              << stat.startTime << " " << stat.endTime;
+    _file << " " << channel->getName() << '\n';
+}
+
+LoadReplay::LoadReplay(Config& config)
+    : _config(config)
+    , _lastFrame(0)
+{
+}
+
+LoadReplay::~LoadReplay()
+{
+}
+
+bool LoadReplay::read(std::istream& trace)
+{
+    std::string line;
+    if (!std::getline(trace, line) || line != _header)
+    {
+        LBWARN << "Not a load trace" << std::endl;
+        return false;
+    }
+
+    // The recorded render time of each task, used to predict the replay
+    std::map<Key, float> times;
+    for (size_t lineNumber = 2; std::getline(trace, line); ++lineNumber)
+    {
+        std::istringstream stream(line);
+        std::string kind;
+        stream >> kind;
+
+        if (kind == "split")
+        {
+            uint32_t frame = 0;
+            size_t channel = 0;
+            uint32_t task = 0;
+            Viewport vp;
+            Range range;
+            stream >> frame >> channel >> task >> vp.x >> vp.y >> vp.w >>
+                vp.h >> range.start >> range.end;
+            if (!stream)
+            {
+                LBWARN << "Malformed split in line " << lineNumber
+                       << std::endl;
+                return false;
+            }
+            _recordedWork[Key(frame, channel, task)] = _getWork(vp, range);
+            _lastFrame = std::max(_lastFrame, frame);
+        }
+        else if (kind == "load")
+        {
+            Load load;
+            size_t nStats = 0;
+            stream >> load.currentFrame >> load.frameNumber >> load.channel >>
+                load.region.x >> load.region.y >> load.region.w >>
+                load.region.h >> nStats;
+            if (!stream)
+            {
+                LBWARN << "Malformed load in line " << lineNumber << std::endl;
+                return false;
+            }
+
+            load.statistics.resize(nStats);
+            for (Statistic& stat : load.statistics)
+            {
+                std::string type;
+                stream >> type >> stat.task >> stat.startTime >> stat.endTime;
+                stat.type = _getType(type);
+                stat.frameNumber = load.frameNumber;
+                if (stream && stat.type == Statistic::NONE)
+                {
+                    LBWARN << "Unknown statistic " << type << " in line "
+                           << lineNumber << std::endl;
+                    return false;
+                }
+
+                if (_isRenderStatistic(stat))
+                    times[Key(load.frameNumber, load.channel, stat.task)] +=
+                        float(stat.endTime - stat.startTime);
+            }
+            if (!stream)
+            {
+                LBWARN << "Malformed load in line " << lineNumber << std::endl;
+                return false;
+            }
+            _loads.push_back(load);
+        }
+        else if (!kind.empty() && kind[0] != '#')
+        {
+            LBWARN << "Unknown entry " << kind << " in line " << lineNumber
+                   << std::endl;
+            return false;
+        }
+    }
+
+    for (const auto& time : times)
+    {
+        const auto i = _recordedWork.find(time.first);
+        if (i == _recordedWork.end() || i->second <= 0.f)
+            continue;
+
+        const Task task(std::get<1>(time.first), std::get<2>(time.first));
+        _densities[task][std::get<0>(time.first)] = time.second / i->second;
+    }
+    return true;
+}
+
+LoadReplay::Frames LoadReplay::run()
+{
+    _init();
+
+    Frames frames;
+    std::vector<Load>::const_iterator next = _loads.begin();
+    for (uint32_t frame = 1; frame <= _lastFrame; ++frame)
+    {
+        // deliver the load data received before the frame was started
+        for (; next != _loads.end() && next->currentFrame < frame; ++next)
+            _deliver(*next);
+        frames.push_back(_update(frame));
+    }
+    for (; next != _loads.end(); ++next)
+        _deliver(*next);
+
+    for (Frame& frame : frames)
+    {
+        float sum = 0.f;
+        frame.time = 0.f;
+        for (Split& split : frame.splits)
+        {
+            const Key key(frame.frameNumber, split.channel, split.task);
+            split.time = _predict(key, _getWork(split.vp, split.range));
+            sum += split.time;
+            frame.time = std::max(frame.time, split.time);
+        }
+        frame.imbalance =
+            frame.time > 0.f
+                ? 1.f - sum / float(frame.splits.size()) / frame.time
+                : 0.f;
+    }
+
+    _exit();
+    return frames;
+}
+
+void LoadReplay::_init()
+{
+    // Without render clients, pipes without a configured viewport have no
+    // size. Assume a full HD display for them.
+    for (Node* node : _config.getNodes())
+        for (Pipe* pipe : node->getPipes())
+            if (!pipe->getPixelViewport().isValid())
+                pipe->setPixelViewport(PixelViewport(0, 0, 1920, 1080));
+
+    for (Compound* compound : _config.getCompounds())
+        compound->init();
+    for (Observer* observer : _config.getObservers())
+        observer->init();
+    for (Canvas* canvas : _config.getCanvases())
+        canvas->init();
+    for (const Layout* layout : _config.getLayouts())
+        for (View* view : layout->getViews())
+            view->init();
+
+    _channels = _getChannels(_config);
+    for (Channel* channel : _channels)
+        channel->setState(STATE_RUNNING);
+
+    _update(0); // sets up the active state, as Config::_init
+}
+
+void LoadReplay::_exit()
+{
+    for (Canvas* canvas : _config.getCanvases())
+        canvas->exit();
+    for (Compound* compound : _config.getCompounds())
+        compound->exit();
+    for (Channel* channel : _channels)
+        channel->setState(STATE_STOPPED);
+}
+
+LoadReplay::Frame LoadReplay::_update(const uint32_t frameNumber)
+{
+    // Compound::update without the output and input frame updates, which
+    // need registered frames. The data update runs the equalizers.
+    for (Compound* compound : _config.getCompounds())
+    {
+        CompoundUpdateActivateVisitor activateVisitor(frameNumber);
+        compound->accept(activateVisitor);
+
+        CompoundUpdateDataVisitor dataVisitor(frameNumber);
+        compound->accept(dataVisitor);
+    }
+
+    Frame frame;
+    frame.frameNumber = frameNumber;
+    frame.time = 0.f;
+    frame.imbalance = 0.f;
+
+    _forEachDraw(_config, [&](const Compound* compound) {
+        const Channel* channel = compound->getChannel();
+        Split split;
+        split.channel = _getIndex(_channels, channel);
+        split.task = compound->getTaskID();
+        split.name = channel->getName();
+        split.vp = compound->getInheritViewport();
+        split.range = compound->getInheritRange();
+        split.time = 0.f;
+
+        _replayedWork[Key(frameNumber, split.channel, split.task)] =
+            _getWork(split.vp, split.range);
+        frame.splits.push_back(split);
+    });
+    return frame;
+}
+
+void LoadReplay::_deliver(const Load& load)
+{
+    if (load.channel >= _channels.size())
+    {
+        LBWARN << "Ignoring load of unknown channel " << load.channel
+               << std::endl;
+        return;
+    }
+
+    // Stretch the render statistics of each task by the change of its work,
+    // keeping their order and the start of the first one.
+    Statistics statistics = load.statistics;
+    std::map<uint32_t, int64_t> starts;
+    for (const Statistic& stat : statistics)
+    {
+        if (!_isRenderStatistic(stat))
+            continue;
+        auto i = starts.find(stat.task);
+        if (i == starts.end())
+            starts[stat.task] = stat.startTime;
+        else
+            i->second = std::min(i->second, stat.startTime);
+    }
+
+    for (Statistic& stat : statistics)
+    {
+        if (!_isRenderStatistic(stat))
+            continue;
+
+        const Key key(load.frameNumber, load.channel, stat.task);
+        const auto recorded = _recordedWork.find(key);
+        const auto replayed = _replayedWork.find(key);
+        if (recorded == _recordedWork.end() || recorded->second <= 0.f ||
+            replayed == _replayedWork.end())
+        {
+            continue;
+        }
+
+        const double scale = replayed->second / recorded->second;
+        const int64_t start = starts[stat.task];
+        stat.startTime = start + int64_t((stat.startTime - start) * scale);
+        stat.endTime = start + int64_t((stat.endTime - start) * scale);
+    }
+
+    _channels[load.channel]->fireLoadData(load.frameNumber, statistics,
+                                          load.region);
+}
+
+float LoadReplay::_predict(const Key& key, const float work) const
+{
+    const auto i =
+        _densities.find(Task(std::get<1>(key), std::get<2>(key)));
+    if (i == _densities.end())
+        return 0.f;
+
+    // use the density of the frame, or else of the closest recorded frame
+    const std::map<uint32_t, float>& densities = i->second;
+    auto j = densities.upper_bound(std::get<0>(key));
+    if (j != densities.begin())
+        --j;
+    return j->second * work;
+}
+}
+}
@@ -0,0 +1,148 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_LOADTRACE_H
+#define EQSERVER_LOADTRACE_H
+
+#include <eq/server/api.h>
+#include <eq/server/channelListener.h> // base class
+#include <eq/server/types.h>
+
+#include <eq/fabric/range.h>
+#include <eq/fabric/statistic.h>
+#include <eq/fabric/viewport.h>
+
+#include <fstream>
+#include <map>
+#include <tuple>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Records the load data of all channels of a running config.
+ *
+ * The trace is a text file. For each frame, it has the split of every drawing
+ * compound, followed by the load data as it is received from the channels.
+ * Channels are identified by their index in the config, their name is only
+ * informational. Statistics are identified by their name, with spaces replaced
+ * by underscores, which keeps traces valid when Statistic::Type changes.
+ * Recording is enabled by setting EQ_SERVER_LOAD_TRACE to the trace file name.
+ */
+class LoadRecorder : public ChannelListener
+{
+public:
+    /** Record the load of the given config to the given file. */
+    EQSERVER_API LoadRecorder(Config& config, const std::string& filename);
+    EQSERVER_API virtual ~LoadRecorder();
+
+    /** @return true if the trace file is open. */
+    bool isGood() const { return _file.good(); }
+    /** Record the splits of all drawing compounds for the updated frame. */
+    EQSERVER_API void recordSplits(uint32_t frameNumber);
+
+    /** @sa ChannelListener::notifyLoadData */
+    void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                        const Statistics& statistics,
+                        const Viewport& region) override;
+
+private:
+    Config& _config;
+    Channels _channels;
+    std::ofstream _file;
+};
+
+/**
+ * Replays a load trace through a config without render nodes.
+ *
+ * The config is initialized locally, without launching any node. For each
+ * frame the compounds are updated, which runs the equalizers, and the
+ * recorded load data is delivered to the channels in the recorded order. When
+ * an equalizer computes a different split than recorded, the recorded render
+ * times are scaled by the ratio of the new to the recorded split area, i.e.,
+ * the load is assumed to be uniform within a channel.
+ */
+class LoadReplay
+{
+public:
+    /** The replayed split and predicted render time of one compound. */
+    struct Split
+    {
+        size_t channel; //!< index of the channel in the config
+        uint32_t task;  //!< task ID of the compound
+        std::string name;
+        Viewport vp;
+        Range range;
+        float time; //!< predicted clear, draw and readback time in ms
+    };
+    typedef std::vector<Split> Splits;
+
+    /** The replay result of one frame. */
+    struct Frame
+    {
+        uint32_t frameNumber;
+        Splits splits;
+        float time;      //!< predicted frame time, the slowest split
+        float imbalance; //!< 1 - mean / max split time, 0 is balanced
+    };
+    typedef std::vector<Frame> Frames;
+
+    /** Replay on the given, stopped config. */
+    EQSERVER_API explicit LoadReplay(Config& config);
+    EQSERVER_API ~LoadReplay();
+
+    /** Read a trace written by a LoadRecorder. @return success. */
+    EQSERVER_API bool read(std::istream& trace);
+
+    /** Run all recorded frames. @return the result per frame. */
+    EQSERVER_API Frames run();
+
+private:
+    /** frame, channel index, task ID */
+    typedef std::tuple<uint32_t, size_t, uint32_t> Key;
+
+    struct Load
+    {
+        uint32_t currentFrame; //!< config frame when the load arrived
+        uint32_t frameNumber;
+        size_t channel;
+        Viewport region;
+        Statistics statistics;
+    };
+
+    Config& _config;
+    Channels _channels;
+    std::vector<Load> _loads;
+    std::map<Key, float> _recordedWork;
+    std::map<Key, float> _replayedWork;
+
+    /** Recorded render time per work of a channel task, per frame */
+    typedef std::pair<size_t, uint32_t> Task;
+    std::map<Task, std::map<uint32_t, float>> _densities;
+    uint32_t _lastFrame;
+
+    void _init();
+    void _exit();
+    Frame _update(uint32_t frameNumber);
+    void _deliver(const Load& load);
+    float _predict(const Key& key, float work) const;
+};
+
+}
+}
+
+#endif // EQSERVER_LOADTRACE_H
@@ -71,6 +71,7 @@
         static eq::server::Observer*    observer = 0;
         static eq::server::Compound*    eqCompound = 0; // avoid name clash
         static eq::server::DFREqualizer* dfrEqualizer = 0;
+        static eq::server::FramerateEqualizer* framerateEqualizer = 0;
         static eq::server::LoadEqualizer* loadEqualizer = 0;
         static eq::server::TreeEqualizer* treeEqualizer = 0;
         static eq::server::TileEqualizer* tileEqualizer = 0;
@@ -102,6 +103,7 @@
 %token EQTOKEN_GLOBAL
 %token EQTOKEN_CHANNEL_IATTR_HINT_STATISTICS
 %token EQTOKEN_CHANNEL_IATTR_HINT_SENDTOKEN
+%token EQTOKEN_CHANNEL_IATTR_HINT_READBACK_DEPTH
 %token EQTOKEN_CHANNEL_SATTR_DUMP_IMAGE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_MODE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_LEFT_MASK
@@ -114,14 +116,19 @@
 %token EQTOKEN_CONNECTION_IATTR_PORT
 %token EQTOKEN_CONFIG_FATTR_EYE_BASE
 %token EQTOKEN_CONFIG_IATTR_ROBUSTNESS
+%token EQTOKEN_CONFIG_IATTR_FRAME_PLAN
+%token EQTOKEN_CONFIG_IATTR_LAUNCH_THREADS
+%token EQTOKEN_CONFIG_IATTR_LAUNCH_FANOUT
 %token EQTOKEN_NODE_SATTR_LAUNCH_COMMAND
 %token EQTOKEN_NODE_CATTR_LAUNCH_COMMAND_QUOTE
 %token EQTOKEN_NODE_IATTR_THREAD_MODEL
 %token EQTOKEN_NODE_IATTR_HINT_AFFINITY
+%token EQTOKEN_NODE_IATTR_HINT_NUMA_NODE
 %token EQTOKEN_NODE_IATTR_HINT_STATISTICS
 %token EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT
 %token EQTOKEN_PIPE_IATTR_HINT_THREAD
 %token EQTOKEN_PIPE_IATTR_HINT_AFFINITY
+%token EQTOKEN_PIPE_IATTR_HINT_NUMA_NODE
 %token EQTOKEN_VIEW_SATTR_DEFLECT_HOST
 %token EQTOKEN_WINDOW_IATTR_HINT_CORE_PROFILE
 %token EQTOKEN_WINDOW_IATTR_HINT_OPENGL_MAJOR
@@ -160,10 +167,12 @@
 %token EQTOKEN_HINT_DECORATION
 %token EQTOKEN_HINT_STATISTICS
 %token EQTOKEN_HINT_SENDTOKEN
+%token EQTOKEN_HINT_READBACK_DEPTH
 %token EQTOKEN_HINT_SWAPSYNC
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
 %token EQTOKEN_HINT_AFFINITY
+%token EQTOKEN_HINT_NUMA_NODE
 %token EQTOKEN_HINT_SCREENSAVER
 %token EQTOKEN_HINT_GRAB_POINTER
 %token EQTOKEN_PLANES_COLOR
@@ -234,6 +243,9 @@
 %token EQTOKEN_OPENCV_CAMERA
 %token EQTOKEN_VRPN_TRACKER
 %token EQTOKEN_ROBUSTNESS
+%token EQTOKEN_FRAME_PLAN
+%token EQTOKEN_LAUNCH_THREADS
+%token EQTOKEN_LAUNCH_FANOUT
 %token EQTOKEN_THREAD_MODEL
 %token EQTOKEN_ASYNC
 %token EQTOKEN_DRAW_SYNC
@@ -285,6 +297,7 @@
 %token EQTOKEN_2D
 %token EQTOKEN_ASSEMBLE_ONLY_LIMIT
 %token EQTOKEN_DB
+%token EQTOKEN_HYBRID
 %token EQTOKEN_BOUNDARY
 %token EQTOKEN_RESISTANCE
 %token EQTOKEN_ZOOM
@@ -375,6 +388,21 @@ global:
          eq::server::Global::instance()->setConfigIAttribute(
              eq::server::Config::IATTR_ROBUSTNESS, $2 );
      }
+     | EQTOKEN_CONFIG_IATTR_FRAME_PLAN IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_FRAME_PLAN, $2 );
+     }
+     | EQTOKEN_CONFIG_IATTR_LAUNCH_THREADS IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_LAUNCH_THREADS, $2 );
+     }
+     | EQTOKEN_CONFIG_IATTR_LAUNCH_FANOUT IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_LAUNCH_FANOUT, $2 );
+     }
      | EQTOKEN_NODE_SATTR_LAUNCH_COMMAND STRING
      {
          eq::server::Global::instance()->setNodeSAttribute(
@@ -395,6 +423,11 @@ global:
          eq::server::Global::instance()->setNodeIAttribute(
              eq::server::Node::IATTR_HINT_AFFINITY, $2 );
      }
+     | EQTOKEN_NODE_IATTR_HINT_NUMA_NODE IATTR
+     {
+         eq::server::Global::instance()->setNodeIAttribute(
+             eq::server::Node::IATTR_HINT_NUMA_NODE, $2 );
+     }
      | EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT UNSIGNED
      {
          eq::server::Global::instance()->setNodeIAttribute(
@@ -415,6 +448,11 @@ global:
          eq::server::Global::instance()->setPipeIAttribute(
              eq::server::Pipe::IATTR_HINT_AFFINITY, $2 );
      }
+     | EQTOKEN_PIPE_IATTR_HINT_NUMA_NODE IATTR
+     {
+         eq::server::Global::instance()->setPipeIAttribute(
+             eq::server::Pipe::IATTR_HINT_NUMA_NODE, $2 );
+     }
      | EQTOKEN_WINDOW_IATTR_HINT_CORE_PROFILE IATTR
      {
          eq::server::Global::instance()->setWindowIAttribute(
@@ -530,6 +568,11 @@ global:
          eq::server::Global::instance()->setChannelIAttribute(
              eq::server::Channel::IATTR_HINT_SENDTOKEN, $2 );
      }
+     | EQTOKEN_CHANNEL_IATTR_HINT_READBACK_DEPTH IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_READBACK_DEPTH, $2 );
+     }
      | EQTOKEN_COMPOUND_IATTR_STEREO_MODE IATTR
      {
          eq::server::Global::instance()->setCompoundIAttribute(
@@ -610,6 +653,12 @@ configAttribute:
                              eq::server::Config::FATTR_EYE_BASE, $2 ); }
     | EQTOKEN_ROBUSTNESS IATTR { config->setIAttribute(
                                  eq::server::Config::IATTR_ROBUSTNESS, $2 ); }
+    | EQTOKEN_FRAME_PLAN IATTR { config->setIAttribute(
+                                 eq::server::Config::IATTR_FRAME_PLAN, $2 ); }
+    | EQTOKEN_LAUNCH_THREADS IATTR { config->setIAttribute(
+                             eq::server::Config::IATTR_LAUNCH_THREADS, $2 ); }
+    | EQTOKEN_LAUNCH_FANOUT IATTR { config->setIAttribute(
+                              eq::server::Config::IATTR_LAUNCH_FANOUT, $2 ); }
 
 node: appNode | renderNode
 renderNode: EQTOKEN_NODE '{' {
@@ -667,6 +716,8 @@ nodeAttribute:
         }
     | EQTOKEN_HINT_AFFINITY IATTR
         { node->setIAttribute( eq::server::Node::IATTR_HINT_AFFINITY, $2 ); }
+    | EQTOKEN_HINT_NUMA_NODE IATTR
+        { node->setIAttribute( eq::server::Node::IATTR_HINT_NUMA_NODE, $2 ); }
 
 
 pipe: EQTOKEN_PIPE '{'
@@ -693,6 +744,8 @@ pipeAttribute:
         { eqPipe->setIAttribute( eq::server::Pipe::IATTR_HINT_THREAD, $2 ); }
     | EQTOKEN_HINT_AFFINITY IATTR
         { eqPipe->setIAttribute( eq::server::Pipe::IATTR_HINT_AFFINITY, $2); }
+    | EQTOKEN_HINT_NUMA_NODE IATTR
+        { eqPipe->setIAttribute( eq::server::Pipe::IATTR_HINT_NUMA_NODE, $2); }
 
 window: EQTOKEN_WINDOW '{'
             {
@@ -784,6 +837,9 @@ channelAttribute:
     | EQTOKEN_HINT_SENDTOKEN IATTR
         { channel->setIAttribute( eq::server::Channel::IATTR_HINT_SENDTOKEN,
                                   $2 ); }
+    | EQTOKEN_HINT_READBACK_DEPTH IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_READBACK_DEPTH, $2 ); }
     | EQTOKEN_DUMP_IMAGE STRING
         { channel->setSAttribute( eq::server::Channel::SATTR_DUMP_IMAGE,
                                   $2 ); }
@@ -1163,9 +1219,12 @@ dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
         eqCompound->addEqualizer( dfrEqualizer );
         dfrEqualizer = 0;
     }
-framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{' '}'
+framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{'
+    { framerateEqualizer = new eq::server::FramerateEqualizer; }
+    framerateEqualizerFields '}'
     {
-        eqCompound->addEqualizer( new eq::server::FramerateEqualizer );
+        eqCompound->addEqualizer( framerateEqualizer );
+        framerateEqualizer = 0;
     }
 loadEqualizer: EQTOKEN_LOADEQUALIZER '{'
     { loadEqualizer = new eq::server::LoadEqualizer; }
@@ -1202,6 +1261,11 @@ dfrEqualizerField:
     EQTOKEN_DAMPING FLOAT      { dfrEqualizer->setDamping( $2 ); }
     | EQTOKEN_FRAMERATE FLOAT  { dfrEqualizer->setFrameRate( $2 ); }
 
+framerateEqualizerFields:
+    /* null */ | framerateEqualizerFields framerateEqualizerField
+framerateEqualizerField:
+    EQTOKEN_DAMPING FLOAT      { framerateEqualizer->setDamping( $2 ); }
+
 loadEqualizerFields: /* null */ | loadEqualizerFields loadEqualizerField
 loadEqualizerField:
     EQTOKEN_DAMPING FLOAT            { loadEqualizer->setDamping( $2 ); }
@@ -1220,6 +1284,7 @@ loadEqualizerMode:
     | EQTOKEN_DB         { $$ = eq::server::LoadEqualizer::MODE_DB; }
     | EQTOKEN_HORIZONTAL { $$ = eq::server::LoadEqualizer::MODE_HORIZONTAL; }
     | EQTOKEN_VERTICAL   { $$ = eq::server::LoadEqualizer::MODE_VERTICAL; }
+    | EQTOKEN_HYBRID     { $$ = eq::server::LoadEqualizer::MODE_HYBRID; }
 
 treeEqualizerFields: /* null */ | treeEqualizerFields treeEqualizerField
 treeEqualizerField:
@@ -21,6 +21,8 @@
 
 #include "channel.h"
 #include "config.h"
+#include "frame.h"
+#include "frameData.h"
 #include "global.h"
 #include "log.h"
 #include "nodeFactory.h"
@@ -36,14 +38,19 @@
 #include <co/barrier.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
+#include <co/objectOCommand.h>
+#include <co/oCommand.h>
 
 #include <lunchbox/clock.h>
 #include <lunchbox/os.h>
+#include <lunchbox/scopedMutex.h>
 #include <lunchbox/sleep.h>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <algorithm>
+
 namespace eq
 {
 namespace server
@@ -86,6 +93,7 @@ Node::Node(Config* parent)
     , _state(STATE_STOPPED)
     , _bufferedTasks(new co::BufferConnection)
     , _lastDrawPipe(0)
+    , _launcher(0)
 {
     const Global* global = Global::instance();
     for (int i = 0; i < Node::SATTR_LAST; ++i)
@@ -259,9 +267,10 @@ static co::NodePtr _createNetNode(Node* node)
 }
 }
 
-bool Node::connect()
+bool Node::connect(const Node* launcher)
 {
     LBASSERT(isActive());
+    lunchbox::ScopedWrite mutex(_launchLock);
 
     if (_node)
         return _node->isConnected();
@@ -275,15 +284,22 @@ bool Node::connect()
     co::LocalNodePtr localNode = getLocalNode();
     LBASSERT(localNode);
 
+    _launchClock.reset();
     _node = _createNetNode(this);
 
     LBLOG(LOG_INIT) << "Connecting node" << std::endl;
-    if (localNode->connect(_node) ||
-        localNode->launch(_node, _createLaunchCommand()))
+    if (localNode->connect(_node))
+        return true;
+
+    if (launcher && launcher->isLaunchable())
     {
+        _launcher = launcher; // launched by Config::_connectNodes
         return true;
     }
 
+    if (localNode->launch(_node, _createLaunchCommand()))
+        return true;
+
     LBWARN << "Connection to " << _node->getNodeID() << " failed" << std::endl;
     sendError(fabric::ERROR_NODE_LAUNCH) << _host;
     _state = STATE_FAILED;
@@ -291,9 +307,43 @@ bool Node::connect()
     return false;
 }
 
-bool Node::syncLaunch(const lunchbox::Clock& clock)
+bool Node::isLaunchable() const
+{
+    lunchbox::ScopedWrite mutex(_launchLock);
+    return _node && _node->isConnected();
+}
+
+void Node::launch(const Nodes& nodes) const
+{
+    co::NodePtr netNode;
+    {
+        lunchbox::ScopedWrite mutex(_launchLock);
+        netNode = _node;
+    }
+    LBASSERT(netNode && netNode->isConnected());
+
+    co::LocalNodePtr localNode = getLocalNode();
+    co::OCommand command(netNode->send(fabric::CMD_CLIENT_LAUNCH));
+    command << int64_t(getIAttribute(IATTR_LAUNCH_TIMEOUT))
+            << getConfig()->getWorkDir() << uint32_t(nodes.size());
+
+    for (Node* node : nodes)
+    {
+        lunchbox::ScopedWrite mutex(node->_launchLock);
+        LBASSERT(node->_launcher == this);
+        node->_launchRequest.reset(
+            new lunchbox::Request<bool>(localNode->registerRequest<bool>()));
+
+        command << *node->_launchRequest << node->_node->serialize()
+                << node->getHost() << node->_node->getLaunchQuote()
+                << node->_createLaunchCommand();
+    }
+}
+
+bool Node::syncLaunch()
 {
     LBASSERT(isActive());
+    lunchbox::ScopedWrite mutex(_launchLock);
 
     if (!_node)
         return false;
@@ -305,17 +355,66 @@ bool Node::syncLaunch(const lunchbox::Clock& clock)
 
     co::LocalNodePtr localNode = getLocalNode();
     const int64_t timeOut = getIAttribute(IATTR_LAUNCH_TIMEOUT);
-    _node = localNode->syncLaunch(_node->getNodeID(),
-                                  std::max(int64_t(0),
-                                           timeOut - clock.getTime64()));
+
+    if (_launcher)
+        _syncDelegatedLaunch();
+    else
+        _node = localNode->syncLaunch(_node->getNodeID(),
+                                      std::max(int64_t(0),
+                                               timeOut -
+                                                   _launchClock.getTime64()));
     if (_node)
+    {
+        LBINFO << "Launched node " << getName() << " on " << _host << " by "
+               << (_launcher ? _launcher->getHost() : std::string("server"))
+               << " in " << _launchClock.getTime64() << " ms" << std::endl;
+        _launcher = 0;
         return true;
+    }
 
+    _launcher = 0;
     sendError(fabric::ERROR_NODE_CONNECT) << _host;
     _state = STATE_FAILED;
     return false;
 }
 
+void Node::_syncDelegatedLaunch()
+{
+    co::LocalNodePtr localNode = getLocalNode();
+    const int64_t timeOut = getIAttribute(IATTR_LAUNCH_TIMEOUT);
+    const co::NodeID nodeID = _node->getNodeID();
+    bool launched = false;
+
+    if (_launchRequest)
+    {
+        const int64_t left =
+            std::max(int64_t(0), timeOut - _launchClock.getTime64());
+        try
+        {
+            launched = _launchRequest->wait(uint32_t(left));
+        }
+        catch (const lunchbox::FutureTimeout&)
+        {
+            _launchRequest->relinquish();
+        }
+        _launchRequest.reset();
+    }
+
+    // the launched process connected to its launcher, connect through it
+    _node = launched ? localNode->connect(nodeID) : nullptr;
+    if (_node)
+        return;
+
+    LBWARN << "Launch of " << getName() << " by " << _launcher->getHost()
+           << " failed, launching from server" << std::endl;
+    _launchClock.reset();
+    _node = _createNetNode(this);
+    if (localNode->launch(_node, _createLaunchCommand()))
+        _node = localNode->syncLaunch(_node->getNodeID(), timeOut);
+    else
+        _node = nullptr;
+}
+
 std::string Node::_createLaunchCommand() const
 {
     const std::string& command = getSAttribute(SATTR_LAUNCH_COMMAND);
@@ -457,7 +556,10 @@ bool Node::syncConfigExit()
 void Node::update(const uint128_t& frameID, const uint32_t frameNumber)
 {
     if (!isRunning())
+    {
+        _plannedFrames.clear();
         return;
+    }
 
     LBVERB << "Start frame " << frameNumber << std::endl;
     LBASSERT(isActive());
@@ -468,8 +570,11 @@ void Node::update(const uint128_t& frameID, const uint32_t frameNumber)
     if (!isApplicationNode()) // synced in Config::_cmdFrameStart
         configVersion = getConfig()->getVersion();
 
-    send(fabric::CMD_NODE_FRAME_START) << getVersion() << configVersion
-                                       << frameID << frameNumber;
+    {
+        co::ObjectOCommand command(send(fabric::CMD_NODE_FRAME_START));
+        command << getVersion() << configVersion << frameID << frameNumber;
+        _sendFramePlan(command);
+    } // send before the pipe tasks
     LBLOG(LOG_TASKS) << "TASK node start frame " << std::endl;
 
     const Pipes& pipes = getPipes();
@@ -491,6 +596,40 @@ void Node::update(const uint128_t& frameID, const uint32_t frameNumber)
     flushSendBuffer();
 }
 
+void Node::addPlannedFrame(const Frame* frame)
+{
+    if (std::find(_plannedFrames.begin(), _plannedFrames.end(), frame) ==
+        _plannedFrames.end())
+    {
+        _plannedFrames.push_back(frame);
+    }
+}
+
+void Node::_sendFramePlan(co::ObjectOCommand& command)
+{
+    // empty unless the config uses frame plans, see Frame::commit
+    command << uint32_t(_plannedFrames.size());
+    for (const Frame* frame : _plannedFrames)
+    {
+        const bool isOutput = frame->getMasterData() != 0;
+        command << frame->getID() << isOutput;
+        frame->serialize(command);
+        if (!isOutput)
+            continue;
+
+        for (unsigned i = 0; i < NUM_EYES; ++i)
+        {
+            const FrameData* data = frame->getData(Eye(1 << i));
+            command << (data != 0);
+            if (data)
+                data->serialize(command);
+        }
+    }
+    LBLOG(LOG_ASSEMBLY) << "Sent " << _plannedFrames.size()
+                        << " planned frames" << std::endl;
+    _plannedFrames.clear();
+}
+
 uint32_t Node::_getFinishLatency() const
 {
     switch (getIAttribute(Node::IATTR_THREAD_MODEL))
@@ -757,7 +896,9 @@ void Node::output(std::ostream& os) const
                          ? "thread_model         "
                          : i == Node::IATTR_HINT_AFFINITY
                                ? "hint_affinity        "
-                               : "ERROR")
+                               : i == Node::IATTR_HINT_NUMA_NODE
+                                     ? "hint_numa_node       "
+                                     : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
 
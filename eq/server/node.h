@@ -30,7 +30,11 @@
 #include <co/bufferConnection.h>
 #include <co/connectionDescription.h>
 #include <co/node.h>
+#include <lunchbox/clock.h>   // member
+#include <lunchbox/lock.h>    // member
+#include <lunchbox/request.h> // member
 
+#include <memory>
 #include <vector>
 
 namespace eq
@@ -93,14 +97,33 @@ public:
      * @name Operations
      */
     //@{
-    /** Connect the render slave node process. */
-    bool connect();
+    /**
+     * Connect the render slave node process, launching it if needed.
+     *
+     * Thread-safe with respect to other nodes. If a launcher is given and
+     * running, the launch is deferred to it using launch().
+     *
+     * @param launcher the node launching this node, or 0 for the server.
+     * @return true on success, false on error.
+     */
+    bool connect(const Node* launcher = 0);
+
+    /** @return the node launching this node, or 0. */
+    const Node* getLauncher() const { return _launcher; }
+
+    /** @return true if this node can launch other nodes. */
+    bool isLaunchable() const;
 
-    /** Launch the render slave node process. */
-    bool launch();
+    /**
+     * Launch the given render slave node processes from this process.
+     *
+     * The launcher replies per node with CMD_CLIENT_LAUNCH_REPLY once the
+     * process is up or failed to start.
+     */
+    void launch(const Nodes& nodes) const;
 
     /** Synchronize the connection of a render slave launch. */
-    bool syncLaunch(const lunchbox::Clock& time);
+    bool syncLaunch();
 
     /** Start initializing this entity. */
     void configInit(const uint128_t& initID, const uint32_t frameNumber);
@@ -123,6 +146,13 @@ public:
      */
     void update(const uint128_t& frameID, const uint32_t frameNumber);
 
+    /**
+     * Add a frame to the plan sent with the next frame start.
+     *
+     * Used instead of committing frames when the config uses frame plans.
+     */
+    void addPlannedFrame(const Frame* frame);
+
     /**
      * Flush the processing of frames, including frameNumber.
      *
@@ -272,20 +302,33 @@ private:
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
+    /** The frames updated for the next frame start. */
+    std::vector<const Frame*> _plannedFrames;
+
+    /** The node launching this node during a tree launch. */
+    const Node* _launcher;
+
+    /** The time since the start of connect(). */
+    lunchbox::Clock _launchClock;
+
+    /** Served by the launcher once the delegated launch is done. */
+    std::unique_ptr<lunchbox::Request<bool>> _launchRequest;
+
+    /** Protects _node, _launcher and _launchRequest during a launch. */
+    mutable lunchbox::Lock _launchLock;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
-    /**
-     * Compose and execute the launch command by expanding the variables in
-     * the launch command string.
-     *
-     * @param description the connection description.
-     * @return true on success, false otherwise
-     */
-    bool _launch(const std::string& hostname) const;
     std::string _createLaunchCommand() const;
     std::string _createRemoteCommand() const;
 
+    /** Wait for the launcher, launch from the server if it failed. */
+    void _syncDelegatedLaunch();
+
+    /** Append the planned frames to the frame start command. */
+    void _sendFramePlan(co::ObjectOCommand& command);
+
     uint32_t _getFinishLatency() const;
     void _finish(const uint32_t currentFrame);
 
@@ -320,7 +320,10 @@ void Pipe::output(std::ostream& os) const
 
         os << (i == IATTR_HINT_THREAD
                    ? "hint_thread "
-                   : i == IATTR_HINT_AFFINITY ? "hint_affinity " : "ERROR")
+                   : i == IATTR_HINT_AFFINITY
+                         ? "hint_affinity "
+                         : i == IATTR_HINT_NUMA_NODE ? "hint_numa_node "
+                                                     : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
 
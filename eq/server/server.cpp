@@ -78,6 +78,8 @@ Server::Server()
                     &_mainThreadQueue);
     registerCommand(fabric::CMD_SERVER_DESTROY_CONFIG_REPLY,
                     ServerFunc(this, &Server::_cmdDestroyConfigReply), 0);
+    registerCommand(fabric::CMD_CLIENT_LAUNCH_REPLY,
+                    ServerFunc(this, &Server::_cmdLaunchReply), 0);
     registerCommand(fabric::CMD_SERVER_SHUTDOWN,
                     ServerFunc(this, &Server::_cmdShutdown), &_mainThreadQueue);
     registerCommand(fabric::CMD_SERVER_MAP, ServerFunc(this, &Server::_cmdMap),
@@ -314,6 +316,14 @@ bool Server::_cmdDestroyConfigReply(co::ICommand& command)
     return true;
 }
 
+bool Server::_cmdLaunchReply(co::ICommand& command)
+{
+    const uint32_t requestID = command.read<uint32_t>();
+    const bool launched = command.read<bool>();
+    serveRequest(requestID, launched);
+    return true;
+}
+
 bool Server::_cmdShutdown(co::ICommand& command)
 {
     const uint32_t requestID = command.read<uint32_t>();
@@ -88,6 +88,7 @@ private:
     bool _cmdChooseConfig(co::ICommand& command);
     bool _cmdReleaseConfig(co::ICommand& command);
     bool _cmdDestroyConfigReply(co::ICommand& command);
+    bool _cmdLaunchReply(co::ICommand& command);
     bool _cmdShutdown(co::ICommand& command);
     bool _cmdMap(co::ICommand& command);
     bool _cmdUnmap(co::ICommand& command);
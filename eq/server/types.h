@@ -29,6 +29,7 @@ namespace eq
 {
 namespace server
 {
+class AutoLayout;
 class Canvas;
 class Channel;
 class ChannelListener;
@@ -39,11 +40,14 @@ class Config;
 class ConfigVisitor;
 class DFREqualizer;
 class Equalizer;
+class EqualizerStore;
 class Frame;
 class FrameData;
 class FramerateEqualizer;
 class Layout;
 class LoadEqualizer;
+class LoadRecorder;
+class LoadReplay;
 class MonitorEqualizer;
 class Node;
 class NodeFactory;
@@ -64,6 +68,7 @@ typedef std::vector<Pipe*> Pipes;
 typedef std::vector<Window*> Windows;
 typedef std::vector<Channel*> Channels;
 
+typedef std::vector<AutoLayout*> AutoLayouts;
 typedef std::vector<Canvas*> Canvases;
 typedef std::vector<Compound*> Compounds;
 typedef std::vector<Frame*> Frames;
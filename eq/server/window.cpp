@@ -48,6 +48,7 @@ Window::Window(Pipe* parent)
     , _active(0)
     , _state(STATE_STOPPED)
     , _maxFPS(std::numeric_limits<float>::max())
+    , _frameOffset(0.f)
     , _nvSwapBarrier(0)
     , _nvNetBarrier(0)
     , _lastDrawChannel(0)
@@ -427,11 +428,13 @@ void Window::_updateSwap(const uint32_t frameNumber)
     if (_maxFPS < std::numeric_limits<float>::max())
     {
         const float minFrameTime = 1000.0f / _maxFPS;
-        send(fabric::CMD_WINDOW_THROTTLE_FRAMERATE) << minFrameTime;
+        send(fabric::CMD_WINDOW_THROTTLE_FRAMERATE) << minFrameTime
+                                                    << _frameOffset;
         LBLOG(LOG_TASKS) << "TASK Throttle framerate  " << minFrameTime
-                         << std::endl;
+                         << " offset " << _frameOffset << std::endl;
 
         _maxFPS = std::numeric_limits<float>::max();
+        _frameOffset = 0.f;
     }
 
     for (co::BarriersCIter i = _barriers.begin(); i != _barriers.end(); ++i)
@@ -120,6 +120,8 @@ public:
     /** The maximum frame rate for this window. @internal */
     void setMaxFPS(const float fps) { _maxFPS = fps; }
     float getMaxFPS() const { return _maxFPS; }
+    /** The offset in ms of the frame pacing grid. @internal */
+    void setFrameOffset(const float offset) { _frameOffset = offset; }
     //@}
 
     /**
@@ -177,6 +179,9 @@ private:
     /** The maximum frame rate allowed for this window. */
     float _maxFPS;
 
+    /** The offset of the frame pacing grid for _maxFPS. */
+    float _frameOffset;
+
     /** The list of master swap barriers for the current frame. */
     co::Barriers _masterBarriers;
     /** The list of slave swap barriers for the current frame. */
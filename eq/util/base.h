@@ -33,5 +33,6 @@
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 #include <eq/util/shader.h>
+#include <eq/util/uploader.h>
 
 #endif // EQUTIL_H
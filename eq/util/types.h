@@ -32,6 +32,7 @@ class AccumBufferObject;
 class FrameBufferObject;
 class PixelBufferObject;
 class Texture;
+class Uploader;
 class BitmapFont;
 class ObjectManager;
 
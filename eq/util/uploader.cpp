@@ -0,0 +1,585 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "uploader.h"
+
+// must be included before any header defining Bool
+#ifdef EQ_QT_USED
+#include "../qt/window.h"
+#include <QThread>
+#endif
+
+#include "pixelBufferObject.h"
+#include "texture.h"
+
+#include <eq/gl.h>
+#include <eq/pipe.h>
+#include <eq/systemWindow.h>
+#include <eq/window.h>
+#include <eq/windowSettings.h>
+#include <eq/windowSystem.h>
+
+#include <lunchbox/debug.h>
+#include <lunchbox/thread.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+
+namespace eq
+{
+namespace util
+{
+namespace
+{
+const size_t _maxInFlight = 4; // jobs uploading concurrently, size of PBO pool
+typedef std::shared_ptr<std::promise<bool>> PromisePtr;
+
+struct Job
+{
+    Job()
+        : priority(0)
+        , sequence(0)
+        , texture(0)
+        , buffer(0)
+        , data(0)
+        , size(0)
+        , offset(0)
+        , width(0)
+        , height(0)
+    {
+    }
+
+    /** Order by priority, then by submission. */
+    bool operator<(const Job& rhs) const
+    {
+        if (priority != rhs.priority)
+            return priority < rhs.priority;
+        return sequence > rhs.sequence;
+    }
+
+    int32_t priority;
+    uint64_t sequence;
+    const Texture* texture;
+    unsigned buffer;
+    const void* data;
+    size_t size;
+    size_t offset;
+    int32_t width;
+    int32_t height;
+    PromisePtr promise;
+};
+
+struct InFlight
+{
+    InFlight(const PromisePtr& promise_, PixelBufferObject* pbo_)
+        : promise(promise_)
+        , pbo(pbo_)
+        , fence(0)
+    {
+    }
+
+    PromisePtr promise;
+    PixelBufferObject* pbo;
+    GLsync fence;
+};
+
+/** @return the size of one pixel of the given external format. */
+size_t _getPixelSize(const unsigned format, const unsigned type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+        return 4;
+    }
+
+    size_t nChannels = 4;
+    switch (format)
+    {
+    case GL_RED:
+    case GL_GREEN:
+    case GL_BLUE:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+        nChannels = 1;
+        break;
+    case GL_LUMINANCE_ALPHA:
+    case GL_RG:
+        nChannels = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+        nChannels = 3;
+        break;
+    }
+
+    switch (type)
+    {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+        return nChannels;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        return nChannels * 2;
+    default:
+        return nChannels * 4;
+    }
+}
+}
+
+namespace detail
+{
+class Uploader;
+
+class UploadThread : public lunchbox::Thread
+{
+public:
+    explicit UploadThread(Uploader& uploader)
+        : _uploader(uploader)
+        , qThread(nullptr)
+    {
+    }
+
+    bool init() override
+    {
+        setName("Upload");
+#ifdef EQ_QT_USED
+        qThread = QThread::currentThread();
+#endif
+        return true;
+    }
+
+    void run() override;
+
+private:
+    Uploader& _uploader;
+
+public:
+    QThread* qThread;
+};
+
+class Uploader
+{
+public:
+    Uploader()
+        : window(0)
+        , sharedWindow(0)
+        , thread(0)
+        , budget(0)
+        , used(0)
+        , sequence(0)
+        , ready(false)
+        , stopping(false)
+    {
+    }
+
+    ~Uploader() { LBASSERT(!thread); }
+
+    const GLEWContext* glewGetContext() const
+    {
+        return sharedWindow->glewGetContext();
+    }
+
+    std::future<bool> push(Job& job)
+    {
+        job.promise = std::make_shared<std::promise<bool>>();
+        std::future<bool> future = job.promise->get_future();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!thread || stopping)
+        {
+            job.promise->set_value(false);
+            return future;
+        }
+        job.sequence = ++sequence;
+        jobs.push(job);
+        condition.notify_one();
+        return future;
+    }
+
+    void run()
+    {
+        {
+            // wait for the context to be moved to this thread (Qt)
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return ready; });
+        }
+
+        sharedWindow->makeCurrent();
+        EQ_GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+        for (;;)
+        {
+            Job job;
+            bool hasJob = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (inFlight.empty())
+                    condition.wait(lock,
+                                   [this] { return stopping || _canStart(); });
+                if (stopping)
+                    break;
+                if (_canStart())
+                {
+                    job = jobs.top();
+                    jobs.pop();
+                    used += job.size;
+                    hasJob = true;
+                }
+            }
+
+            if (hasJob)
+                _submit(job);
+            _retire(!hasJob);
+        }
+
+        _cancel();
+        while (!inFlight.empty())
+            _retire(true);
+        for (PixelBufferObject* pbo : pbos)
+        {
+            pbo->destroy();
+            delete pbo;
+        }
+        pbos.clear();
+        sharedWindow->doneCurrent();
+    }
+
+    const Window* window;
+    SystemWindow* sharedWindow;
+    UploadThread* thread;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::priority_queue<Job> jobs;
+    size_t budget;
+    size_t used; // bytes started in the current frame
+    uint64_t sequence;
+    bool ready;
+    bool stopping;
+
+    // upload thread only
+    std::deque<InFlight> inFlight;
+    std::vector<PixelBufferObject*> pbos; // unused pool
+
+private:
+    bool _canStart() const
+    {
+        if (jobs.empty() || inFlight.size() >= _maxInFlight)
+            return false;
+        return budget == 0 || used == 0 || used + jobs.top().size <= budget;
+    }
+
+    PixelBufferObject* _obtainPBO(const size_t size)
+    {
+        if (!GLEW_ARB_pixel_buffer_object)
+            return 0;
+
+        PixelBufferObject* pbo = 0;
+        if (pbos.empty())
+            pbo = new PixelBufferObject(glewGetContext());
+        else
+        {
+            pbo = pbos.back();
+            pbos.pop_back();
+        }
+
+        const Error error = pbo->setup(size, GL_WRITE_ONLY_ARB);
+        if (error == ERROR_NONE)
+            return pbo;
+
+        LBWARN << "Can't initialize PBO for upload: " << error << std::endl;
+        pbo->destroy();
+        delete pbo;
+        return 0;
+    }
+
+    /** Texture::upload() is bound to the render thread, upload directly */
+    void _upload(const Job& job, const void* ptr)
+    {
+        const Texture& texture = *job.texture;
+        EQ_GL_CALL(glBindTexture(texture.getTarget(), texture.getName()));
+        EQ_GL_CALL(glTexSubImage2D(texture.getTarget(), 0, 0, 0, job.width,
+                                   job.height, texture.getFormat(),
+                                   texture.getType(), ptr));
+        EQ_GL_CALL(glBindTexture(texture.getTarget(), 0));
+    }
+
+    void _submit(const Job& job)
+    {
+        PixelBufferObject* pbo = 0;
+        if (job.texture)
+        {
+            pbo = _obtainPBO(job.size);
+            void* ptr = pbo ? pbo->mapWrite() : 0;
+            if (ptr)
+            {
+                ::memcpy(ptr, job.data, job.size);
+                pbo->unmap();
+                pbo->bind();
+                _upload(job, 0);
+                pbo->unbind();
+            }
+            else
+            {
+                if (pbo)
+                {
+                    pbo->unbind();
+                    pbos.push_back(pbo);
+                    pbo = 0;
+                }
+                _upload(job, job.data);
+            }
+        }
+        else
+        {
+            EQ_GL_CALL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, job.buffer));
+            EQ_GL_CALL(glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, job.offset,
+                                          job.size, job.data));
+            EQ_GL_CALL(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+        }
+
+        inFlight.push_back(InFlight(job.promise, pbo));
+        if (GLEW_ARB_sync)
+            inFlight.back().fence =
+                glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+
+    /** Complete finished uploads, in submission order. */
+    void _retire(bool block)
+    {
+        const GLuint64 timeout = 1000000000ull; // 1s
+        while (!inFlight.empty())
+        {
+            InFlight& flight = inFlight.front();
+            if (flight.fence)
+            {
+                const GLenum status =
+                    glClientWaitSync(flight.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     block ? timeout : 0);
+                if (status == GL_TIMEOUT_EXPIRED)
+                {
+                    if (!block)
+                        return;
+                    continue;
+                }
+                if (status == GL_WAIT_FAILED)
+                    EQ_GL_ERROR("glClientWaitSync");
+                glDeleteSync(flight.fence);
+            }
+            else
+                glFinish();
+
+            if (flight.pbo)
+                pbos.push_back(flight.pbo);
+            flight.promise->set_value(true);
+            inFlight.pop_front();
+            block = false;
+        }
+    }
+
+    void _cancel()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!jobs.empty())
+        {
+            jobs.top().promise->set_value(false);
+            jobs.pop();
+        }
+    }
+};
+
+void UploadThread::run()
+{
+    _uploader.run();
+}
+}
+
+Uploader::Uploader()
+    : _impl(new detail::Uploader)
+{
+}
+
+Uploader::~Uploader()
+{
+    stop();
+    delete _impl;
+}
+
+bool Uploader::start(Window& window)
+{
+    if (_impl->thread)
+        return _impl->window == &window;
+
+    // create a shared system window with no drawable
+    WindowSettings settings = window.getSettings();
+    settings.setIAttribute(WindowSettings::IATTR_HINT_DRAWABLE, OFF);
+    const Window* sharedContextWindow = window.getSharedContextWindow();
+    settings.setSharedContextWindow(
+        sharedContextWindow ? sharedContextWindow->getSystemWindow() : 0);
+
+    const Pipe* pipe = window.getPipe();
+    SystemWindow* sharedWindow =
+        pipe->getWindowSystem().createWindow(&window, settings);
+    if (!sharedWindow)
+    {
+        LBERROR << "Window system " << pipe->getWindowSystem()
+                << " not implemented or supported" << std::endl;
+        return false;
+    }
+    if (!sharedWindow->configInit())
+    {
+        LBWARN << "Upload window initialization failed" << std::endl;
+        delete sharedWindow;
+        return false;
+    }
+
+    // #177: the driver realizes the context on the first makeCurrent
+    sharedWindow->makeCurrent();
+    sharedWindow->doneCurrent();
+    window.makeCurrent(false);
+
+    _impl->window = &window;
+    _impl->sharedWindow = sharedWindow;
+    _impl->ready = false;
+    _impl->stopping = false;
+    _impl->used = 0;
+    _impl->thread = new detail::UploadThread(*_impl);
+    if (!_impl->thread->start())
+    {
+        LBWARN << "Upload thread start failed" << std::endl;
+        delete _impl->thread;
+        _impl->thread = 0;
+        sharedWindow->configExit();
+        delete sharedWindow;
+        _impl->sharedWindow = 0;
+        _impl->window = 0;
+        return false;
+    }
+
+#ifdef EQ_QT_USED
+    // The window has to be created in the pipe thread (#177), but its context
+    // is used in the upload thread and Qt requires moving it to that thread.
+    qt::Window* qtWindow = dynamic_cast<qt::Window*>(sharedWindow);
+    if (qtWindow && _impl->thread->qThread)
+        qtWindow->moveContextToThread(_impl->thread->qThread);
+#endif
+
+    std::unique_lock<std::mutex> lock(_impl->mutex);
+    _impl->ready = true;
+    _impl->condition.notify_all();
+    return true;
+}
+
+void Uploader::stop()
+{
+    if (!_impl->thread)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(_impl->mutex);
+        _impl->stopping = true;
+        _impl->ready = true;
+        _impl->condition.notify_all();
+    }
+    _impl->thread->join();
+    delete _impl->thread;
+    _impl->thread = 0;
+
+    _impl->sharedWindow->configExit();
+    delete _impl->sharedWindow;
+    _impl->sharedWindow = 0;
+    _impl->window = 0;
+}
+
+bool Uploader::isRunning() const
+{
+    return _impl->thread != 0;
+}
+
+const Window* Uploader::getWindow() const
+{
+    return _impl->window;
+}
+
+void Uploader::setFrameBudget(const size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(_impl->mutex);
+    _impl->budget = bytes;
+    _impl->condition.notify_one();
+}
+
+size_t Uploader::getFrameBudget() const
+{
+    return _impl->budget;
+}
+
+void Uploader::startFrame()
+{
+    std::unique_lock<std::mutex> lock(_impl->mutex);
+    _impl->used = 0;
+    _impl->condition.notify_one();
+}
+
+std::future<bool> Uploader::upload(Texture& texture, const void* data,
+                                   const int32_t width, const int32_t height,
+                                   const int32_t priority)
+{
+    Job job;
+    job.priority = priority;
+    job.texture = &texture;
+    job.data = data;
+    job.width = width;
+    job.height = height;
+    job.size = size_t(width) * size_t(height) *
+               _getPixelSize(texture.getFormat(), texture.getType());
+
+    // resizing in the upload thread would race with rendering
+    if (!texture.isValid() || texture.getWidth() < width ||
+        texture.getHeight() < height)
+    {
+        LBWARN << "Texture not initialized for upload of " << width << "x"
+               << height << ": " << texture << std::endl;
+        std::promise<bool> promise;
+        promise.set_value(false);
+        return promise.get_future();
+    }
+    return _impl->push(job);
+}
+
+std::future<bool> Uploader::upload(const unsigned buffer, const void* data,
+                                   const size_t size, const size_t offset,
+                                   const int32_t priority)
+{
+    Job job;
+    job.priority = priority;
+    job.buffer = buffer;
+    job.data = data;
+    job.size = size;
+    job.offset = offset;
+    return _impl->push(job);
+}
+}
+}
@@ -0,0 +1,149 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQUTIL_UPLOADER_H
+#define EQUTIL_UPLOADER_H
+
+#include <eq/api.h>
+#include <eq/util/types.h>
+
+#include <future>
+
+namespace eq
+{
+namespace util
+{
+namespace detail
+{
+class Uploader;
+}
+
+/**
+ * Uploads textures and buffers asynchronously to the GPU.
+ *
+ * The uploader owns a thread with an OpenGL context shared with the window
+ * given to start(). Upload jobs are executed by priority, higher values first,
+ * and in submission order for equal priorities. Texture data is staged
+ * through a reusable pool of pixel buffer objects, which lets the upload of
+ * one job overlap with the copy of the next.
+ *
+ * The bytes uploaded per frame can be limited to keep the uploads from
+ * competing with rendering. Once the budget is used, the remaining jobs wait
+ * for the next frame. A job larger than the budget is executed alone in a
+ * frame.
+ *
+ * Each Pipe has an uploader, which is started by the application and resets
+ * its budget at the start of each frame. The returned futures are ready once
+ * the data is available to all contexts shared with the upload context. The
+ * application has to keep the data and the target object unchanged until then.
+ */
+class Uploader
+{
+public:
+    /** Construct a new, stopped uploader. @version 2.2 */
+    EQ_API Uploader();
+
+    /** Destruct this uploader, stopping it if needed. @version 2.2 */
+    EQ_API ~Uploader();
+
+    /**
+     * Start the upload thread.
+     *
+     * Creates a context shared with the given window. Has to be called from
+     * the thread of the window's pipe. The uploader has to be stopped before
+     * the window is exited.
+     *
+     * @param window the window to share the upload context with.
+     * @return true on success, false otherwise.
+     * @version 2.2
+     */
+    EQ_API bool start(Window& window);
+
+    /**
+     * Stop the upload thread and delete its context.
+     *
+     * Has to be called from the thread of the window's pipe. All pending jobs
+     * are cancelled and their futures return false.
+     * @version 2.2
+     */
+    EQ_API void stop();
+
+    /** @return true if the uploader is started. @version 2.2 */
+    EQ_API bool isRunning() const;
+
+    /** @return the window the context is shared with, or 0. @version 2.2 */
+    EQ_API const Window* getWindow() const;
+
+    /**
+     * Set the maximum number of bytes uploaded per frame.
+     *
+     * @param bytes the byte budget, or 0 for no limit (default).
+     * @version 2.2
+     */
+    EQ_API void setFrameBudget(size_t bytes);
+
+    /** @return the maximum number of bytes uploaded per frame. @version 2.2 */
+    EQ_API size_t getFrameBudget() const;
+
+    /** @internal Reset the frame budget, called by the pipe. */
+    EQ_API void startFrame();
+
+    /**
+     * Upload an image to a texture.
+     *
+     * The texture has to be initialized with its external format and at least
+     * the size of the image in the render thread, since it is not resized by
+     * the upload. The image is stored at 0,0. The data is tightly packed in
+     * the texture's external format.
+     *
+     * @param texture the target texture.
+     * @param data the image data.
+     * @param width the image width.
+     * @param height the image height.
+     * @param priority the job priority, higher is executed first.
+     * @return the future result of the upload.
+     * @version 2.2
+     */
+    EQ_API std::future<bool> upload(Texture& texture, const void* data,
+                                    int32_t width, int32_t height,
+                                    int32_t priority = 0);
+
+    /**
+     * Upload data to a buffer object.
+     *
+     * The buffer has to be allocated with at least offset + size bytes.
+     *
+     * @param buffer the OpenGL name of the target buffer object.
+     * @param data the data.
+     * @param size the number of bytes to upload.
+     * @param offset the target offset in the buffer, in bytes.
+     * @param priority the job priority, higher is executed first.
+     * @return the future result of the upload.
+     * @version 2.2
+     */
+    EQ_API std::future<bool> upload(unsigned buffer, const void* data,
+                                    size_t size, size_t offset = 0,
+                                    int32_t priority = 0);
+
+private:
+    Uploader(const Uploader&) = delete;
+    Uploader& operator=(const Uploader&) = delete;
+    detail::Uploader* const _impl;
+};
+}
+}
+
+#endif // EQUTIL_UPLOADER_H
@@ -22,6 +22,7 @@
 #include "channel.h"
 #include "client.h"
 #include "config.h"
+#include "detail/eventCoalescer.h"
 #include "error.h"
 #include "gl.h"
 #include "global.h"
@@ -44,12 +45,15 @@
 #include <eq/fabric/sizeEvent.h>
 #include <eq/fabric/task.h>
 #include <eq/util/objectManager.h>
+#include <eq/util/uploader.h>
 
 #include <co/barrier.h>
 #include <co/exception.h>
 #include <co/objectICommand.h>
 #include <lunchbox/sleep.h>
 
+#include <cmath>
+
 namespace eq
 {
 typedef fabric::Window<Pipe, Window, Channel, WindowSettings> Super;
@@ -582,6 +586,11 @@ bool Window::configExit()
     if (!_systemWindow)
         return true;
 
+    // the upload context is shared with and created from this window
+    util::Uploader& uploader = getPipe()->getUploader();
+    if (uploader.getWindow() == this)
+        uploader.stop();
+
     const bool ret = configExitGL();
     return configExitSystemWindow() && ret;
 }
@@ -680,7 +689,7 @@ bool Window::processEvent(const EventType type)
     Event event;
     updateEvent(event, config->getTime());
 
-    config->sendEvent(type) << event;
+    detail::EventCoalescer::send(this, config, type) << event;
     return true;
 }
 
@@ -722,7 +731,10 @@ bool Window::processEvent(const EventType type, SizeEvent& event)
         LBUNIMPLEMENTED;
     }
 
-    config->sendEvent(type) << event;
+    if (detail::EventCoalescer::isCoalesced(type))
+        detail::EventCoalescer::add(this, config, type, event);
+    else
+        detail::EventCoalescer::send(this, config, type) << event;
     return true;
 }
 
@@ -739,12 +751,12 @@ bool Window::processEvent(const EventType type, PointerEvent& event)
     {
     case EVENT_WINDOW_POINTER_GRAB:
         _grabbedChannels = channels;
-        config->sendEvent(type) << event;
+        detail::EventCoalescer::send(this, config, type) << event;
         return true;
 
     case EVENT_WINDOW_POINTER_UNGRAB:
         _grabbedChannels.clear();
-        config->sendEvent(type) << event;
+        detail::EventCoalescer::send(this, config, type) << event;
         return true;
 
     default:
@@ -787,7 +799,10 @@ bool Window::processEvent(const EventType type, PointerEvent& event)
             return true;
     }
 
-    config->sendEvent(type) << event;
+    if (detail::EventCoalescer::isCoalesced(type))
+        detail::EventCoalescer::add(this, config, type, event);
+    else
+        detail::EventCoalescer::send(this, config, type) << event;
     return true;
 }
 
@@ -797,7 +812,7 @@ bool Window::processEvent(const EventType type, KeyEvent& event)
     updateEvent(event, config->getTime());
 
     if (event.key != KC_VOID)
-        config->sendEvent(type) << event;
+        detail::EventCoalescer::send(this, config, type) << event;
     // else ignore
     return true;
 }
@@ -806,7 +821,7 @@ bool Window::processEvent(AxisEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_MAGELLAN_AXIS) << event;
+    detail::EventCoalescer::add(this, config, event);
     return true;
 }
 
@@ -814,7 +829,7 @@ bool Window::processEvent(ButtonEvent& event)
 {
     Config* config = getConfig();
     updateEvent(event, config->getTime());
-    config->sendEvent(EVENT_MAGELLAN_BUTTON) << event;
+    detail::EventCoalescer::send(this, config, EVENT_MAGELLAN_BUTTON) << event;
     return true;
 }
 
@@ -933,6 +948,7 @@ bool Window::_cmdConfigExit(co::ICommand& cmd)
         _state = configExit() ? STATE_STOPPED : STATE_FAILED;
     }
 
+    detail::EventCoalescer::clear(this); // events of the destroyed window
     getPipe()->send(getLocalNode(), fabric::CMD_PIPE_DESTROY_WINDOW) << getID();
     return true;
 }
@@ -999,10 +1015,21 @@ bool Window::_cmdThrottleFramerate(co::ICommand& cmd)
     LBLOG(LOG_TASKS) << "TASK throttle framerate " << getName() << " "
                      << command << std::endl;
 
-    // throttle to given framerate
-    const int64_t elapsed = getConfig()->getTime() - _lastSwapTime;
+    // Throttle to the next slot of a grid of the given frame time, shifted by
+    // the given offset. Unlike pacing relative to the last swap, a late frame
+    // does not delay all later frames, and the offsets of DPlex sources keep
+    // them spread over their period. A slightly late frame swaps right away.
     const float minFrameTime = command.read<float>();
-    const float timeLeft = minFrameTime - static_cast<float>(elapsed);
+    const float offset = command.read<float>();
+    const int64_t now = getConfig()->getTime();
+    const float elapsed = static_cast<float>(now - _lastSwapTime);
+    double phase = std::fmod(double(now) - offset, double(minFrameTime));
+    if (phase < 0.)
+        phase += minFrameTime;
+
+    float timeLeft = minFrameTime - static_cast<float>(phase);
+    if (phase < minFrameTime * .25f && elapsed >= minFrameTime * .75f)
+        timeLeft = 0.f;
 
     if (timeLeft >= 1.f)
     {
@@ -1,6 +1,6 @@
 
 /* Copyright (c) 2009-2011, Maxim Makhinya <maxmah@gmail.com>
- *               2012-2013, Stefan Eilemann <eile@eyescale.ch>
+ *               2012-2017, Stefan Eilemann <eile@eyescale.ch>
  *                    2014, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,16 +30,14 @@
  */
 
 #include "asyncFetcher.h"
-#include "eqAsync.h"
 
-#include <eq/eq.h>
-#include <eq/system.h>
+#include <chrono>
 
 namespace eqAsync
 {
 AsyncFetcher::AsyncFetcher()
     : lunchbox::Thread()
-    , _sharedWindow(0)
+    , _running(false)
 {
 }
 
@@ -48,123 +46,67 @@ AsyncFetcher::~AsyncFetcher()
     stop();
 }
 
-const GLEWContext* AsyncFetcher::glewGetContext() const
+void AsyncFetcher::setup()
 {
-    return _sharedWindow->glewGetContext();
+    _running = true;
+    start();
 }
 
-static eq::SystemWindow* initSharedContextWindow(eq::Window* window)
+void AsyncFetcher::stop()
 {
-    LBASSERT(window);
-
-    eq::WindowSettings settings = window->getSettings();
-    settings.setIAttribute(eq::WindowSettings::IATTR_HINT_DRAWABLE, eq::OFF);
-    const eq::Pipe* pipe = window->getPipe();
-    eq::SystemWindow* sharedWindow =
-        pipe->getWindowSystem().createWindow(window, settings);
-
-    if (sharedWindow)
-    {
-        if (sharedWindow->configInit())
-            sharedWindow->makeCurrent();
-        else
-        {
-            LBWARN << "OS Window initialization failed: " << std::endl;
-            delete sharedWindow;
-            sharedWindow = 0;
-        }
-    }
-    else
     {
-        LBERROR << "Failed to create shared context window for "
-                << pipe->getWindowSystem() << std::endl;
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_running)
+            return;
+        _running = false;
+        _condition.notify_all();
     }
-
-    window->makeCurrent();
-
-    LBINFO << "Async fetcher initialization finished" << std::endl;
-    return sharedWindow;
+    join();
 }
 
-void AsyncFetcher::setup(Window* window)
+bool AsyncFetcher::_sleep(const uint32_t ms)
 {
-    _sharedWindow = initSharedContextWindow(window);
-    start();
-}
-
-void AsyncFetcher::stop()
-{
-    if (!_sharedWindow)
-        return;
-
-    deleteTexture(0); // exit async thread
-    join();
-
-    _sharedWindow->configExit();
-    delete _sharedWindow;
-    _sharedWindow = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait_for(lock, std::chrono::milliseconds(ms),
+                        [this] { return !_running; });
+    return _running;
 }
 
 /**
- *  Function for creating and holding of shared context.
- *  Generation and uploading of new textures over some period with sleep time.
+ *  Generation of new images over some period with sleep time. The GPU upload
+ *  is done by the pipe's uploader in its shared context.
  */
 void AsyncFetcher::run()
 {
-    LBASSERT(_sharedWindow);
-    if (!_sharedWindow)
-        return;
-
-    _sharedWindow->makeCurrent();
-    eq::util::ObjectManager objects(glewGetContext());
-    lunchbox::Bufferb textureData(64 * 64 * 4);
     LBINFO << "async fetcher initialized" << std::endl;
 
-    bool running = true;
-    lunchbox::sleep(1000); // imitate loading of the first texture
-    for (uint8_t* i = 0; running; ++i)
-    {
-        // generate new texture
-        eq::util::Texture* tx = objects.newEqTexture(i, GL_TEXTURE_2D);
-        tx->init(GL_RGBA8, 64, 64);
+    lunchbox::RNG rng;
+    if (!_sleep(1000)) // imitate loading of the first texture
+        return;
 
-        int j = 0;
-        lunchbox::RNG rng;
-        for (int y = 0; y < 64; ++y)
+    while (true)
+    {
+        // generate new image
+        ImagePtr image(new Image(textureSize * textureSize * 4));
+        size_t j = 0;
+        for (int y = 0; y < textureSize; ++y)
         {
-            for (int x = 0; x < 64; ++x)
+            for (int x = 0; x < textureSize; ++x)
             {
-                const GLbyte rnd = rng.get<uint8_t>() % 127;
-                const GLbyte val = (x / 8) % 2 == (y / 8) % 2 ? rnd : 0;
-                textureData[j++] = val;
-                textureData[j++] = val;
-                textureData[j++] = val;
-                textureData[j++] = val;
+                const uint8_t rnd = rng.get<uint8_t>() % 127;
+                const uint8_t val = (x / 8) % 2 == (y / 8) % 2 ? rnd : 0;
+                (*image)[j++] = val;
+                (*image)[j++] = val;
+                (*image)[j++] = val;
+                (*image)[j++] = val;
             }
         }
-        tx->upload(64, 64, textureData.getData());
-        EQ_GL_CALL(glFinish());
-
-        // add new texture to the pool
-        _outQueue.push(TextureId(tx->getName(), i));
+        _outQueue.push(image);
 
         // imitate hard work of loading something else
-        lunchbox::sleep(rng.get<uint32_t>() % 5000u);
-
-        // clean unused textures
-        const void* keyToDelete = 0;
-        while (_inQueue.tryPop(keyToDelete))
-        {
-            if (keyToDelete)
-            {
-                LBWARN << "Deleting eq texture " << keyToDelete << std::endl;
-                objects.deleteEqTexture(keyToDelete);
-            }
-            else
-                running = false;
-        }
+        if (!_sleep(rng.get<uint32_t>() % 5000u))
+            return;
     }
-    objects.deleteAll();
 }
 
 } // namespace eqAsync
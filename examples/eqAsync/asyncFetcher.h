@@ -1,6 +1,6 @@
 
 /* Copyright (c) 2009-2011, Maxim Makhinya <maxmah@gmail.com>
- *                    2012, Stefan Eilemann <eile@eyescale.ch>
+ *               2012-2017, Stefan Eilemann <eile@eyescale.ch>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
@@ -33,26 +33,22 @@
 
 #include <eq/eq.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 namespace eqAsync
 {
-/**
- *  Structure to associate OpenGL texture ids with an external key.
- */
-struct TextureId
-{
-    TextureId(const GLuint id_ = 0, const void* key_ = 0)
-        : id(id_)
-        , key(key_){};
+/** The edge length of the generated textures. */
+static const int32_t textureSize = 64;
 
-    GLuint id;       // OpenGL texture id
-    const void* key; // Object manager key; used to delete textures
-};
-
-class Window;
+/** An RGBA image of textureSize^2 pixels. */
+typedef std::vector<uint8_t> Image;
+typedef std::shared_ptr<Image> ImagePtr;
 
 /**
- *  Asynchronous fetching thread. Creates and supplies new textures to the main
- * rendering pipe.
+ * Asynchronous loading thread. Supplies new images to the pipe, which uploads
+ * them using its eq::util::Uploader.
  */
 class AsyncFetcher : protected lunchbox::Thread
 {
@@ -60,20 +56,21 @@ public:
     AsyncFetcher();
     ~AsyncFetcher();
 
-    void setup(Window* window);
+    void setup();
     void stop();
 
-    //    TextureId getTextureId()               { return _outQueue.pop().id; }
-    bool tryGetTextureId(TextureId& val) { return _outQueue.tryPop(val); }
-    void deleteTexture(const void* key) { _inQueue.push(key); }
+    bool tryGetImage(ImagePtr& image) { return _outQueue.tryPop(image); }
 protected:
-    virtual void run();
-    const GLEWContext* glewGetContext() const;
+    void run() final;
 
 private:
-    lunchbox::MTQueue<const void*> _inQueue; // textures to delete
-    lunchbox::MTQueue<TextureId> _outQueue;  // generated textures
-    eq::SystemWindow* _sharedWindow;
+    lunchbox::MTQueue<ImagePtr> _outQueue; // loaded images
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _running;
+
+    /** Imitate loading, @return false if stopped. */
+    bool _sleep(uint32_t ms);
 };
 }
 
@@ -1,6 +1,6 @@
 
 /* Copyright (c) 2009-2011, Maxim Makhinya <maxmah@gmail.com>
- *                    2012, Stefan Eilemann <eile@eyescale.ch>
+ *               2012-2017, Stefan Eilemann <eile@eyescale.ch>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
@@ -30,6 +30,8 @@
 
 #include "eqAsync.h"
 
+#include <chrono>
+
 namespace eqAsync
 {
 bool Window::configInitGL(const eq::uint128_t& initID)
@@ -38,37 +40,77 @@ bool Window::configInitGL(const eq::uint128_t& initID)
         return false;
 
     Pipe* pipe = static_cast<Pipe*>(getPipe());
-    pipe->startAsyncFetcher(this);
+    return pipe->initTextures(this);
+}
+
+bool Window::configExitGL()
+{
+    Pipe* pipe = static_cast<Pipe*>(getPipe());
+    pipe->exitTextures(this);
+    return eq::Window::configExitGL();
+}
+
+bool Pipe::initTextures(Window* window)
+{
+    if (_window)
+        return true;
+
+    LBINFO << "initialize async uploads: " << this << ", " << window
+           << std::endl;
+    if (!getUploader().start(*window))
+        return false;
+
+    // textures are initialized here, the uploader only updates them
+    _window = window;
+    _front = new eq::util::Texture(GL_TEXTURE_2D, window->glewGetContext());
+    _back = new eq::util::Texture(GL_TEXTURE_2D, window->glewGetContext());
+    _front->init(GL_RGBA8, textureSize, textureSize);
+    _back->init(GL_RGBA8, textureSize, textureSize);
+    _front->setExternalFormat(GL_RGBA, GL_UNSIGNED_BYTE);
+    _back->setExternalFormat(GL_RGBA, GL_UNSIGNED_BYTE);
+
+    _asyncFetcher.setup();
     return true;
 }
 
-void Pipe::startAsyncFetcher(Window* wnd)
+void Pipe::exitTextures(Window* window)
 {
-    if (_initialized)
+    if (window != _window)
         return;
-    _initialized = true;
-    LBINFO << "initialize async fetcher: " << this << ", " << wnd << std::endl;
-    _asyncFetcher.setup(wnd);
+
+    // eq::Window::configExit() has stopped the uploader
+    _asyncFetcher.stop();
+    _upload = std::future<bool>();
+    _image.reset();
+    _front->flush();
+    _back->flush();
+    delete _front;
+    delete _back;
+    _front = _back = 0;
+    _hasTexture = false;
+    _window = 0;
 }
 
 void Pipe::frameStart(const eq::uint128_t& frameID, const uint32_t frameNumber)
 {
     eq::Pipe::frameStart(frameID, frameNumber);
 
-    const void* oldKey = _txId.key;
-    if (_asyncFetcher.tryGetTextureId(_txId))
+    if (_upload.valid() &&
+        _upload.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
     {
-        if (oldKey != 0)
-            _asyncFetcher.deleteTexture(oldKey);
-
-        LBINFO << "new texture generated " << _txId.key << std::endl;
+        if (_upload.get())
+        {
+            std::swap(_front, _back);
+            _hasTexture = true;
+            LBINFO << "new texture uploaded " << _front->getName()
+                   << std::endl;
+        }
+        _image.reset();
     }
-}
 
-bool Pipe::configExit()
-{
-    _asyncFetcher.stop();
-    return eq::Pipe::configExit();
+    if (!_upload.valid() && _window && _asyncFetcher.tryGetImage(_image))
+        _upload = getUploader().upload(*_back, _image->data(), textureSize,
+                                       textureSize);
 }
 
 void Channel::frameDraw(const eq::uint128_t& spin)
@@ -49,8 +49,8 @@ protected:
     virtual void frameDraw(const eq::uint128_t& spin);
 };
 
-/* Simple Window class that will call init of the pipe to create a shared
-   context */
+/* Simple Window class that will call init of the pipe to start the uploader
+   in a context shared with the first window */
 class Window : public eq::Window
 {
 public:
@@ -58,33 +58,39 @@ public:
         : eq::Window(parent)
     {
     }
-    bool configInitGL(const eq::uint128_t& initID);
+    bool configInitGL(const eq::uint128_t& initID) override;
+    bool configExitGL() override;
 };
 
-/* Simple Pipe class that creates a shared window for async fetching */
+/* Simple Pipe class that uploads fetched images asynchronously */
 class Pipe : public eq::Pipe
 {
 public:
     Pipe(eq::Node* parent)
         : eq::Pipe(parent)
-        , _initialized(false)
-        , _txId(0)
+        , _window(0)
+        , _front(0)
+        , _back(0)
+        , _hasTexture(false)
     {
     }
 
-    void startAsyncFetcher(Window* wnd);
-    AsyncFetcher& getAsyncFetcher() { return _asyncFetcher; }
-    GLuint getTextureId() const { return _txId.id; }
+    bool initTextures(Window* window);
+    void exitTextures(Window* window);
+    GLuint getTextureId() const { return _hasTexture ? _front->getName() : 0; }
 protected:
-    /* checks if new textures are avaliable */
-    virtual void frameStart(const eq::uint128_t& frameID,
-                            const uint32_t frameNumber);
-    virtual bool configExit();
+    /* swaps uploaded textures, uploads new images */
+    void frameStart(const eq::uint128_t& frameID,
+                    const uint32_t frameNumber) override;
 
 private:
-    bool _initialized;
     AsyncFetcher _asyncFetcher;
-    TextureId _txId;
+    const Window* _window;
+    eq::util::Texture* _front; // drawn
+    eq::util::Texture* _back;  // uploaded
+    bool _hasTexture;
+    ImagePtr _image;           // data of the running upload
+    std::future<bool> _upload; // the running upload
 };
 }
 
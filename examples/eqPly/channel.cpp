@@ -235,7 +235,7 @@ void Channel::frameReadback(const eq::uint128_t& frameID,
         // OPT: Drop alpha channel from all frames during network transport
         frame->setAlphaUsage(false);
 
-        if (frameData.isIdle())
+        if (_isIdle())
             frame->setQuality(eq::Frame::Buffer::color, 1.f);
         else
             frame->setQuality(eq::Frame::Buffer::color, frameData.getQuality());
@@ -280,7 +280,7 @@ void Channel::frameFinish(const eq::uint128_t& frameID,
     for (size_t i = 0; i < eq::NUM_EYES; ++i)
     {
         Accum& accum = _accum[i];
-        if (accum.step > 0)
+        if (accum.step > 0 && accum.idle)
         {
             if (int32_t(accum.stepsDone) > accum.step)
                 accum.step = 0;
@@ -301,6 +301,7 @@ void Channel::frameViewFinish(const eq::uint128_t& frameID)
 
     const FrameData& frameData = _getFrameData();
     Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    const bool idle = _isIdle();
 
     if (accum.buffer)
     {
@@ -314,7 +315,7 @@ void Channel::frameViewFinish(const eq::uint128_t& frameID)
             accum.step = view->getIdleSteps();
             accum.stepsDone = 0;
         }
-        else if (frameData.isIdle())
+        else if (idle)
         {
             setupAssemblyState();
 
@@ -333,7 +334,7 @@ void Channel::frameViewFinish(const eq::uint128_t& frameID)
         drawStatistics();
 
     int32_t steps = 0;
-    if (frameData.isIdle())
+    if (idle)
     {
         for (size_t i = 0; i < eq::NUM_EYES; ++i)
             steps = LB_MAX(steps, _accum[i].step);
@@ -366,8 +367,7 @@ const FrameData& Channel::_getFrameData() const
 
 bool Channel::_isDone() const
 {
-    const FrameData& frameData = _getFrameData();
-    if (!frameData.isIdle())
+    if (!_isIdle())
         return false;
 
     const eq::SubPixel& subpixel = getSubPixel();
@@ -375,13 +375,63 @@ bool Channel::_isDone() const
     return int32_t(subpixel.index) >= accum.step;
 }
 
+bool Channel::_isIdle() const
+{
+    return _accum[lunchbox::getIndexOfLastBit(getEye())].idle;
+}
+
+bool Channel::Content::operator==(const Content& rhs) const
+{
+    return head == rhs.head && rotation == rhs.rotation &&
+           modelRotation == rhs.modelRotation && position == rhs.position &&
+           modelID == rhs.modelID && renderMode == rhs.renderMode &&
+           colorMode == rhs.colorMode && ortho == rhs.ortho &&
+           wireframe == rhs.wireframe;
+}
+
+Channel::Content Channel::_getContent() const
+{
+    const FrameData& frameData = _getFrameData();
+    const View* view = static_cast<const View*>(getView());
+
+    Content content;
+    content.head = getHeadTransform();
+    content.rotation = frameData.getCameraRotation();
+    content.modelRotation = frameData.getModelRotation();
+    content.position = frameData.getCameraPosition();
+    content.modelID = view ? view->getModelID() : eq::uint128_t();
+    if (content.modelID == 0)
+        content.modelID = frameData.getModelID();
+    content.renderMode = frameData.getRenderMode();
+    content.colorMode = frameData.getColorMode();
+    content.ortho = frameData.useOrtho();
+    content.wireframe = frameData.useWireframe();
+    return content;
+}
+
 void Channel::_initJitter()
 {
     if (!_initAccum())
         return;
 
+    Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
+    const uint32_t frame = getPipe()->getCurrentFrame();
+    if (accum.frame == frame) // already checked for this frame
+        return;
+    accum.frame = frame;
+
+    // Keep accumulating as long as the image of this channel does not change,
+    // even if other channels or views are redrawn. The channel's own viewport
+    // is not part of the content, since a load-balanced source channel does
+    // not change what its destination shows. Destination resizes are handled
+    // by the accumulation buffer.
+    const Content content = _getContent();
     const FrameData& frameData = _getFrameData();
-    if (frameData.isIdle())
+    accum.idle = frameData.useIdleAA() && accum.hasContent &&
+                 accum.content == content;
+    accum.content = content;
+    accum.hasContent = true;
+    if (accum.idle)
         return;
 
     const View* view = static_cast<const View*>(getView());
@@ -393,7 +443,6 @@ void Channel::_initJitter()
         return;
 
     // ready for the next FSAA
-    Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
     if (accum.buffer)
         accum.buffer->clear();
     accum.step = idleSteps;
@@ -466,10 +515,9 @@ bool Channel::stopRendering() const
 
 eq::Vector2f Channel::getJitter() const
 {
-    const FrameData& frameData = _getFrameData();
     const Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
 
-    if (!frameData.isIdle() || accum.step <= 0)
+    if (!_isIdle() || accum.step <= 0)
         return eq::Channel::getJitter();
 
     const View* view = static_cast<const View*>(getView());
@@ -507,21 +555,17 @@ eq::Vector2f Channel::getJitter() const
     return eq::Vector2f(i, j);
 }
 
-static const uint32_t _primes[100] = {
-    739,  743,  751,  757,  761,  769,  773,  787,  797,  809,  811,  821,
-    823,  827,  829,  839,  853,  857,  859,  863,  877,  881,  883,  887,
-    907,  911,  919,  929,  937,  941,  947,  953,  967,  971,  977,  983,
-    991,  997,  1009, 1013, 1019, 1021, 1031, 1033, 1039, 1049, 1051, 1061,
-    1063, 1069, 1087, 1091, 1093, 1097, 1103, 1109, 1117, 1123, 1129, 1151,
-    1153, 1163, 1171, 1181, 1187, 1193, 1201, 1213, 1217, 1223, 1229, 1231,
-    1237, 1249, 1259, 1277, 1279, 1283, 1289, 1291, 1297, 1301, 1303, 1307,
-    1319, 1321, 1327, 1361, 1367, 1373, 1381, 1399, 1409, 1423, 1427, 1429,
-    1433, 1439, 1447, 1451};
+/** @return the 8 bit value with reversed bit order. */
+static uint32_t _reverseBits(uint32_t value)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < 8; ++i, value >>= 1)
+        result = (result << 1) | (value & 1);
+    return result;
+}
 
 eq::Vector2i Channel::_getJitterStep() const
 {
-    const eq::SubPixel& subPixel = getSubPixel();
-    const uint32_t channelID = subPixel.index;
     const View* view = static_cast<const View*>(getView());
     if (!view)
         return eq::Vector2i();
@@ -530,14 +574,23 @@ eq::Vector2i Channel::_getJitterStep() const
     if (totalSteps != 256)
         return eq::Vector2i();
 
+    // The channels of a subpixel compound take consecutive samples of one
+    // progressive sequence. Reversing the bits of the sample number and
+    // splitting them into x and y places any 4^n consecutive samples on a
+    // 2^n x 2^n grid, so the pixel is covered evenly after any number of
+    // steps, not only after all of them.
     const Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
-    const uint32_t subset = totalSteps / getSubPixel().size;
-    const uint32_t index =
-        (accum.step * _primes[channelID % 100]) % subset + (channelID * subset);
-    const uint32_t sampleSize = 16;
-    const int dx = index % sampleSize;
-    const int dy = index / sampleSize;
+    const uint32_t sample =
+        (totalSteps - accum.step + getSubPixel().index) % totalSteps;
+    const uint32_t bits = _reverseBits(sample);
 
+    int dx = 0;
+    int dy = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        dx |= ((bits >> (2 * i)) & 1) << i;
+        dy |= ((bits >> (2 * i + 1)) & 1) << i;
+    }
     return eq::Vector2i(dx, dy);
 }
 
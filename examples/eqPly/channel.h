@@ -76,6 +76,7 @@ private:
     void _updateNearFar(const triply::BoundingBox& box);
 
     bool _isDone() const;
+    bool _isIdle() const;
 
     void _initJitter();
     bool _initAccum();
@@ -90,19 +91,43 @@ private:
     eq::uint128_t _modelID;
     uint32_t _frameRestart;
 
+    /** The inputs which determine the image of a channel. */
+    struct Content
+    {
+        bool operator==(const Content& rhs) const;
+
+        eq::Matrix4f head;
+        eq::Matrix4f rotation;
+        eq::Matrix4f modelRotation;
+        eq::Vector3f position;
+        eq::uint128_t modelID;
+        triply::RenderMode renderMode;
+        ColorMode colorMode;
+        bool ortho;
+        bool wireframe;
+    };
+    Content _getContent() const;
+
     struct Accum
     {
         Accum()
             : step(0)
             , stepsDone(0)
+            , frame(0)
             , transfer(false)
+            , idle(false)
+            , hasContent(false)
         {
         }
 
         std::unique_ptr<eq::util::Accum> buffer;
         int32_t step;
         uint32_t stepsDone;
+        uint32_t frame;  //!< the last frame the content was checked
         bool transfer;
+        bool idle;       //!< content unchanged, accumulate
+        bool hasContent; //!< content is set
+        Content content; //!< the content being accumulated
     } _accum[eq::NUM_EYES];
 
     eq::PixelViewport _currentPVP;
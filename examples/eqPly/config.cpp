@@ -267,23 +267,10 @@ void Config::_updateData()
         _frameData.moveCamera(0.0f, 0.0f, 0.001f * _advance);
     }
 
-    // idle mode
-    if (isIdleAA())
-    {
-        LBASSERT(_numFramesAA > 0);
-        _frameData.setIdle(true);
-    }
-    else
-        _frameData.setIdle(false);
-
+    // idle mode is decided per channel, see Channel::_initJitter
     _numFramesAA = 0;
 }
 
-bool Config::isIdleAA()
-{
-    return (!_needNewFrame() && _numFramesAA > 0);
-}
-
 bool Config::needRedraw()
 {
     return (_needNewFrame() || _numFramesAA > 0);
@@ -343,6 +330,7 @@ bool Config::handleEvent(const eq::EventType type, const eq::KeyEvent& event)
 
     case 'i':
         _useIdleAA = !_useIdleAA;
+        _frameData.setIdleAA(_useIdleAA);
         return true;
 
     case 'k':
@@ -77,9 +77,6 @@ public:
     bool handleEvent(const eq::AxisEvent& event) override;
     bool handleEvent(const eq::ButtonEvent&) override;
 
-    /** @return true if the application is idling. */
-    bool isIdleAA();
-
     /** @return true if an event required a redraw. */
     bool needRedraw();
 
@@ -40,7 +40,7 @@ FrameData::FrameData()
     , _help(false)
     , _wireframe(false)
     , _pilotMode(false)
-    , _idle(false)
+    , _idleAA(false)
     , _compression(true)
 {
     reset();
@@ -52,7 +52,7 @@ void FrameData::serialize(co::DataOStream& os, const uint64_t dirtyBits)
         os << _position << _rotation << _modelRotation;
     if (dirtyBits & DIRTY_FLAGS)
         os << _modelID << _renderMode << _colorMode << _quality << _ortho
-           << _statistics << _help << _wireframe << _pilotMode << _idle
+           << _statistics << _help << _wireframe << _pilotMode << _idleAA
            << _compression;
     if (dirtyBits & DIRTY_VIEW)
         os << _currentViewID;
@@ -66,7 +66,7 @@ void FrameData::deserialize(co::DataIStream& is, const uint64_t dirtyBits)
         is >> _position >> _rotation >> _modelRotation;
     if (dirtyBits & DIRTY_FLAGS)
         is >> _modelID >> _renderMode >> _colorMode >> _quality >> _ortho >>
-            _statistics >> _help >> _wireframe >> _pilotMode >> _idle >>
+            _statistics >> _help >> _wireframe >> _pilotMode >> _idleAA >>
             _compression;
     if (dirtyBits & DIRTY_VIEW)
         is >> _currentViewID;
@@ -95,12 +95,12 @@ void FrameData::setRenderMode(const triply::RenderMode mode)
     setDirty(DIRTY_FLAGS);
 }
 
-void FrameData::setIdle(const bool idle)
+void FrameData::setIdleAA(const bool enabled)
 {
-    if (_idle == idle)
+    if (_idleAA == enabled)
         return;
 
-    _idle = idle;
+    _idleAA = enabled;
     setDirty(DIRTY_FLAGS);
 }
 
@@ -56,7 +56,7 @@ public:
 
     void setColorMode(const ColorMode color);
     void setRenderMode(const triply::RenderMode mode);
-    void setIdle(const bool idleMode);
+    void setIdleAA(const bool enabled);
 
     void toggleOrtho();
     void toggleStatistics();
@@ -76,7 +76,7 @@ public:
     bool showHelp() const { return _help; }
     bool useWireframe() const { return _wireframe; }
     bool usePilotMode() const { return _pilotMode; }
-    bool isIdle() const { return _idle; }
+    bool useIdleAA() const { return _idleAA; }
     triply::RenderMode getRenderMode() const { return _renderMode; }
     bool useCompression() const { return _compression; }
     //*}
@@ -137,7 +137,7 @@ private:
     bool _help;
     bool _wireframe;
     bool _pilotMode;
-    bool _idle;
+    bool _idleAA;
     bool _compression;
 
     eq::uint128_t _currentViewID;
@@ -35,6 +35,7 @@
 #include "config.h"
 #include "pipe.h"
 #include "quad.h"
+#include "tilePager.h"
 #include "util.h"
 #include "window.h"
 
@@ -99,6 +100,11 @@ void Channel::frameDraw(const eq::uint128_t& frameID)
     headView.postMult(vmmlToOsg(getHeadTransform()));
     view->setViewMatrix(headView);
 
+    // - DB range of paged scenes
+    osgUtil::CullVisitor* cullVisitor = view->getCullVisitor();
+    if (cullVisitor)
+        TilePager::setRange(*cullVisitor, getRange());
+
     // - Render
     view->cull();
     view->draw();
@@ -45,12 +45,14 @@ const eq::uint128_t& InitData::getFrameDataID() const
 
 void InitData::getInstanceData(co::DataOStream& stream)
 {
-    stream << _frameDataID << _modelFileName << _imageFileName;
+    stream << _frameDataID << _modelFileName << _imageFileName
+           << _tilesFileName << _tileBudget;
 }
 
 void InitData::applyInstanceData(co::DataIStream& stream)
 {
-    stream >> _frameDataID >> _modelFileName >> _imageFileName;
+    stream >> _frameDataID >> _modelFileName >> _imageFileName >>
+        _tilesFileName >> _tileBudget;
 }
 
 void InitData::setModelFileName(const std::string& fileName)
@@ -73,6 +75,26 @@ std::string InitData::getImageFileName() const
     return _imageFileName;
 }
 
+void InitData::setTilesFileName(const std::string& fileName)
+{
+    _tilesFileName = fileName;
+}
+
+std::string InitData::getTilesFileName() const
+{
+    return _tilesFileName;
+}
+
+void InitData::setTileBudget(const uint32_t megabytes)
+{
+    _tileBudget = megabytes;
+}
+
+uint32_t InitData::getTileBudget() const
+{
+    return _tileBudget;
+}
+
 const std::string InitData::getTrackerPort() const
 {
     return _trackerPort;
@@ -84,13 +106,26 @@ bool InitData::parseCommandLine(char** argv, int argc)
     {
         if (strcmp(argv[i], "--help") == 0)
         {
-            std::cout << argv[0] << " [--model file][--image file]: "
+            std::cout << argv[0] << " [--model file][--image file]"
+                      << "[--tiles file][--tile-budget MB]: "
                       << "OpenSceneGraph/Equalizer example" << std::endl
                       << eq::getHelp() << eq::Client::getHelp() << std::endl;
             ::exit(EXIT_SUCCESS);
         }
     }
 
+    const std::string budget =
+        _parseCommandLineParam(argc, argv, "--tile-budget");
+    if (budget.size() > 0)
+        setTileBudget(std::max(atoi(budget.c_str()), 1));
+
+    std::string tiles = _parseCommandLineParam(argc, argv, "--tiles");
+    if (tiles.size() > 0)
+    {
+        setTilesFileName(tiles);
+        return true;
+    }
+
     std::string model = _parseCommandLineParam(argc, argv, "--model");
     if (model.size() > 0)
     {
@@ -41,7 +41,7 @@ namespace osgScaleViewer
  * It is sent by the server to all render clients.
  *
  * It holds the frame data ID, so all clients can sync the frame data
- * object. It also holds the model or image filename to load.
+ * object. It also holds the tile index, model or image filename to load.
  */
 class InitData : public co::Object
 {
@@ -49,6 +49,7 @@ public:
     InitData()
         : _modelFileName("cow.osg")
         , _imageFileName("tests/compositor/Result_Alpha_color.rgb")
+        , _tileBudget(1024)
     {
     }
     virtual ~InitData() {}
@@ -79,6 +80,30 @@ public:
      */
     std::string getImageFileName() const;
 
+    /**
+     * Sets the tile index filename of a paged scene.
+     * @param filename the tile index filename.
+     */
+    void setTilesFileName(const std::string& filename);
+
+    /**
+     * Gets the tile index filename.
+     * @return the tile index filename, empty if no scene is paged.
+     */
+    std::string getTilesFileName() const;
+
+    /**
+     * Sets the memory budget of the loaded tiles per node.
+     * @param megabytes the tile budget in megabytes.
+     */
+    void setTileBudget(uint32_t megabytes);
+
+    /**
+     * Gets the memory budget of the loaded tiles per node.
+     * @return the tile budget in megabytes.
+     */
+    uint32_t getTileBudget() const;
+
     /**
      * Gets the tracker port.
      * @return the tracker port.
@@ -115,6 +140,8 @@ private:
 
     std::string _modelFileName;
     std::string _imageFileName;
+    std::string _tilesFileName;
+    uint32_t _tileBudget;
 
     std::string _trackerPort;
 };
@@ -35,6 +35,7 @@
 #include "config.h"
 #include "quad.h"
 #include "sceneReader.h"
+#include "tilePager.h"
 
 #include <osg/MatrixTransform>
 #include <osg/Texture2D>
@@ -47,6 +48,10 @@ Node::Node(eq::Config* parent)
 {
 }
 
+Node::~Node()
+{
+}
+
 bool Node::configInit(const eq::uint128_t& initID)
 {
     if (!eq::Node::configInit(initID))
@@ -65,25 +70,33 @@ bool Node::configInit(const eq::uint128_t& initID)
     if (!_model)
     {
         const InitData& initData = config->getInitData();
+        const std::string& tilesFile = initData.getTilesFileName();
         const std::string& modelFile = initData.getModelFileName();
-        if (!modelFile.empty())
+        if (!tilesFile.empty())
+        {
+            _pager.reset(new TilePager(size_t(initData.getTileBudget()) << 20));
+            _model = _pager->readIndex(tilesFile);
+            if (!_model)
+                _pager.reset();
+        }
+        else if (!modelFile.empty())
         {
             SceneReader sceneReader;
             _model = sceneReader.readModel(modelFile);
+        }
 
-            if (_model.valid())
-            {
-                osg::Matrix matrix;
-                matrix.makeRotate(-osg::PI_2, osg::Vec3(1., 0., 0.));
+        if (_model.valid())
+        {
+            osg::Matrix matrix;
+            matrix.makeRotate(-osg::PI_2, osg::Vec3(1., 0., 0.));
 
-                osg::ref_ptr<osg::MatrixTransform> transform =
-                    new osg::MatrixTransform();
-                transform->setMatrix(matrix);
-                transform->addChild(_model);
-                transform->setDataVariance(osg::Object::STATIC);
+            osg::ref_ptr<osg::MatrixTransform> transform =
+                new osg::MatrixTransform();
+            transform->setMatrix(matrix);
+            transform->addChild(_model);
+            transform->setDataVariance(osg::Object::STATIC);
 
-                _model = transform;
-            }
+            _model = transform;
         }
     }
 
@@ -116,6 +129,8 @@ bool Node::configExit()
 void Node::frameStart(const eq::uint128_t& frameID, const uint32_t frameNumber)
 {
     _frameStamp->setFrameNumber(frameNumber);
+    if (_pager)
+        _pager->update(frameNumber, getConfig()->getLatency());
 
     // TODO use global time saved in FrameData, use one FrameData per node
     const double time = static_cast<double>(getConfig()->getTime()) / 1000.;
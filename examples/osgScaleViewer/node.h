@@ -40,8 +40,12 @@
 #include <osg/LightSource>
 #include <osg/Node>
 
+#include <memory>
+
 namespace osgScaleViewer
 {
+class TilePager;
+
 class Node : public eq::Node
 {
 public:
@@ -50,6 +54,7 @@ public:
      * @param parent the node's parent.
      */
     Node(eq::Config* parent);
+    ~Node();
 
     int32_t getUniqueContextID() { return ++_contextID; }
     osg::ref_ptr<osg::Node> getModel() { return _model; }
@@ -62,6 +67,7 @@ protected:
 
 private:
     lunchbox::a_int32_t _contextID;
+    std::unique_ptr<TilePager> _pager; // before _model, used by its tiles
     osg::ref_ptr<osg::Node> _model;
     osg::ref_ptr<osg::FrameStamp> _frameStamp;
     osg::ref_ptr<osg::NodeVisitor> _updateVisitor;
@@ -0,0 +1,360 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "tilePager.h"
+
+#include "sceneReader.h"
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Texture>
+#include <osgDB/FileNameUtils>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace osgScaleViewer
+{
+namespace
+{
+/** The DB range of a channel, stored as user data of its cull visitor. */
+class CullRange : public osg::Referenced
+{
+public:
+    eq::Range range;
+};
+
+/** Sums the size of the vertex, index and image data of a subgraph. */
+class SizeVisitor : public osg::NodeVisitor
+{
+public:
+    SizeVisitor()
+        : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        , size(0)
+    {
+    }
+
+    void apply(osg::Node& node) final
+    {
+        _apply(node.getStateSet());
+        traverse(node);
+    }
+
+    void apply(osg::Geode& geode) final
+    {
+        _apply(geode.getStateSet());
+        for (unsigned i = 0; i < geode.getNumDrawables(); ++i)
+        {
+            osg::Drawable* drawable = geode.getDrawable(i);
+            _apply(drawable->getStateSet());
+
+            const osg::Geometry* geometry = drawable->asGeometry();
+            if (!geometry)
+                continue;
+
+            _apply(geometry->getVertexArray());
+            _apply(geometry->getNormalArray());
+            _apply(geometry->getColorArray());
+            for (unsigned j = 0; j < geometry->getNumTexCoordArrays(); ++j)
+                _apply(geometry->getTexCoordArray(j));
+            for (unsigned j = 0; j < geometry->getNumPrimitiveSets(); ++j)
+                size += geometry->getPrimitiveSet(j)->getTotalDataSize();
+        }
+    }
+
+    size_t size;
+
+private:
+    void _apply(const osg::Array* array)
+    {
+        if (array)
+            size += array->getTotalDataSize();
+    }
+
+    void _apply(const osg::StateSet* stateSet)
+    {
+        if (!stateSet)
+            return;
+
+        const osg::StateSet::TextureAttributeList& units =
+            stateSet->getTextureAttributeList();
+        for (unsigned i = 0; i < units.size(); ++i)
+        {
+            const osg::Texture* texture = dynamic_cast<const osg::Texture*>(
+                stateSet->getTextureAttribute(i, osg::StateAttribute::TEXTURE));
+            if (!texture)
+                continue;
+
+            for (unsigned j = 0; j < texture->getNumImages(); ++j)
+                if (texture->getImage(j))
+                    size += texture->getImage(j)->getTotalSizeInBytes();
+        }
+    }
+};
+
+/**
+ * Placeholder of a tile in the scenegraph.
+ *
+ * The bound is the one of the tile index, which lets OSG cull invisible tiles
+ * before they are loaded. Each tile is rendered by the channel whose DB range
+ * contains the tile's position in the index.
+ */
+class TileNode : public osg::Node
+{
+public:
+    TileNode(TilePager& pager, const size_t index, const size_t nTiles,
+             const osg::BoundingSphere& bound)
+        : _pager(pager)
+        , _index(index)
+        , _position((float(index) + .5f) / float(nTiles))
+        , _bound(bound)
+    {
+    }
+
+    osg::BoundingSphere computeBound() const final { return _bound; }
+
+    void traverse(osg::NodeVisitor& visitor) final
+    {
+        if (visitor.getVisitorType() != osg::NodeVisitor::CULL_VISITOR)
+            return;
+
+        const CullRange* cullRange =
+            dynamic_cast<const CullRange*>(visitor.getUserData());
+        if (cullRange && (_position < cullRange->range.start ||
+                          _position >= cullRange->range.end))
+        {
+            return;
+        }
+
+        const float distance =
+            visitor.getDistanceToViewPoint(_bound.center(), false);
+        osg::Node* tile = _pager.use(_index, distance);
+        if (tile)
+            tile->accept(visitor);
+    }
+
+private:
+    TilePager& _pager;
+    const size_t _index;
+    const float _position;
+    const osg::BoundingSphere _bound;
+};
+}
+
+TilePager::TilePager(const size_t budget)
+    : _budget(budget)
+    , _used(0)
+    , _frame(0)
+    , _running(true)
+    , _thread([this] { _run(); })
+{
+}
+
+TilePager::~TilePager()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+osg::ref_ptr<osg::Node> TilePager::readIndex(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file)
+    {
+        LBERROR << "Failed to open tile index " << filename << std::endl;
+        return 0;
+    }
+
+    const std::string path = osgDB::getFilePath(filename);
+    std::vector<Tile> tiles;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        Tile tile;
+        float x, y, z, radius;
+        if (!(stream >> tile.filename >> x >> y >> z >> radius))
+        {
+            LBERROR << "Invalid tile in " << filename << ": " << line
+                    << std::endl;
+            return 0;
+        }
+
+        if (!path.empty() && tile.filename[0] != '/')
+            tile.filename = osgDB::concatPaths(path, tile.filename);
+        tile.bound.set(osg::Vec3(x, y, z), radius);
+        tiles.push_back(tile);
+    }
+
+    if (tiles.empty())
+    {
+        LBERROR << "No tiles in " << filename << std::endl;
+        return 0;
+    }
+
+    osg::ref_ptr<osg::Group> root = new osg::Group;
+    for (size_t i = 0; i < tiles.size(); ++i)
+        root->addChild(new TileNode(*this, i, tiles.size(), tiles[i].bound));
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    LBASSERT(_tiles.empty());
+    _tiles.swap(tiles);
+    LBINFO << "Paging " << _tiles.size() << " tiles from " << filename
+           << std::endl;
+    return root;
+}
+
+void TilePager::update(const uint32_t frameNumber, const uint32_t latency)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _frame = frameNumber;
+
+    // Drop requests for tiles not visible in the last frame
+    for (size_t i = 0; i < _requests.size();)
+    {
+        Tile& tile = _tiles[_requests[i]];
+        if (tile.lastUsed + 1 < _frame)
+        {
+            tile.requested = false;
+            _requests[i] = _requests.back();
+            _requests.pop_back();
+        }
+        else
+            ++i;
+    }
+
+    if (_used <= _budget)
+        return;
+
+    // Unload the least recently used tiles no pipe is rendering anymore
+    std::vector<size_t> unused;
+    for (size_t i = 0; i < _tiles.size(); ++i)
+    {
+        const Tile& tile = _tiles[i];
+        if (tile.node && tile.lastUsed + latency + 1 < _frame)
+            unused.push_back(i);
+    }
+    std::sort(unused.begin(), unused.end(),
+              [this](const size_t a, const size_t b) {
+                  return _tiles[a].lastUsed < _tiles[b].lastUsed;
+              });
+
+    for (const size_t i : unused)
+    {
+        if (_used <= _budget)
+            return;
+
+        Tile& tile = _tiles[i];
+        tile.node->releaseGLObjects();
+        tile.node = 0;
+        _used -= tile.size;
+        tile.size = 0;
+    }
+}
+
+size_t TilePager::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _used;
+}
+
+void TilePager::setRange(osg::NodeVisitor& visitor, const eq::Range& range)
+{
+    CullRange* cullRange = dynamic_cast<CullRange*>(visitor.getUserData());
+    if (!cullRange)
+    {
+        cullRange = new CullRange;
+        visitor.setUserData(cullRange);
+    }
+    cullRange->range = range;
+}
+
+osg::Node* TilePager::use(const size_t index, const float distance)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Tile& tile = _tiles[index];
+    tile.lastUsed = _frame;
+    if (tile.node || tile.failed)
+        return tile.node.get();
+
+    tile.distance = distance;
+    if (!tile.requested)
+    {
+        tile.requested = true;
+        _requests.push_back(index);
+        _condition.notify_one();
+    }
+    return 0;
+}
+
+void TilePager::_run()
+{
+    SceneReader reader;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _condition.wait(lock,
+                        [this] { return !_running || !_requests.empty(); });
+        if (!_running)
+            return;
+
+        // Load the closest tile first
+        std::vector<size_t>::iterator next =
+            std::min_element(_requests.begin(), _requests.end(),
+                             [this](const size_t a, const size_t b) {
+                                 return _tiles[a].distance < _tiles[b].distance;
+                             });
+        const size_t index = *next;
+        *next = _requests.back();
+        _requests.pop_back();
+        const std::string filename = _tiles[index].filename;
+
+        lock.unlock();
+        osg::ref_ptr<osg::Node> node = reader.readModel(filename);
+        SizeVisitor sizeVisitor;
+        if (node.valid())
+            node->accept(sizeVisitor);
+        lock.lock();
+
+        Tile& tile = _tiles[index];
+        tile.requested = false;
+        tile.failed = !node.valid();
+        tile.node = node;
+        tile.size = sizeVisitor.size;
+        _used += tile.size;
+    }
+}
+}
@@ -0,0 +1,132 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSGSV_TILEPAGER_H
+#define OSGSV_TILEPAGER_H
+
+#include <eq/eq.h>
+
+#include <osg/BoundingSphere>
+#include <osg/Node>
+#include <osg/ref_ptr>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osgScaleViewer
+{
+/**
+ * Streams the tiles of a paged scene on a background thread.
+ *
+ * The tile index is a text file listing one tile per line: the model file,
+ * relative to the index, and the center and radius of its bounding sphere. The
+ * scene graph has one placeholder per tile, which is frustum-culled by OSG
+ * using the bounding sphere of the index. A visible placeholder within the DB
+ * range of the culling channel draws its tile if it is loaded, and requests it
+ * otherwise. The loader thread loads the closest requested tile first.
+ *
+ * One pager is used by all pipes of a node, which share the decoded tiles.
+ * When the loaded tiles exceed the memory budget, the least recently drawn
+ * tiles are unloaded, as soon as no pipe can render them anymore.
+ */
+class TilePager
+{
+public:
+    /**
+     * Creates a pager and starts its loader thread.
+     * @param budget the memory budget for the loaded tiles, in bytes.
+     */
+    explicit TilePager(size_t budget);
+
+    /** Stops the loader thread. */
+    ~TilePager();
+
+    /**
+     * Reads a tile index.
+     * @param filename the tile index filename.
+     * @return the root node of the paged scenegraph, or 0 on error.
+     */
+    osg::ref_ptr<osg::Node> readIndex(const std::string& filename);
+
+    /**
+     * Unloads tiles over the memory budget, called at each frame start.
+     * @param frameNumber the started frame.
+     * @param latency the maximum number of frames rendered concurrently.
+     */
+    void update(uint32_t frameNumber, uint32_t latency);
+
+    /** @return the size of the loaded tiles, in bytes. */
+    size_t getMemoryUsage() const;
+
+    /** Sets the DB range of the channel culling with the given visitor. */
+    static void setRange(osg::NodeVisitor& visitor, const eq::Range& range);
+
+    /**
+     * @internal Marks a visible tile as used.
+     * @return the tile, or 0 if it is not loaded yet.
+     */
+    osg::Node* use(size_t index, float distance);
+
+private:
+    struct Tile
+    {
+        Tile()
+            : size(0)
+            , lastUsed(0)
+            , distance(0.f)
+            , requested(false)
+            , failed(false)
+        {
+        }
+
+        std::string filename;
+        osg::BoundingSphere bound;
+        osg::ref_ptr<osg::Node> node;
+        size_t size;       //!< decoded size in bytes
+        uint32_t lastUsed; //!< frame of the last use
+        float distance;    //!< of the last request, to load close tiles first
+        bool requested;
+        bool failed;
+    };
+
+    std::vector<Tile> _tiles;
+    std::vector<size_t> _requests;
+    const size_t _budget;
+    size_t _used;
+    uint32_t _frame;
+    bool _running;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread;
+
+    void _run();
+};
+}
+#endif
@@ -0,0 +1,204 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <eq/eq.h>
+#include <eq/gl.h>
+#include <eq/util/uploader.h>
+#include <lunchbox/test.h>
+
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#define setenv(name, value, overwrite) _putenv_s(name, value)
+#endif
+
+// Tests the execution order, the frame budget and the cancellation of the
+// asynchronous uploader from the first window of the default configuration.
+
+#ifdef EQUALIZER_USE_HWSD
+namespace
+{
+const size_t _size = 16;
+const std::chrono::seconds _timeout(10);
+const std::chrono::milliseconds _pending(200);
+
+struct Results
+{
+    Results()
+        : tested(false)
+        , started(false)
+        , first(false)
+        , budgetHeld(false)
+        , priority(false)
+        , lowWaited(false)
+        , low(false)
+        , data(false)
+        , cancelled(false)
+        , stopped(false)
+    {
+    }
+
+    bool tested;
+    bool started;
+    bool first;      // the first job is executed
+    bool budgetHeld; // jobs over the budget wait for the next frame
+    bool priority;   // the higher priority job is executed first
+    bool lowWaited;  // the lower priority job waits for the next frame
+    bool low;        // the lower priority job is executed
+    bool data;       // the uploaded data is visible in the window's context
+    bool cancelled;  // pending jobs are cancelled on stop()
+    bool stopped;    // jobs submitted after stop() fail
+};
+Results _results;
+
+bool _isReady(std::future<bool>& future, const std::chrono::milliseconds wait)
+{
+    return future.wait_for(wait) == std::future_status::ready;
+}
+
+class TestWindow : public eq::Window
+{
+public:
+    explicit TestWindow(eq::Pipe* parent)
+        : eq::Window(parent)
+    {
+    }
+
+protected:
+    bool configInitGL(const eq::uint128_t& initID) override
+    {
+        if (!eq::Window::configInitGL(initID))
+            return false;
+        if (_results.tested || !GLEW_VERSION_1_5)
+            return true;
+
+        _results.tested = true;
+        eq::util::Uploader uploader;
+        _results.started = uploader.start(*this);
+        if (!_results.started)
+            return true;
+
+        GLuint buffer = 0;
+        EQ_GL_CALL(glGenBuffers(1, &buffer));
+        EQ_GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+        EQ_GL_CALL(
+            glBufferData(GL_ARRAY_BUFFER, 4 * _size, 0, GL_STATIC_DRAW));
+        EQ_GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        EQ_GL_CALL(glFinish());
+
+        uint8_t data[4][_size];
+        for (size_t i = 0; i < 4; ++i)
+            ::memset(data[i], int(i + 1), _size);
+
+        // the first job uses the budget of the current frame
+        uploader.setFrameBudget(_size);
+        std::future<bool> first = uploader.upload(buffer, data[0], _size, 0);
+        _results.first = _isReady(first, _timeout) && first.get();
+
+        // jobs over the budget wait, the higher priority one is next
+        std::future<bool> low = uploader.upload(buffer, data[1], _size, _size);
+        std::future<bool> high =
+            uploader.upload(buffer, data[2], _size, 2 * _size, 1);
+        _results.budgetHeld = !_isReady(low, _pending) && !_isReady(high, {});
+
+        uploader.startFrame();
+        _results.priority = _isReady(high, _timeout) && high.get();
+        _results.lowWaited = !_isReady(low, _pending);
+
+        uploader.startFrame();
+        _results.low = _isReady(low, _timeout) && low.get();
+
+        uint8_t result[3 * _size];
+        EQ_GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+        EQ_GL_CALL(glGetBufferSubData(GL_ARRAY_BUFFER, 0, 3 * _size, result));
+        EQ_GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        _results.data = ::memcmp(result, data, 3 * _size) == 0;
+
+        // the pending job is cancelled by stop()
+        std::future<bool> pending =
+            uploader.upload(buffer, data[3], _size, 3 * _size);
+        uploader.stop();
+        _results.cancelled = _isReady(pending, {}) && !pending.get();
+
+        std::future<bool> stopped = uploader.upload(buffer, data[3], _size);
+        _results.stopped = _isReady(stopped, {}) && !stopped.get();
+
+        EQ_GL_CALL(glDeleteBuffers(1, &buffer));
+        return true;
+    }
+};
+
+class TestNodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Window* createWindow(eq::Pipe* parent) override
+    {
+        return new TestWindow(parent);
+    }
+};
+}
+
+int main(const int argc, char** argv)
+{
+#ifndef Darwin
+    ::setenv("EQ_WINDOW_IATTR_HINT_DRAWABLE", "-12" /*FBO*/, 1 /*overwrite*/);
+#endif
+
+    TestNodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST(client->initLocal(argc, argv));
+
+    eq::ServerPtr server = new eq::Server;
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    if (config) // else most probably no GPUs present, test is meaningless
+    {
+        TEST(config->init(co::uint128_t()));
+        config->exit();
+        server->releaseConfig(config);
+    }
+    client->disconnectServer(server);
+    client->exitLocal();
+    TEST(eq::exit());
+
+    if (!_results.tested)
+        return EXIT_SUCCESS;
+
+    TEST(_results.started);
+    TEST(_results.first);
+    TEST(_results.budgetHeld);
+    TEST(_results.priority);
+    TEST(_results.lowWaited);
+    TEST(_results.low);
+    TEST(_results.data);
+    TEST(_results.cancelled);
+    TEST(_results.stopped);
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(const int, char**)
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
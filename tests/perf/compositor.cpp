@@ -0,0 +1,438 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 1200 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/fabric/renderContext.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <eq/roiFinder.h>
+
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+
+// Benchmarks the CPU compositing pipeline on synthetic color and depth images:
+// compression, decompression, sort-last, sort-first, blend, pixel and subpixel
+// assembly, and region of interest selection. Does not need a GPU.
+//
+// Usage: compositor [--resolution WxH]* [--sources N]* [--sparsity S]*
+//                   [--repetitions N] [--output file.csv]
+// All options, except repetitions and output, may be given multiple times to
+// benchmark all combinations. Results are written as CSV to the output file,
+// compositor.csv by default.
+
+namespace
+{
+const int32_t _blockSize = 16; // ROI granularity
+
+struct Setup
+{
+    int32_t width;
+    int32_t height;
+    size_t nSources;
+    float sparsity; //!< fraction of empty 16x16 blocks
+};
+
+/** The color and depth pixels of one rendered source image. */
+struct Source
+{
+    std::vector<uint32_t> color;
+    std::vector<uint32_t> depth;
+};
+
+Source _synthesize(const Setup& setup, const uint32_t seed)
+{
+    std::minstd_rand random(seed);
+    std::uniform_real_distribution<float> coin(0.f, 1.f);
+    std::uniform_int_distribution<uint32_t> value(0u, 0xffffffffu);
+
+    const size_t nPixels = size_t(setup.width) * setup.height;
+    Source source;
+    source.color.resize(nPixels, 0u);
+    source.depth.resize(nPixels, 0xffffffffu);
+
+    for (int32_t by = 0; by < setup.height; by += _blockSize)
+    {
+        for (int32_t bx = 0; bx < setup.width; bx += _blockSize)
+        {
+            if (coin(random) < setup.sparsity)
+                continue;
+
+            // smooth shading with a per-block base color and depth
+            const uint32_t color = value(random) | 0x40000000u;
+            const uint32_t depth = value(random) >> 1;
+            const int32_t yEnd = std::min(by + _blockSize, setup.height);
+            const int32_t xEnd = std::min(bx + _blockSize, setup.width);
+            for (int32_t y = by; y < yEnd; ++y)
+            {
+                const size_t row = size_t(y) * setup.width;
+                for (int32_t x = bx; x < xEnd; ++x)
+                {
+                    source.color[row + x] = color + uint32_t((x - bx) >> 2);
+                    source.depth[row + x] = depth + uint32_t(x + y);
+                }
+            }
+        }
+    }
+    return source;
+}
+
+void _setPixels(eq::Image& image, const eq::Frame::Buffer buffer,
+                const eq::PixelViewport& pvp, const uint32_t* data,
+                const size_t stride)
+{
+    const bool isDepth = buffer == eq::Frame::Buffer::depth;
+    std::vector<uint32_t> pixels(size_t(pvp.w) * pvp.h);
+    for (int32_t y = 0; y < pvp.h; ++y)
+        ::memcpy(&pixels[size_t(y) * pvp.w], data + (pvp.y + y) * stride + pvp.x,
+                 pvp.w * sizeof(uint32_t));
+
+    eq::PixelData pixelData;
+    pixelData.internalFormat = isDepth ? EQ_COMPRESSOR_DATATYPE_DEPTH
+                                       : EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixelData.externalFormat = isDepth
+                                   ? EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT
+                                   : EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixelData.pixelSize = 4;
+    pixelData.pvp = pvp;
+    pixelData.pixels = pixels.data();
+    image.setPixelData(buffer, pixelData);
+}
+
+class Benchmark
+{
+public:
+    Benchmark(const size_t repetitions, std::ostream& output)
+        : _repetitions(repetitions)
+        , _output(output)
+    {
+    }
+
+    void run(const Setup& setup)
+    {
+        std::vector<Source> sources;
+        for (size_t i = 0; i < setup.nSources; ++i)
+            sources.push_back(_synthesize(setup, uint32_t(i + 1)));
+
+        const eq::PixelViewport pvp(0, 0, setup.width, setup.height);
+        const uint64_t nPixels = uint64_t(pvp.getArea());
+
+        // sort-last: full images with color and depth
+        std::vector<eq::Image> dbImages(setup.nSources);
+        for (size_t i = 0; i < setup.nSources; ++i)
+        {
+            dbImages[i].setPixelViewport(pvp);
+            _setPixels(dbImages[i], eq::Frame::Buffer::color, pvp,
+                       sources[i].color.data(), setup.width);
+            _setPixels(dbImages[i], eq::Frame::Buffer::depth, pvp,
+                       sources[i].depth.data(), setup.width);
+        }
+
+        // blend: full color images with alpha
+        std::vector<eq::Image> blendImages(setup.nSources);
+        for (size_t i = 0; i < setup.nSources; ++i)
+        {
+            blendImages[i].setPixelViewport(pvp);
+            _setPixels(blendImages[i], eq::Frame::Buffer::color, pvp,
+                       sources[i].color.data(), setup.width);
+        }
+
+        // sort-first: one horizontal stripe of color per source
+        std::vector<eq::Image> stripes(setup.nSources);
+        for (size_t i = 0; i < setup.nSources; ++i)
+        {
+            const int32_t y = int32_t(setup.height * i / setup.nSources);
+            const int32_t yNext =
+                int32_t(setup.height * (i + 1) / setup.nSources);
+            const eq::PixelViewport stripe(0, y, setup.width, yNext - y);
+            stripes[i].setPixelViewport(stripe);
+            _setPixels(stripes[i], eq::Frame::Buffer::color, stripe,
+                       sources[i].color.data(), setup.width);
+        }
+
+        // pixel: every n-th column of color per source
+        const uint32_t nSources = uint32_t(setup.nSources);
+        std::vector<eq::Image> pixelImages(setup.nSources);
+        for (uint32_t i = 0; i < nSources; ++i)
+        {
+            const int32_t width =
+                (setup.width - int32_t(i) + int32_t(nSources) - 1) /
+                int32_t(nSources);
+            const eq::PixelViewport columns(0, 0, width, setup.height);
+            std::vector<uint32_t> data(size_t(width) * setup.height);
+            for (int32_t y = 0; y < setup.height; ++y)
+                for (int32_t x = 0; x < width; ++x)
+                    data[size_t(y) * width + x] =
+                        sources[i].color[size_t(y) * setup.width + x * nSources +
+                                         i];
+
+            eq::RenderContext context;
+            context.pixel = eq::Pixel(i, 0, nSources, 1);
+            pixelImages[i].setContext(context);
+            pixelImages[i].setPixelViewport(columns);
+            _setPixels(pixelImages[i], eq::Frame::Buffer::color, columns,
+                       data.data(), width);
+        }
+
+        // subpixel: one full color image per jitter step
+        std::vector<eq::Image> subPixelImages(setup.nSources);
+        for (uint32_t i = 0; i < nSources; ++i)
+        {
+            eq::RenderContext context;
+            context.subPixel = eq::SubPixel(i, nSources);
+            subPixelImages[i].setContext(context);
+            subPixelImages[i].setPixelViewport(pvp);
+            _setPixels(subPixelImages[i], eq::Frame::Buffer::color, pvp,
+                       sources[i].color.data(), setup.width);
+        }
+
+        _compress(setup, dbImages, eq::Frame::Buffer::color, "color");
+        _compress(setup, dbImages, eq::Frame::Buffer::depth, "depth");
+
+        _report(setup, "merge DB", nPixels * setup.nSources,
+                _merge(dbImages, eq::Frame::Buffer::color |
+                                     eq::Frame::Buffer::depth,
+                       false));
+        _report(setup, "merge 2D", nPixels,
+                _merge(stripes, eq::Frame::Buffer::color, false));
+        _report(setup, "merge blend", nPixels * setup.nSources,
+                _merge(blendImages, eq::Frame::Buffer::color, true));
+        _report(setup, "merge pixel", nPixels,
+                _merge(pixelImages, eq::Frame::Buffer::color, false));
+        const eq::Image* interleaved = eq::Compositor::mergeImagesCPU(
+            _getOps(pixelImages, eq::Frame::Buffer::color), false);
+        TEST(interleaved->getPixelViewport() == pvp);
+        TESTINFO(::memcmp(interleaved->getPixelPointer(eq::Frame::Buffer::color),
+                          _interleave(sources, setup.width).data(), nPixels * 4) == 0,
+                 "pixel merge differs from source");
+        if (setup.nSources > 1)
+            _report(setup, "merge subpixel", nPixels * setup.nSources,
+                    _merge(subPixelImages, eq::Frame::Buffer::color, false));
+
+        eq::ROIFinder finder;
+        size_t nRegions = 0;
+        const float roiTime = _measure([&] {
+            nRegions = 0;
+            for (const eq::Image& image : dbImages)
+                nRegions += finder.findRegions(image).size();
+        });
+        TEST(nRegions > 0 || setup.sparsity >= 1.f);
+        _report(setup, "ROI", nPixels * setup.nSources, roiTime);
+    }
+
+private:
+    const size_t _repetitions;
+    std::ostream& _output;
+
+    /** @return the fastest time of all repetitions in ms. */
+    template <class F>
+    float _measure(const F& func) const
+    {
+        lunchbox::Clock clock;
+        float best = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < _repetitions; ++i)
+        {
+            clock.reset();
+            func();
+            best = std::min(best, clock.getTimef());
+        }
+        return best;
+    }
+
+    void _compress(const Setup& setup, std::vector<eq::Image>& images,
+                   const eq::Frame::Buffer buffer, const std::string& name)
+    {
+        const eq::PixelViewport& pvp = images.front().getPixelViewport();
+        const uint64_t nPixels = uint64_t(pvp.getArea()) * images.size();
+        std::vector<eq::Image> results(images.size());
+        uint64_t compressedSize = 0;
+
+        const float compressTime = _measure([&] {
+            compressedSize = 0;
+            for (eq::Image& image : images)
+            {
+                // force recompression
+                image.setAlphaUsage(false);
+                image.setAlphaUsage(true);
+                const eq::PixelData& data = image.compressPixelData(buffer);
+                compressedSize += data.compressedData.getSize();
+            }
+        });
+
+        const float decompressTime = _measure([&] {
+            for (size_t i = 0; i < images.size(); ++i)
+            {
+                results[i].setPixelViewport(pvp);
+                results[i].setPixelData(buffer,
+                                        images[i].compressPixelData(buffer));
+            }
+        });
+
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            const size_t size = images[i].getPixelDataSize(buffer);
+            TEST(results[i].getPixelDataSize(buffer) == size);
+            TESTINFO(::memcmp(images[i].getPixelPointer(buffer),
+                              results[i].getPixelPointer(buffer), size) == 0,
+                     name << " pixels differ after decompression");
+        }
+
+        std::cout << "  " << name << " compression ratio "
+                  << float(compressedSize) / float(nPixels * 4) << std::endl;
+        _report(setup, "compress " + name, nPixels, compressTime);
+        _report(setup, "decompress " + name, nPixels, decompressTime);
+    }
+
+    static eq::ImageOps _getOps(const std::vector<eq::Image>& images,
+                                const eq::Frame::Buffer buffers)
+    {
+        eq::ImageOps ops;
+        for (const eq::Image& image : images)
+        {
+            eq::ImageOp op;
+            op.image = &image;
+            op.buffers = buffers;
+            ops.push_back(op);
+        }
+        return ops;
+    }
+
+    /** @return the expected result of a pixel merge of the sources. */
+    static std::vector<uint32_t> _interleave(const std::vector<Source>& sources,
+                                             const size_t width)
+    {
+        std::vector<uint32_t> result(sources.front().color.size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = sources[(i % width) % sources.size()].color[i];
+        return result;
+    }
+
+    float _merge(const std::vector<eq::Image>& images,
+                 const eq::Frame::Buffer buffers, const bool blend) const
+    {
+        const eq::ImageOps ops = _getOps(images, buffers);
+        const eq::Image* result = 0;
+        const float time = _measure(
+            [&] { result = eq::Compositor::mergeImagesCPU(ops, blend); });
+        TEST(result);
+        TEST(result->hasPixelData(eq::Frame::Buffer::color));
+        return time;
+    }
+
+    void _report(const Setup& setup, const std::string& stage,
+                 const uint64_t nPixels, const float time)
+    {
+        const float mPixels = time > 0.f ? nPixels / time / 1000.f : 0.f;
+        std::cout << "  " << std::setw(18) << std::left << stage << std::right
+                  << std::setw(10) << time << " ms " << std::setw(10)
+                  << mPixels << " Mpixel/s" << std::endl;
+        _output << stage << "," << setup.width << "," << setup.height << ","
+                << setup.nSources << "," << setup.sparsity << "," << time
+                << "," << mPixels << std::endl;
+    }
+};
+}
+
+int main(int argc, char** argv)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    std::vector<std::pair<int32_t, int32_t>> resolutions;
+    std::vector<size_t> nSources;
+    std::vector<float> sparsities;
+    size_t repetitions = 5;
+    std::string outputName = "compositor.csv";
+
+    for (int i = 1; i < argc - 1; ++i)
+    {
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "--resolution")
+        {
+            const size_t x = value.find('x');
+            TESTINFO(x != std::string::npos, "resolution is WxH: " << value);
+            resolutions.push_back(std::make_pair(atoi(value.c_str()),
+                                                 atoi(value.c_str() + x + 1)));
+        }
+        else if (option == "--sources")
+            nSources.push_back(std::max(1, atoi(value.c_str())));
+        else if (option == "--sparsity")
+            sparsities.push_back(float(atof(value.c_str())));
+        else if (option == "--repetitions")
+            repetitions = std::max(1, atoi(value.c_str()));
+        else if (option == "--output")
+            outputName = value;
+        else
+            continue;
+        ++i;
+    }
+
+    if (resolutions.empty())
+    {
+        resolutions.push_back(std::make_pair(1280, 720));
+        resolutions.push_back(std::make_pair(1920, 1080));
+    }
+    if (nSources.empty())
+    {
+        nSources.push_back(2);
+        nSources.push_back(4);
+    }
+    if (sparsities.empty())
+    {
+        sparsities.push_back(0.f);
+        sparsities.push_back(.5f);
+        sparsities.push_back(.9f);
+    }
+
+    std::ofstream output(outputName.c_str());
+    TESTINFO(output.is_open(), "Can't open " << outputName);
+    output << "stage,width,height,sources,sparsity,time_ms,mpixels_per_s"
+           << std::endl;
+
+    std::cout.precision(4);
+    Benchmark benchmark(repetitions, output);
+    for (const auto& resolution : resolutions)
+    {
+        for (const size_t n : nSources)
+        {
+            for (const float sparsity : sparsities)
+            {
+                const Setup setup = {resolution.first, resolution.second, n,
+                                     sparsity};
+                std::cout << resolution.first << "x" << resolution.second
+                          << ", " << n << " sources, " << sparsity * 100.f
+                          << "% empty:" << std::endl;
+                benchmark.run(setup);
+            }
+        }
+    }
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <eq/server/calibration.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+
+using eq::server::Calibration;
+
+namespace
+{
+Calibration::Result _result(const float draw, const float readback,
+                            const float transmit)
+{
+    Calibration::Result result;
+    result.drawTime = draw;
+    result.readbackTime = readback;
+    result.transmitTime = transmit;
+    result.pixels = 1000000;
+    result.bytes = 4000000;
+    return result;
+}
+
+bool _equal(const float a, const float b)
+{
+    return std::abs(a - b) < .0001f;
+}
+}
+
+int main(int, char**)
+{
+    TEST(Calibration::getCost(Calibration::Result()) == 0.f);
+    TESTINFO(_equal(Calibration::getCost(_result(2.f, 1.f, 3.f)), 6.f),
+             Calibration::getCost(_result(2.f, 1.f, 3.f)));
+
+    // a single channel is not weighted
+    Calibration::Results results;
+    results.push_back(_result(2.f, 1.f, 1.f));
+    TEST(Calibration::computeWeights(results)[0] == 1.f);
+
+    // noise within the tolerance is ignored
+    results.push_back(_result(2.1f, 1.f, 1.f));
+    std::vector<float> weights = Calibration::computeWeights(results);
+    TEST(weights[0] == 1.f && weights[1] == 1.f);
+
+    // a GPU twice as fast gets twice the weight
+    results[1] = _result(1.f, .5f, .5f);
+    weights = Calibration::computeWeights(results);
+    TESTINFO(_equal(weights[1], 2.f * weights[0]), weights[1]);
+    TESTINFO(_equal(weights[0] + weights[1], 2.f), weights[0] + weights[1]);
+
+    // a slow network lowers the weight of a remote channel
+    results[1] = _result(2.f, 1.f, 5.f);
+    weights = Calibration::computeWeights(results);
+    TESTINFO(weights[1] < weights[0], weights[1]);
+
+    // unknown channels keep the default weight
+    results.push_back(Calibration::Result());
+    weights = Calibration::computeWeights(results);
+    TEST(weights[2] == 1.f);
+    TESTINFO(_equal(weights[0] + weights[1], 2.f), weights[0] + weights[1]);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <eq/server/equalizers/equalizerStore.h>
+#include <lunchbox/test.h>
+
+#include <sstream>
+
+using eq::server::EqualizerStore;
+
+int main(int, char**)
+{
+    EqualizerStore store;
+    TEST(store.isEmpty());
+    TEST(!store.get("config"));
+
+    EqualizerStore::State state;
+    state.push_back(.25f);
+    state.push_back(12.f);
+    store.set("config/layout 1/bunny/channel/1", state);
+    store.set("empty", EqualizerStore::State());
+    store.set("multi\nline\\name\r", state);
+    TEST(store.get("empty") && store.get("empty")->empty());
+
+    std::stringstream stream;
+    store.write(stream);
+
+    EqualizerStore copy;
+    TEST(copy.read(stream));
+    const EqualizerStore::State* read =
+        copy.get("config/layout 1/bunny/channel/1");
+    TEST(read);
+    TESTINFO(*read == state, read->size());
+    TEST(copy.get("empty") && copy.get("empty")->empty());
+    TEST(copy.get("multi\nline\\name\r") &&
+         *copy.get("multi\nline\\name\r") == state);
+
+    // malformed input leaves the store unchanged
+    std::istringstream bad("#Equalizer state 1\n1 .5 key\n3 .5 key\n");
+    TEST(!copy.read(bad));
+    TEST(*copy.get("config/layout 1/bunny/channel/1") == state);
+    TEST(!copy.get("key"));
+
+    std::istringstream escape("#Equalizer state 1\n1 .5 bad\\escape\n");
+    TEST(!copy.read(escape));
+
+    std::istringstream foreign("view_equalizer {}\n");
+    TEST(!copy.read(foreign));
+
+    return EXIT_SUCCESS;
+}
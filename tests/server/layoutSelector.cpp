@@ -0,0 +1,95 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Runs the automatic layout selection on simulated per-layout frame times.
+
+#include <eq/server/layoutSelector.h>
+#include <lunchbox/test.h>
+
+#include <vector>
+
+using eq::server::LayoutSelector;
+
+namespace
+{
+// Render frames until the evaluation is done, returns the number of frames.
+size_t _run(LayoutSelector& selector, const std::vector<float>& costs)
+{
+    size_t nFrames = 0;
+    while (selector.isEvaluating() && nFrames < 1000)
+    {
+        const size_t candidate = selector.getCurrent();
+        // deterministic noise of up to 20%
+        const float noise = (nFrames % 3) * .1f * costs[candidate];
+        selector.addSample(candidate, costs[candidate] + noise);
+        ++nFrames;
+    }
+    return nFrames;
+}
+}
+
+int main(int, char**)
+{
+    const std::vector<float> costs = {20.f, 12.f, 30.f, 11.f};
+
+    // initial evaluation picks the fastest layout
+    LayoutSelector selector(costs.size(), 0);
+    selector.setWarmup(2);
+    selector.setNumSamples(5);
+    TEST(!selector.isEvaluating());
+    selector.restart();
+    TEST(selector.isEvaluating());
+    TEST(selector.getCurrent() == 0);
+
+    const size_t nFrames = _run(selector, costs);
+    TESTINFO(nFrames == costs.size() * 7, nFrames);
+    TESTINFO(selector.getSelected() == 3, selector.getSelected());
+    TEST(selector.getCurrent() == 3);
+    TESTINFO(selector.getCost(1) >= 12.f && selector.getCost(1) < 14.f,
+             selector.getCost(1));
+
+    // samples of other layouts, e.g., frames in flight, are ignored
+    selector.restart();
+    TEST(selector.getCurrent() == 3);
+    for (size_t i = 0; i < 100; ++i)
+        TEST(!selector.addSample(0, 1.f));
+    TEST(selector.getCurrent() == 3);
+
+    // a candidate within the hysteresis does not change the selection
+    const std::vector<float> close = {20.f, 10.5f, 30.f, 11.f};
+    _run(selector, close);
+    TESTINFO(selector.getSelected() == 3, selector.getSelected());
+
+    // a change of the load does
+    const std::vector<float> changed = {5.f, 12.f, 30.f, 11.f};
+    selector.restart();
+    _run(selector, changed);
+    TESTINFO(selector.getSelected() == 0, selector.getSelected());
+
+    // explicit selection stops the evaluation
+    selector.restart();
+    selector.select(2);
+    TEST(!selector.isEvaluating());
+    TEST(selector.getCurrent() == 2);
+    TEST(!selector.addSample(2, 1.f));
+
+    // a single candidate is never evaluated
+    LayoutSelector single(1);
+    single.restart();
+    TEST(!single.isEvaluating());
+
+    return EXIT_SUCCESS;
+}
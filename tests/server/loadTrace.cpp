@@ -0,0 +1,93 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <eq/server/config.h>
+#include <eq/server/init.h>
+#include <eq/server/loadTrace.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <lunchbox/test.h>
+
+#include <fstream>
+#include <sstream>
+
+// Replays a small sample trace, records the delivered load again and re-reads
+// the recording. The trace has no splits, so the load is delivered unscaled.
+
+namespace
+{
+const char* const _trace =
+    "# Equalizer load trace 2\n"
+    "load 0 1 0 0 0 0.5 1 4 clear 1 0 1 draw 1 1 10 async_readback 1 10 12 "
+    "wait_readback 1 12 13 channel2\n"
+    "load 0 1 1 0.5 0 0.5 1 3 clear 2 0 1 draw 2 1 20 readback 2 20 22 "
+    "channel1\n";
+
+std::string _getLoads(std::istream& trace)
+{
+    std::string loads;
+    std::string line;
+    while (std::getline(trace, line))
+        if (line.compare(0, 5, "load ") == 0)
+            loads += line + '\n';
+    return loads;
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(eq::server::init(argc, argv));
+
+    eq::server::Loader loader;
+    eq::server::ServerPtr server =
+        loader.loadFile("configs/2-window.2D.lb.eqc");
+    TEST(server.isValid());
+    eq::server::Loader::addOutputCompounds(server);
+    eq::server::Loader::addDestinationViews(server);
+    eq::server::Loader::addDefaultObserver(server);
+    eq::server::Loader::convertTo11(server);
+    eq::server::Loader::convertTo12(server);
+    eq::server::Config& config = *server->getConfigs().front();
+
+    // statistics are identified by name
+    std::istringstream unknown("# Equalizer load trace 2\n"
+                               "load 0 1 0 0 0 1 1 1 6 1 0 1 channel2\n");
+    TEST(!eq::server::LoadReplay(config).read(unknown));
+
+    std::istringstream trace(_trace);
+    eq::server::LoadReplay replay(config);
+    TEST(replay.read(trace));
+    {
+        eq::server::LoadRecorder recorder(config, "loadTrace.txt");
+        TEST(recorder.isGood());
+        replay.run();
+    }
+
+    std::ifstream recorded("loadTrace.txt");
+    TEST(recorded.is_open());
+    eq::server::LoadReplay reread(config);
+    TEST(reread.read(recorded));
+
+    recorded.clear();
+    recorded.seekg(0);
+    std::istringstream expected(_trace);
+    const std::string& loads = _getLoads(recorded);
+    TESTINFO(loads == _getLoads(expected), loads);
+
+    server->deleteConfigs();
+    TEST(eq::server::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Feeds synthetic draw and compositing load traces to the hybrid load
+// equalizer's mode selection.
+
+#include <eq/server/equalizers/modeSelector.h>
+#include <lunchbox/test.h>
+
+using eq::server::ModeSelector;
+using eq::fabric::Equalizer;
+
+namespace
+{
+struct Trace
+{
+    float draw2D;
+    float composite2D;
+    float drawDB;
+    float compositeDB;
+};
+
+// @return the number of mode switches
+size_t _run(ModeSelector& selector, uint32_t& frame, const size_t nFrames,
+            const Trace& trace)
+{
+    size_t nSwitches = 0;
+    for (size_t i = 0; i < nFrames; ++i, ++frame)
+    {
+        const Equalizer::Mode last = selector.getMode();
+        const Equalizer::Mode mode = selector.select(frame);
+        if (mode != last)
+            ++nSwitches;
+
+        if (mode == Equalizer::MODE_DB)
+            selector.addSample(frame, trace.drawDB, trace.compositeDB);
+        else
+            selector.addSample(frame, trace.draw2D, trace.composite2D);
+    }
+    return nSwitches;
+}
+}
+
+int main(int, char**)
+{
+    // dense model filling the screen: 2D draws overlapping geometry
+    const Trace fullScreen = {40.f, 5.f, 20.f, 10.f};
+    // small footprint: DB composites full depth frames
+    const Trace smallFootprint = {12.f, 4.f, 10.f, 60.f};
+    // similar costs: must not oscillate
+    const Trace similar = {40.f, 5.f, 30.f, 10.f};
+
+    uint32_t frame = 1;
+    ModeSelector selector;
+    TEST(selector.getMode() == Equalizer::MODE_2D);
+
+    size_t nSwitches = _run(selector, frame, 100, fullScreen);
+    TESTINFO(nSwitches == 1, nSwitches);
+    TEST(selector.getMode() == Equalizer::MODE_DB);
+
+    nSwitches = _run(selector, frame, 100, smallFootprint);
+    TESTINFO(nSwitches == 1, nSwitches);
+    TEST(selector.getMode() == Equalizer::MODE_2D);
+
+    // samples of frames rendered before the switch are ignored
+    selector.addSample(frame - 100, 1000.f, 1000.f);
+    nSwitches = _run(selector, frame, 100, smallFootprint);
+    TESTINFO(nSwitches == 0, nSwitches);
+
+    ModeSelector hysteresis;
+    frame = 1;
+    nSwitches = _run(hysteresis, frame, 1000, similar);
+    TESTINFO(nSwitches == 1, nSwitches);
+    TEST(hysteresis.getMode() == Equalizer::MODE_DB);
+
+    return EXIT_SUCCESS;
+}
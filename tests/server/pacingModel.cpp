@@ -0,0 +1,231 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Replays frame time traces through the framerate equalizer's pacing model and
+// compares its output jitter with the former averaging model.
+
+#include <eq/server/equalizers/pacingModel.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+using eq::server::PacingModel;
+
+namespace
+{
+/** A frame time of one source from a load trace, normalized by its period. */
+struct Sample
+{
+    uint32_t frame;
+    size_t source;
+    float time;
+};
+typedef std::vector<Sample> Samples;
+
+/**
+ * The former FramerateEqualizer with USE_AVERAGE: the average frame time of
+ * the last complete frames, one per frame of the largest DPlex period, plus 5%.
+ * The time of a frame is the slowest normalized time of its sources.
+ */
+class AverageModel
+{
+public:
+    explicit AverageModel(const size_t nSamples)
+        : _nSamples(nSamples)
+    {
+    }
+
+    void addSample(const uint32_t frame, const float time)
+    {
+        float& frameTime = _times[frame];
+        frameTime = std::max(frameTime, time);
+    }
+
+    float update()
+    {
+        size_t nSamples = 0;
+        float sum = 0.f;
+        for (auto i = _times.rbegin(); i != _times.rend() && nSamples < _nSamples;
+             ++i, ++nSamples)
+        {
+            sum += i->second;
+        }
+        while (_times.size() > _nSamples)
+            _times.erase(_times.begin());
+        return nSamples > 0 ? sum / float(nSamples) * 1.05f : 0.f;
+    }
+
+private:
+    const size_t _nSamples;
+    std::map<uint32_t, float> _times;
+};
+
+/**
+ * Read the load records of a trace written by the server's LoadRecorder.
+ *
+ * The time of a load is the clear to readback time, as in the
+ * FramerateEqualizer. The period of a source is the distance of its first two
+ * frames.
+ */
+bool _readTrace(const std::string& filename, Samples& samples,
+                size_t& nSources, uint32_t& maxPeriod)
+{
+    std::ifstream trace(filename.c_str());
+    std::map<size_t, std::vector<uint32_t>> frames;
+    std::string line;
+    while (std::getline(trace, line))
+    {
+        std::istringstream stream(line);
+        std::string kind;
+        stream >> kind;
+        if (kind != "load")
+            continue;
+
+        uint32_t currentFrame = 0;
+        Sample sample;
+        float region[4];
+        size_t nStats = 0;
+        stream >> currentFrame >> sample.frame >> sample.source >> region[0] >>
+            region[1] >> region[2] >> region[3] >> nStats;
+
+        int64_t start = std::numeric_limits<int64_t>::max();
+        int64_t end = 0;
+        for (size_t i = 0; i < nStats; ++i)
+        {
+            std::string type;
+            uint32_t task = 0;
+            int64_t statStart = 0;
+            int64_t statEnd = 0;
+            stream >> type >> task >> statStart >> statEnd;
+            if (type == "clear" || type == "draw" || type == "assemble" ||
+                type == "readback")
+            {
+                start = std::min(start, statStart);
+                end = std::max(end, statEnd);
+            }
+        }
+        if (!stream)
+            return false;
+        if (end <= start)
+            continue;
+
+        sample.time = float(end - start);
+        samples.push_back(sample);
+        frames[sample.source].push_back(sample.frame);
+    }
+
+    nSources = frames.size();
+    maxPeriod = 1;
+    std::map<size_t, uint32_t> periods;
+    for (const auto& source : frames)
+    {
+        const std::vector<uint32_t>& numbers = source.second;
+        const uint32_t period =
+            numbers.size() > 1 ? numbers[1] - numbers[0] : 1;
+        periods[source.first] = period;
+        maxPeriod = std::max(maxPeriod, period);
+    }
+    for (Sample& sample : samples)
+        sample.time /= float(periods[sample.source]);
+    return !samples.empty();
+}
+
+void _feed(PacingModel& model, const size_t nFrames, const float time)
+{
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        model.addSample(0, time);
+        model.update();
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    PacingModel model;
+    model.setNumSources(1);
+    TEST(model.update() == 0.f);
+
+    _feed(model, 64, 16.f);
+    TESTINFO(model.getInterval() == 16.f, model.getInterval());
+
+    // a single hiccup does not change the interval
+    _feed(model, 1, 40.f);
+    TESTINFO(model.getInterval() == 16.f, model.getInterval());
+    _feed(model, 10, 16.f);
+    TESTINFO(model.getInterval() == 16.f, model.getInterval());
+
+    // a sustained slowdown raises the interval within a few frames
+    _feed(model, 3, 30.f);
+    TESTINFO(model.getInterval() == 30.f, model.getInterval());
+
+    // a speedup lowers it gradually, down to the hysteresis
+    _feed(model, 14, 16.f);
+    const float falling = model.getInterval();
+    TESTINFO(falling > 20.f && falling < 30.f, falling);
+    _feed(model, 200, 16.f);
+    TESTINFO(model.getInterval() < 16.5f, model.getInterval());
+    TESTINFO(model.getInterval() >= 16.f, model.getInterval());
+
+    // replay a trace of two DPlex sources
+    Samples samples;
+    size_t nSources = 0;
+    uint32_t maxPeriod = 0;
+    TEST(_readTrace(argc > 1 ? argv[1] : "pacingModel.trace", samples,
+                    nSources, maxPeriod));
+    TESTINFO(nSources == 2 && maxPeriod == 2, nSources << ", " << maxPeriod);
+
+    PacingModel dplex;
+    dplex.setNumSources(nSources);
+    AverageModel average(maxPeriod);
+    float lastNew = 0.f;
+    float lastOld = 0.f;
+    float jitterNew = 0.f;
+    float jitterOld = 0.f;
+    size_t nLateNew = 0;
+    size_t nLateOld = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const Sample& sample = samples[i];
+        dplex.addSample(sample.source, sample.time);
+        average.addSample(sample.frame, sample.time);
+        const float interval = dplex.update();
+        const float old = average.update();
+
+        if (i >= 64)
+        {
+            jitterNew += std::abs(interval - lastNew);
+            jitterOld += std::abs(old - lastOld);
+            if (sample.time > interval)
+                ++nLateNew;
+            if (sample.time > old)
+                ++nLateOld;
+        }
+        lastNew = interval;
+        lastOld = old;
+    }
+
+    TESTINFO(jitterNew * 5.f < jitterOld, jitterNew << " >= " << jitterOld);
+    TESTINFO(nLateNew * 2 < nLateOld, nLateNew << " >= " << nLateOld);
+    TESTINFO(nLateNew < samples.size() / 10, nLateNew);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <eq/server/equalizers/viewScheduler.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+
+using eq::server::ViewScheduler;
+
+namespace
+{
+bool _equal(const float a, const float b)
+{
+    return std::abs(a - b) < .0001f;
+}
+
+float _sum(const ViewScheduler::Views& views)
+{
+    float sum = 0.f;
+    for (const ViewScheduler::View& view : views)
+        sum += view.share;
+    return sum;
+}
+}
+
+int main(int, char**)
+{
+    // without targets and weights, the resources follow the cost
+    ViewScheduler::Views views;
+    views.push_back(ViewScheduler::View(10.f));
+    views.push_back(ViewScheduler::View(30.f));
+    ViewScheduler::schedule(views, 4.f);
+    TESTINFO(_equal(views[0].share, 1.f), views[0].share);
+    TESTINFO(_equal(views[1].share, 3.f), views[1].share);
+
+    // weights shift the split
+    views[0].weight = 3.f;
+    ViewScheduler::schedule(views, 4.f);
+    TESTINFO(_equal(views[0].share, 2.f), views[0].share);
+    TESTINFO(_equal(views[1].share, 2.f), views[1].share);
+
+    // a reachable target is met, the other view receives the rest
+    views[0].weight = 1.f;
+    views[0].targetFPS = 200.f; // needs 2 resources
+    ViewScheduler::schedule(views, 4.f);
+    TESTINFO(_equal(views[0].share, 2.f), views[0].share);
+    TESTINFO(_equal(views[1].share, 2.f), views[1].share);
+    TESTINFO(_equal(ViewScheduler::getFPS(views[0]), 200.f),
+             ViewScheduler::getFPS(views[0]));
+
+    // unreachable targets share by weight times need
+    views[1].targetFPS = 100.f; // needs 3 resources
+    ViewScheduler::schedule(views, 2.5f);
+    TESTINFO(_equal(views[0].share, 1.f), views[0].share);
+    TESTINFO(_equal(views[1].share, 1.5f), views[1].share);
+
+    views[1].weight = 3.f;
+    ViewScheduler::schedule(views, 4.f);
+    TESTINFO(_equal(views[1].share, 3.f), views[1].share); // saturated
+    TESTINFO(_equal(views[0].share, 1.f), views[0].share);
+
+    // all targets met, the surplus is spread over all views
+    ViewScheduler::schedule(views, 7.f);
+    TESTINFO(views[0].share > 2.f, views[0].share);
+    TESTINFO(views[1].share > 3.f, views[1].share);
+    TESTINFO(_equal(_sum(views), 7.f), _sum(views));
+
+    // shared pipes give fractional resources
+    views.push_back(ViewScheduler::View(5.f));
+    ViewScheduler::schedule(views, 1.5f);
+    TESTINFO(_equal(_sum(views), 1.5f), _sum(views));
+    TESTINFO(views[2].share == 0.f, views[2].share);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Prints the NUMA topology and the automatic thread placement plan of this
+// machine, and verifies that threads can be bound to each NUMA node.
+// Usage: affinityCheck [nPipes]
+
+#include <eq/detail/topology.h>
+#include <eq/fabric/iAttribute.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using eq::detail::Topology;
+
+namespace
+{
+std::ostream& operator<<(std::ostream& os, const Topology::Device& device)
+{
+    os << device.name << ": ";
+    if (device.node < 0)
+        return os << "unknown NUMA node";
+    return os << "NUMA node " << device.node;
+}
+
+/** @return true if a thread bound to the node runs on one of its CPUs */
+bool _verify(const Topology& topology, const size_t node)
+{
+    bool bound = false;
+    int cpu = -1;
+    std::thread thread([&] {
+        bound = topology.bind(node);
+#ifdef __linux__
+        std::this_thread::yield();
+        cpu = sched_getcpu();
+#endif
+    });
+    thread.join();
+
+    const std::vector<uint32_t>& cpus = topology.getCPUs(node);
+    if (!bound)
+    {
+        std::cerr << "  NUMA node " << node << ": binding failed" << std::endl;
+        return false;
+    }
+    if (std::find(cpus.begin(), cpus.end(), uint32_t(cpu)) == cpus.end())
+    {
+        std::cerr << "  NUMA node " << node << ": bound thread ran on CPU "
+                  << cpu << std::endl;
+        return false;
+    }
+    std::cout << "  NUMA node " << node << ": ok, ran on CPU " << cpu
+              << std::endl;
+    return true;
+}
+}
+
+int main(const int argc, char** argv)
+{
+    const Topology& topology = Topology::getInstance();
+
+    std::cout << "NUMA nodes:" << std::endl;
+    for (size_t i = 0; i < topology.getNumNodes(); ++i)
+    {
+        const std::vector<uint32_t>& cpus = topology.getCPUs(i);
+        std::cout << "  " << i << ": " << cpus.size() << " CPUs on socket ";
+        const int32_t affinity = topology.getAffinity(i);
+        if (affinity == lunchbox::Thread::NONE)
+            std::cout << "unknown";
+        else
+            std::cout << affinity - lunchbox::Thread::SOCKET;
+        std::cout << std::endl;
+    }
+
+    std::cout << "GPUs:" << std::endl;
+    for (const Topology::Device& gpu : topology.getGPUs())
+        std::cout << "  " << gpu << std::endl;
+
+    std::cout << "Network interfaces:" << std::endl;
+    for (const Topology::Device& nic : topology.getNICs())
+        std::cout << "  " << nic << std::endl;
+
+    const size_t nPipes =
+        argc > 1 ? size_t(std::max(1, atoi(argv[1])))
+                 : std::max(size_t(1), topology.getGPUs().size());
+    std::cout << "Automatic placement of " << nPipes << " pipes:" << std::endl;
+    for (size_t i = 0; i < nPipes; ++i)
+    {
+        const int32_t node =
+            topology.getPipeNode(eq::fabric::AUTO, uint32_t(i), i);
+        std::cout << "  pipe " << i << ": ";
+        if (node < 0)
+            std::cout << "not bound" << std::endl;
+        else
+            std::cout << "NUMA node " << node << std::endl;
+    }
+
+#ifdef __linux__
+    std::cout << "Verifying NUMA node binding:" << std::endl;
+    bool ok = true;
+    for (size_t i = 0; i < topology.getNumNodes(); ++i)
+        ok = _verify(topology, i) && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+    std::cout << "NUMA node binding not supported on this platform"
+              << std::endl;
+    return EXIT_SUCCESS;
+#endif
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Replays a load trace recorded with EQ_SERVER_LOAD_TRACE through the
+// equalizers of a configuration, without launching any render node.
+
+#include <eq/server/config.h>
+#include <eq/server/init.h>
+#include <eq/server/loadTrace.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+
+#include <lunchbox/file.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+void _printUsage(const char* name)
+{
+    std::cout << lunchbox::getFilename(name)
+              << " config.eqc trace [--splits]" << std::endl
+              << "  Replay a load trace through the equalizers of the given "
+              << "configuration." << std::endl
+              << "  Reports the predicted frame time and load imbalance per "
+              << "frame, and the" << std::endl
+              << "  resulting splits with --splits." << std::endl;
+}
+}
+
+int main(const int argc, char** argv)
+{
+    bool showSplits = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "--help")
+        {
+            _printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--splits")
+            showSplits = true;
+        else if (arg.compare(0, 2, "--") != 0)
+            files.push_back(arg);
+    }
+    if (files.size() != 2)
+    {
+        _printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!eq::server::init(argc, argv))
+        return EXIT_FAILURE;
+
+    eq::server::Loader loader;
+    eq::server::ServerPtr server = loader.loadFile(files[0]);
+    if (!server || server->getConfigs().empty())
+    {
+        LBERROR << "Failed to load configuration " << files[0] << std::endl;
+        eq::server::exit();
+        return EXIT_FAILURE;
+    }
+
+    eq::server::Loader::addOutputCompounds(server);
+    eq::server::Loader::addDestinationViews(server);
+    eq::server::Loader::addDefaultObserver(server);
+    eq::server::Loader::convertTo11(server);
+    eq::server::Loader::convertTo12(server);
+
+    std::ifstream trace(files[1].c_str());
+    eq::server::LoadReplay replay(*server->getConfigs().front());
+    if (!trace || !replay.read(trace))
+    {
+        LBERROR << "Failed to read load trace " << files[1] << std::endl;
+        server->deleteConfigs();
+        eq::server::exit();
+        return EXIT_FAILURE;
+    }
+
+    const eq::server::LoadReplay::Frames& frames = replay.run();
+    float totalTime = 0.f;
+    float maxTime = 0.f;
+    float totalImbalance = 0.f;
+    for (const eq::server::LoadReplay::Frame& frame : frames)
+    {
+        std::cout << "frame " << frame.frameNumber << " time " << frame.time
+                  << " ms imbalance " << frame.imbalance * 100.f << "%"
+                  << std::endl;
+        if (showSplits)
+        {
+            for (const eq::server::LoadReplay::Split& split : frame.splits)
+                std::cout << "  " << split.name << " [" << split.channel
+                          << "] " << split.vp << " " << split.range << " "
+                          << split.time << " ms" << std::endl;
+        }
+        totalTime += frame.time;
+        maxTime = std::max(maxTime, frame.time);
+        totalImbalance += frame.imbalance;
+    }
+
+    if (!frames.empty())
+    {
+        const float nFrames = float(frames.size());
+        std::cout << frames.size() << " frames, average time "
+                  << totalTime / nFrames << " ms, max time " << maxTime
+                  << " ms, average imbalance "
+                  << totalImbalance / nFrames * 100.f << "%" << std::endl;
+    }
+
+    server->deleteConfigs();
+    return eq::server::exit() ? EXIT_SUCCESS : EXIT_FAILURE;
+}